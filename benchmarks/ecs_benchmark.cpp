@@ -0,0 +1,286 @@
+#include "scene/world.h"
+#include "scene/query.h"
+#include "scene/prefab.h"
+#include "scene/command_buffer.h"
+#include "scene/transform.h"
+#include "core/job_system.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace GameEngine2D;
+
+// Cost of the archetype ECS storage on one core: creating entities, adding
+// a component (which moves every row to a new archetype), iterating
+// transforms through a query, and destroying everything again. Iteration
+// is timed on one core and again spread over the job system's workers.
+// A change-filtered query is timed after 1% of the entities were written.
+// Spawning is timed one entity and component at a time against prefab
+// batches of 10k, and deferred changes recorded by a parallel system against
+// their playback. The transform hierarchy is timed with every node moved,
+// with 1% moved and with nothing moved.
+//
+// Usage: ecs_benchmark [--entities N] [--iterations N] [--threads N]
+
+namespace {
+
+struct BenchmarkOptions {
+    int entities = 1000000;
+    int iterations = 100;
+    int threads = 0;    // Job system workers; 0 picks one per hardware thread
+};
+
+struct Position {
+    Vector2 value;
+};
+
+struct Velocity {
+    Vector2 value;
+};
+
+struct Rotation {
+    float angle;
+    float angularVelocity;
+};
+
+struct Health {
+    float current;
+    float maximum;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void printIteration(const std::string& name, std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    std::cout << name << ": mean " << total / samples.size() << " ms, median " << samples[samples.size() / 2]
+              << " ms, min " << samples.front() << " ms" << std::endl;
+}
+
+void printResult(const std::string& name, double totalMs, size_t operations) {
+    std::cout << name << ": " << totalMs << " ms total, "
+              << (operations > 0 ? totalMs * 1.0e6 / operations : 0.0) << " ns per entity" << std::endl;
+}
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--entities" && hasValue) {
+            options.entities = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--iterations" && hasValue) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::max(0, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    
+    Logger::getInstance().setLogLevel(LogLevel::WARNING);
+    size_t count = static_cast<size_t>(options.entities);
+    
+    World world;
+    std::vector<Entity> entities;
+    entities.reserve(count);
+    
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        float x = static_cast<float>(i % 1024);
+        float y = static_cast<float>(i / 1024);
+        entities.push_back(world.createEntity(Position{ Vector2(x, y) }, Velocity{ Vector2(1.0f, 0.5f) },
+                                              Rotation{ 0.0f, 0.1f }));
+    }
+    printResult("create", elapsedMs(start), count);
+    
+    start = Clock::now();
+    for (size_t i = 0; i < count; i += 2) {
+        world.addComponent(entities[i], Health{ 100.0f, 100.0f });
+    }
+    printResult("add component (every other entity)", elapsedMs(start), (count + 1) / 2);
+    
+    // Entities are now split over two archetypes; the query visits both
+    Query<Position, const Velocity, Rotation> movers(world);
+    const float dt = 1.0f / 60.0f;
+    auto move = [dt](Position& position, const Velocity& velocity, Rotation& rotation) {
+        position.value += velocity.value * dt;
+        rotation.angle += rotation.angularVelocity * dt;
+    };
+    
+    std::vector<double> samples;
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+        start = Clock::now();
+        movers.each(move);
+        samples.push_back(elapsedMs(start));
+    }
+    printIteration("iterate " + std::to_string(movers.count()) + " transforms", samples);
+    
+    JobSystem::getInstance().initialize(static_cast<unsigned int>(options.threads));
+    samples.clear();
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+        start = Clock::now();
+        movers.parallelForEach(move);
+        samples.push_back(elapsedMs(start));
+    }
+    printIteration("parallel iterate (" + std::to_string(JobSystem::getInstance().getWorkerCount() + 1) + " threads)",
+                   samples);
+    
+    // Per-chunk callback: plain loops over the raw columns
+    samples.clear();
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+        start = Clock::now();
+        movers.parallelForEachChunk([dt](uint32_t count, const Entity*, Position* positions,
+                                         const Velocity* velocities, Rotation* rotations) {
+            for (uint32_t i = 0; i < count; ++i) {
+                positions[i].value += velocities[i].value * dt;
+                rotations[i].angle += rotations[i].angularVelocity * dt;
+            }
+        });
+        samples.push_back(elapsedMs(start));
+    }
+    printIteration("parallel chunk iterate", samples);
+    
+    // Keeps the iteration results observable so the loop isn't optimized out
+    float checksum = 0.0f;
+    movers.each([&checksum](const Position& position, const Velocity&, const Rotation& rotation) {
+        checksum += position.value.x + rotation.angle;
+    });
+    std::cout << "checksum: " << checksum << std::endl;
+    
+    // Incremental scan: a change-filtered query after a contiguous 1% of the
+    // entities were written, so only their chunks are visited
+    Query<const Position> changed(world);
+    changed.filterChanged<Position>();
+    changed.each([](const Position&) {});
+    samples.clear();
+    size_t visited = 0;
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+        for (size_t i = 0; i < count / 100; ++i) {
+            world.getComponent<Position>(entities[i])->value.y += 1.0f;
+        }
+        visited = 0;
+        start = Clock::now();
+        changed.eachChunk([&visited](uint32_t chunkCount, const Entity*, const Position*) { visited += chunkCount; });
+        samples.push_back(elapsedMs(start));
+    }
+    printIteration("changed-only scan, 1% written (" + std::to_string(visited) + " visited)", samples);
+    
+    start = Clock::now();
+    for (Entity entity : entities) {
+        world.destroyEntity(entity);
+    }
+    printResult("destroy", elapsedMs(start), count);
+    
+    std::cout << "archetypes: " << world.getArchetypeCount() << ", live entities: " << world.getEntityCount()
+              << std::endl;
+    
+    // Bullet-style spawning: components added one by one, then prefab batches
+    const uint32_t batchSize = 10000;
+    World spawnWorld;
+    start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        Entity entity = spawnWorld.createEntity();
+        spawnWorld.addComponent(entity, Position{ Vector2(static_cast<float>(i), 0.0f) });
+        spawnWorld.addComponent(entity, Velocity{ Vector2(0.0f, 400.0f) });
+        spawnWorld.addComponent(entity, Rotation{ 0.0f, 0.0f });
+        spawnWorld.addComponent(entity, Health{ 1.0f, 1.0f });
+    }
+    printResult("spawn one at a time", elapsedMs(start), count);
+    spawnWorld.clear();
+    
+    Prefab bullet;
+    bullet.set(Position{ Vector2(0.0f, 0.0f) }).set(Velocity{ Vector2(0.0f, 400.0f) });
+    bullet.set(Rotation{ 0.0f, 0.0f }).set(Health{ 1.0f, 1.0f });
+    start = Clock::now();
+    for (size_t spawned = 0; spawned < count; spawned += batchSize) {
+        uint32_t batch = static_cast<uint32_t>(std::min<size_t>(batchSize, count - spawned));
+        bullet.instantiate(spawnWorld, batch, [spawned](const SpawnRange& range) {
+            Position* positions = range.get<Position>();
+            for (uint32_t i = 0; i < range.getCount(); ++i) {
+                positions[i].value.x = static_cast<float>(spawned + range.getFirstIndex() + i);
+            }
+        });
+    }
+    printResult("spawn prefab batches of " + std::to_string(batchSize), elapsedMs(start), count);
+    
+    // A parallel system replaces every fourth bullet; keyed by entity index
+    // so playback order doesn't depend on the thread each chunk ran on
+    ThreadCommandBuffers commands;
+    commands.initialize(spawnWorld);
+    Query<const Position, const Health> bullets(spawnWorld);
+    start = Clock::now();
+    bullets.parallelForEachChunk([&commands](uint32_t count, const Entity* entities, const Position* positions,
+                                             const Health*) {
+        CommandBuffer& buffer = commands.local();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (entities[i].index % 4 == 0) {
+                uint64_t key = entities[i].index;
+                buffer.destroyEntity(key, entities[i]);
+                Entity replacement = buffer.createEntity(key);
+                buffer.addComponent(key, replacement, positions[i]);
+                buffer.addComponent(key, replacement, Velocity{ Vector2(0.0f, -400.0f) });
+            }
+        }
+    });
+    double recordMs = elapsedMs(start);
+    size_t commandCount = commands.getCommandCount();
+    start = Clock::now();
+    CommandPlaybackStats playback = commands.playback();
+    double playbackMs = elapsedMs(start);
+    printResult("record " + std::to_string(commandCount) + " commands replacing bullets", recordMs, playback.created);
+    printResult("play back", playbackMs, playback.created);
+    
+    // Three levels: a root per 64 nodes, a child per 8 under it, the rest leaves
+    TransformHierarchy hierarchy;
+    std::vector<TransformID> nodes;
+    nodes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        TransformID parent = i % 64 == 0 ? INVALID_TRANSFORM : nodes[i % 8 == 0 ? i - i % 64 : i - i % 8];
+        nodes.push_back(hierarchy.create(parent));
+        hierarchy.setLocal(nodes.back(), Vector2(1.0f, 0.0f), 0.01f, Vector2(1.0f, 1.0f));
+    }
+    start = Clock::now();
+    hierarchy.updateParallel();
+    printResult("transform hierarchy build", elapsedMs(start), count);
+    
+    auto timeHierarchy = [&](const std::string& name, size_t stride) {
+        samples.clear();
+        for (int iteration = 0; iteration < options.iterations; ++iteration) {
+            for (size_t i = 0; stride > 0 && i < count; i += stride) {
+                hierarchy.setLocal(nodes[i], Vector2(static_cast<float>(iteration), 0.0f), 0.01f, Vector2(1.0f, 1.0f));
+            }
+            start = Clock::now();
+            hierarchy.updateParallel();
+            samples.push_back(elapsedMs(start));
+        }
+        printIteration(name + " (" + std::to_string(hierarchy.getStats().updated) + " updated)", samples);
+    };
+    timeHierarchy("transform update, all moved", 1);
+    timeHierarchy("transform update, 1% moved", 100);
+    timeHierarchy("transform update, static", 0);
+    
+    JobSystem::getInstance().shutdown();
+    return 0;
+}
@@ -0,0 +1,240 @@
+#include "graphics/renderer.h"
+#include "graphics/batch_renderer.h"
+#include "graphics/tilemap.h"
+#include "graphics/sprite_queue.h"
+#include "graphics/shader.h"
+#include "graphics/null_render_backend.h"
+#include "graphics/recording_render_backend.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace GameEngine2D;
+
+// CPU cost of the 2D render path without a GPU or window. Frames are
+// generated from a fixed seed, so runs are deterministic and a recorded
+// stream can be diffed between builds.
+//
+// Usage: render_benchmark [--frames N] [--quads N] [--sorted] [--record file] [--replay file]
+//
+// --sorted routes the quads through a SpriteQueue (half of the textures are
+// opaque) and reports the estimated overdraw with and without the opaque pass.
+
+namespace {
+
+struct BenchmarkOptions {
+    int frames = 300;
+    int quads = 20000;
+    bool sorted = false;
+    std::string recordPath;
+    std::string replayPath;
+};
+
+// Small deterministic generator; std distributions differ between libraries
+class Random {
+public:
+    explicit Random(uint32_t seed) : m_state(seed) {}
+    
+    float next() {
+        m_state = m_state * 1664525u + 1013904223u;
+        return static_cast<float>(m_state >> 8) / 16777216.0f;
+    }
+
+private:
+    uint32_t m_state;
+};
+
+struct FrameTimes {
+    std::vector<double> samples;
+    
+    void print(const std::string& name) const {
+        if (samples.empty()) {
+            return;
+        }
+        
+        std::vector<double> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0.0;
+        for (double sample : sorted) {
+            total += sample;
+        }
+        
+        std::cout << name << ": " << sorted.size() << " frames, mean " << total / sorted.size()
+                  << " ms, median " << sorted[sorted.size() / 2]
+                  << " ms, p95 " << sorted[sorted.size() * 95 / 100]
+                  << " ms, max " << sorted.back() << " ms" << std::endl;
+    }
+};
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--quads" && hasValue) {
+            options.quads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--sorted") {
+            options.sorted = true;
+        } else if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int runScene(const BenchmarkOptions& options) {
+    std::unique_ptr<RenderBackend> backend;
+    if (options.recordPath.empty()) {
+        backend = std::make_unique<NullRenderBackend>();
+    } else {
+        backend = std::make_unique<RecordingRenderBackend>(options.recordPath);
+    }
+    
+    Renderer renderer(std::move(backend));
+    if (!renderer.initialize()) {
+        return 1;
+    }
+    renderer.setOutputSize(1280, 720);
+    
+    // Shaders are opaque to the null backend, so an unloaded one is enough
+    auto shader = std::make_shared<Shader>();
+    
+    BatchRenderer batch;
+    batch.initialize(renderer);
+    
+    TilemapConfig tilemapConfig;
+    tilemapConfig.width = 256;
+    tilemapConfig.height = 256;
+    tilemapConfig.tileSize = 16.0f;
+    tilemapConfig.tilesetColumns = 8;
+    tilemapConfig.tilesetRows = 8;
+    Tilemap tilemap(tilemapConfig);
+    tilemap.setShader(shader);
+    tilemap.setTileset(1, 8, 8);
+    
+    Random random(12345);
+    for (int y = 0; y < tilemapConfig.height; ++y) {
+        for (int x = 0; x < tilemapConfig.width; ++x) {
+            tilemap.setTile(x, y, static_cast<TileID>(1 + static_cast<int>(random.next() * 64.0f) % 64));
+        }
+    }
+    
+    Matrix4 view(1.0f);
+    Matrix4 projection = glm::ortho(0.0f, 1280.0f, 720.0f, 0.0f, -100.0f, 100.0f);
+    const TextureID textures[] = {1, 2, 3, 4};
+    const bool opaqueTextures[] = {true, true, false, false};
+    
+    SpriteQueue queue;
+    queue.setOverdrawEstimation(options.sorted);
+    double overdrawPainter = 0.0;
+    double overdrawSorted = 0.0;
+    
+    FrameTimes times;
+    for (int frame = 0; frame < options.frames; ++frame) {
+        auto start = std::chrono::high_resolution_clock::now();
+        
+        renderer.beginFrame();
+        renderer.clear();
+        renderer.beginPass("scene");
+        
+        // The camera pans so chunks enter and leave the view
+        float scroll = static_cast<float>(frame % 512) * 4.0f;
+        tilemap.render(renderer, Rectangle(scroll, scroll * 0.5f, 1280.0f, 720.0f), view, projection);
+        
+        if (options.sorted) {
+            for (int i = 0; i < options.quads; ++i) {
+                Vector2 position(random.next() * 1280.0f, random.next() * 720.0f);
+                Color color(random.next(), random.next(), random.next(), 1.0f);
+                int textureIndex = (i / 256) % 4;
+                queue.submit(position, Vector2(16.0f, 16.0f), textures[textureIndex], opaqueTextures[textureIndex],
+                             Vector4(0.0f, 0.0f, 1.0f, 1.0f), color, static_cast<float>(i % 16));
+            }
+            queue.flush(renderer, batch, shader, view, projection);
+            overdrawPainter += queue.getStats().overdrawPainter;
+            overdrawSorted += queue.getStats().overdrawSorted;
+        } else {
+            batch.begin(renderer, shader, view, projection);
+            for (int i = 0; i < options.quads; ++i) {
+                Vector2 position(random.next() * 1280.0f, random.next() * 720.0f);
+                Color color(random.next(), random.next(), random.next(), 1.0f);
+                TextureID texture = textures[(i / 256) % 4];
+                batch.drawQuad(position, Vector2(16.0f, 16.0f), texture, Vector4(0.0f, 0.0f, 1.0f, 1.0f), color,
+                               static_cast<float>(i % 16));
+            }
+            batch.end();
+        }
+        
+        renderer.endPass();
+        renderer.present();
+        renderer.endFrame();
+        
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        times.samples.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+    }
+    
+    const RenderStats& stats = renderer.getFrameStats();
+    times.print(options.recordPath.empty() ? "render path (null backend)" : "render path (recording backend)");
+    std::cout << "last frame: " << stats.drawCalls << " draw calls, " << stats.vertices << " vertices, "
+              << stats.bufferUploadBytes << " bytes uploaded" << std::endl;
+    if (options.sorted) {
+        double painter = overdrawPainter / options.frames;
+        double sorted = overdrawSorted / options.frames;
+        std::cout << "sprite overdraw: " << painter << "x painter order, " << sorted << "x opaque pass ("
+                  << (painter > 0.0 ? 100.0 * (1.0 - sorted / painter) : 0.0) << "% fewer fragments)" << std::endl;
+    }
+    
+    batch.shutdown();
+    tilemap.releaseGPUResources();
+    renderer.shutdown();
+    return 0;
+}
+
+int runReplay(const BenchmarkOptions& options) {
+    RenderCommandReplayer replayer;
+    if (!replayer.load(options.replayPath)) {
+        return 1;
+    }
+    
+    NullRenderBackend backend;
+    backend.initialize();
+    
+    FrameTimes times;
+    for (size_t frame = 0; frame < replayer.getFrameCount(); ++frame) {
+        auto start = std::chrono::high_resolution_clock::now();
+        replayer.replayFrame(backend, frame);
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        times.samples.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+    }
+    
+    times.print("replay (null backend)");
+    replayer.releaseResources(backend);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    
+    Logger::getInstance().setLogLevel(LogLevel::WARNING);
+    
+    if (!options.replayPath.empty()) {
+        return runReplay(options);
+    }
+    return runScene(options);
+}
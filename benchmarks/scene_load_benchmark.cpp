@@ -0,0 +1,189 @@
+#include "scene/scene_serializer.h"
+#include "scene/query.h"
+#include "utils/file_utils.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace GameEngine2D;
+
+// Load time of a binary scene against building the same scene an object at
+// a time and against parsing its text form. Loads map the file and either
+// adopt its chunks in place or copy them into the world; every load is
+// checked against the source world.
+//
+// Usage: scene_load_benchmark [--entities N] [--iterations N] [--file path]
+
+namespace {
+
+struct BenchmarkOptions {
+    int entities = 500000;
+    int iterations = 10;
+    std::string file = "scene_benchmark.scene";
+};
+
+struct Position {
+    Vector2 value;
+};
+
+struct Velocity {
+    Vector2 value;
+};
+
+struct Rotation {
+    float angle;
+    float angularVelocity;
+};
+
+struct Health {
+    float current;
+    float maximum;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void printIteration(const std::string& name, std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    std::cout << name << ": mean " << total / samples.size() << " ms, median " << samples[samples.size() / 2]
+              << " ms, min " << samples.front() << " ms" << std::endl;
+}
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--entities" && hasValue) {
+            options.entities = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--iterations" && hasValue) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--file" && hasValue) {
+            options.file = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Sums every component value, so loads can be compared with the source
+double checksum(World& world) {
+    double sum = 0.0;
+    Query<const Position, const Velocity, const Rotation> movers(world);
+    movers.each([&sum](const Position& position, const Velocity& velocity, const Rotation& rotation) {
+        sum += position.value.x + position.value.y + velocity.value.x + rotation.angle;
+    });
+    Query<const Health> damageable(world);
+    damageable.each([&sum](const Health& health) {
+        sum += health.current;
+    });
+    return sum;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    
+    Logger::getInstance().setLogLevel(LogLevel::WARNING);
+    ComponentRegistry& registry = ComponentRegistry::getInstance();
+    registry.registerComponent<Position>("Position");
+    registry.registerComponent<Velocity>("Velocity");
+    registry.registerComponent<Rotation>("Rotation");
+    registry.registerComponent<Health>("Health");
+    
+    // Baseline: the scene built one object at a time, as a text loader would
+    size_t count = static_cast<size_t>(options.entities);
+    World source;
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        float x = static_cast<float>(i % 1024);
+        float y = static_cast<float>(i / 1024);
+        Entity entity = source.createEntity(Position{ Vector2(x, y) }, Velocity{ Vector2(1.0f, 0.5f) },
+                                            Rotation{ 0.001f * i, 0.1f });
+        if (i % 4 == 0) {
+            source.addComponent(entity, Health{ 100.0f, 100.0f });
+        }
+    }
+    std::cout << "build per object: " << elapsedMs(start) << " ms" << std::endl;
+    double expected = checksum(source);
+    
+    start = Clock::now();
+    SceneWriter writer;
+    writer.addWorld(source);
+    if (!writer.write(options.file)) {
+        return 1;
+    }
+    std::cout << "write binary: " << elapsedMs(start) << " ms, " << FileUtils::getFileSize(options.file) / 1024
+              << " KB" << std::endl;
+    
+    std::ostringstream text;
+    text << "component Position float float\ncomponent Velocity float float\n"
+         << "component Rotation float float\ncomponent Health float float\n";
+    Query<const Position, const Velocity, const Rotation> movers(source);
+    movers.eachWithEntity([&](Entity entity, const Position& position, const Velocity& velocity,
+                              const Rotation& rotation) {
+        text << "entity Position " << position.value.x << ' ' << position.value.y << " Velocity "
+             << velocity.value.x << ' ' << velocity.value.y << " Rotation " << rotation.angle << ' '
+             << rotation.angularVelocity;
+        if (const Health* health = source.readComponent<Health>(entity)) {
+            text << " Health " << health->current << ' ' << health->maximum;
+        }
+        text << '\n';
+    });
+    std::string textScene = text.str();
+    start = Clock::now();
+    SceneWriter textWriter;
+    std::string error;
+    if (!textWriter.addText(textScene, error)) {
+        std::cerr << "Text scene: " << error << std::endl;
+        return 1;
+    }
+    std::cout << "parse text (" << textScene.size() / 1024 << " KB): " << elapsedMs(start) << " ms" << std::endl;
+    
+    const std::pair<SceneLoadMode, const char*> modes[] = {
+        { SceneLoadMode::ADOPT, "load adopt" },
+        { SceneLoadMode::COPY, "load copy" }
+    };
+    for (const auto& mode : modes) {
+        std::vector<double> samples;
+        SceneLoadStats stats;
+        bool matches = true;
+        for (int iteration = 0; iteration < options.iterations; ++iteration) {
+            World world;
+            SceneLoader loader(world);
+            start = Clock::now();
+            if (!loader.load(options.file, mode.first)) {
+                return 1;
+            }
+            samples.push_back(elapsedMs(start));
+            stats = loader.getStats();
+            matches = matches && world.getEntityCount() == count && checksum(world) == expected;
+        }
+        printIteration(std::string(mode.second) + " (" + std::to_string(stats.chunksAdopted) + " chunks adopted, " +
+                       std::to_string(stats.chunksCopied) + " copied)", samples);
+        if (!matches) {
+            std::cerr << mode.second << ": loaded scene differs from the source" << std::endl;
+            return 1;
+        }
+    }
+    
+    FileUtils::deleteFile(options.file);
+    return 0;
+}
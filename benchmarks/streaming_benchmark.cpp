@@ -0,0 +1,194 @@
+#include "scene/world_streamer.h"
+#include "utils/file_utils.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace GameEngine2D;
+
+// Streams a partitioned world while a focus point sweeps across all of it,
+// row by row. Reports the main-thread time spent merging and unloading each
+// frame and, on Linux, the resident set size, which should level off once
+// the first rows are loaded and stay flat until the sweep ends.
+//
+// Usage: streaming_benchmark [--grid N] [--entities-per-cell N] [--budget ms] [--threads N] [--dir path]
+
+namespace {
+
+struct BenchmarkOptions {
+    int grid = 32;                  // Cells per side
+    int entitiesPerCell = 2000;
+    double budgetMs = 2.0;
+    int threads = 0;
+    std::string directory = "streaming_benchmark_cells";
+};
+
+struct Position {
+    Vector2 value;
+};
+
+struct Velocity {
+    Vector2 value;
+};
+
+struct Health {
+    float current;
+    float maximum;
+};
+
+const float CELL_SIZE = 256.0f;
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--grid" && hasValue) {
+            options.grid = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--entities-per-cell" && hasValue) {
+            options.entitiesPerCell = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--budget" && hasValue) {
+            options.budgetMs = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--dir" && hasValue) {
+            options.directory = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Resident set size in KB, 0 where unsupported
+size_t getResidentKB() {
+#ifdef __linux__
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0;
+    }
+    long pages = 0;
+    long resident = 0;
+    if (std::fscanf(file, "%ld %ld", &pages, &resident) != 2) {
+        resident = 0;
+    }
+    std::fclose(file);
+    return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    
+    Logger::getInstance().setLogLevel(LogLevel::WARNING);
+    ComponentRegistry& registry = ComponentRegistry::getInstance();
+    registry.registerComponent<Position>("Position");
+    registry.registerComponent<Velocity>("Velocity");
+    registry.registerComponent<Health>("Health");
+    
+    // Author the map a row of cells at a time so the authoring world doesn't
+    // dominate the memory figures, cutting each row into cells
+    float mapSize = options.grid * CELL_SIZE;
+    size_t total = static_cast<size_t>(options.grid) * options.grid * options.entitiesPerCell;
+    size_t cells = 0;
+    uint32_t seed = 12345;
+    for (int row = 0; row < options.grid; ++row) {
+        World source;
+        for (size_t i = 0; i < total / options.grid; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            float x = (seed >> 8) / 16777216.0f * (mapSize - 1.0f);
+            seed = seed * 1664525u + 1013904223u;
+            float y = row * CELL_SIZE + (seed >> 8) / 16777216.0f * (CELL_SIZE - 1.0f);
+            Entity entity = source.createEntity(Position{ Vector2(x, y) }, Velocity{ Vector2(1.0f, 0.0f) });
+            if (i % 3 == 0) {
+                source.addComponent(entity, Health{ 100.0f, 100.0f });
+            }
+        }
+        cells += WorldStreamer::writeCells(source, options.directory, CELL_SIZE, [&source](Entity entity) {
+            return source.readComponent<Position>(entity)->value;
+        });
+    }
+    std::cout << "wrote " << total << " entities into " << cells << " cells" << std::endl;
+    
+    JobSystem::getInstance().initialize(static_cast<unsigned int>(options.threads));
+    World world;
+    WorldStreamer streamer;
+    StreamingSettings settings;
+    settings.directory = options.directory;
+    settings.cellSize = CELL_SIZE;
+    settings.loadRadius = 2.0f * CELL_SIZE;
+    settings.unloadRadius = 3.0f * CELL_SIZE;
+    settings.mergeBudgetMs = options.budgetMs;
+    streamer.initialize(world, settings);
+    
+    // Serpentine sweep, rows spaced so every cell comes within the load radius
+    std::vector<Vector2> path;
+    const float step = CELL_SIZE / 16.0f;
+    bool forward = true;
+    for (float y = 0.0f; y <= mapSize; y += settings.loadRadius) {
+        for (float x = 0.0f; x <= mapSize; x += step) {
+            path.emplace_back(forward ? x : mapSize - x, y);
+        }
+        forward = !forward;
+    }
+    
+    std::vector<double> slices;
+    size_t peakEntities = 0;
+    size_t merged = 0;
+    size_t minResidentKB = SIZE_MAX;
+    size_t maxResidentKB = 0;
+    size_t reportEvery = std::max<size_t>(path.size() / 10, 1);
+    for (size_t frame = 0; frame < path.size(); ++frame) {
+        streamer.update(path[frame]);
+        const StreamingStats& stats = streamer.getStats();
+        slices.push_back(stats.sliceMs);
+        merged += stats.entitiesMerged;
+        peakEntities = std::max(peakEntities, world.getEntityCount());
+        
+        // Memory is judged after the warm-up tenth of the sweep
+        if (frame >= reportEvery) {
+            size_t residentKB = getResidentKB();
+            minResidentKB = std::min(minResidentKB, residentKB);
+            maxResidentKB = std::max(maxResidentKB, residentKB);
+        }
+        if (frame % reportEvery == 0) {
+            std::cout << "frame " << frame << ": focus (" << path[frame].x << ", " << path[frame].y << "), "
+                      << stats.residentCells << " cells, " << world.getEntityCount() << " entities, "
+                      << getResidentKB() << " KB resident" << std::endl;
+        }
+    }
+    
+    std::sort(slices.begin(), slices.end());
+    double totalMs = 0.0;
+    for (double slice : slices) {
+        totalMs += slice;
+    }
+    std::cout << "frames: " << slices.size() << ", entities merged: " << merged << ", peak live: " << peakEntities
+              << std::endl;
+    std::cout << "slice: mean " << totalMs / slices.size() << " ms, p99 " << slices[slices.size() * 99 / 100]
+              << " ms, max " << slices.back() << " ms (budget " << options.budgetMs << " ms)" << std::endl;
+    if (maxResidentKB > 0) {
+        std::cout << "resident after warm-up: " << minResidentKB << " - " << maxResidentKB << " KB" << std::endl;
+    }
+    
+    streamer.shutdown();
+    JobSystem::getInstance().shutdown();
+    FileUtils::deleteDirectory(options.directory);
+    return 0;
+}
@@ -59,6 +59,7 @@ public:
     float getFPS() const { return m_fps; }
     float getFrameTime() const { return m_frameTime; }
     float getDeltaTime() const { return m_deltaTime; }
+    const RenderStats& getRenderStats() const { return m_renderer->getFrameStats(); }
     
     // Static access
     static Application* getInstance() { return s_instance; }
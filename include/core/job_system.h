@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GameEngine2D {
+
+// Counts outstanding jobs; a job submitted with a counter decrements it when
+// it finishes
+class JobCounter {
+public:
+    bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+    uint32_t getPending() const { return m_pending.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> m_pending{ 0 };
+};
+
+// Worker threads fed from one shared queue. Threads that wait on a counter
+// run queued jobs in the meantime, so waiting from inside a job can't
+// deadlock. Before initialize (or with zero workers) jobs run inline on the
+// submitting thread.
+class JobSystem {
+public:
+    static JobSystem& getInstance();
+    
+    // workerCount 0 picks one worker per hardware thread, minus the caller's
+    bool initialize(unsigned int workerCount = 0);
+    void shutdown();
+    bool isInitialized() const { return !m_workers.empty(); }
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(m_workers.size()); }
+    
+    // Index of the calling thread for per-thread data: workers are 1 to
+    // getWorkerCount(), every other thread is 0
+    static unsigned int getThreadIndex();
+    
+    void submit(std::function<void()> job, JobCounter* counter = nullptr);
+    void wait(JobCounter& counter);
+    
+    // Runs func(begin, end) over [0, count) in ranges of at most grainSize,
+    // on the workers and the calling thread; returns when all ranges are done
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func);
+
+private:
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter = nullptr;
+    };
+    
+    std::vector<std::thread> m_workers;
+    std::deque<Job> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping;
+    
+    void workerLoop(unsigned int threadIndex);
+    bool tryRunJob();
+    static void runJob(Job& job);
+};
+
+} // namespace GameEngine2D
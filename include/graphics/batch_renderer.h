@@ -0,0 +1,90 @@
+#pragma once
+
+#include "types.h"
+#include "graphics/vertex_layout.h"
+#include <vector>
+#include <memory>
+
+namespace GameEngine2D {
+
+class Renderer;
+class RenderBackend;
+class Shader;
+
+// Unpacked quad corner accepted by drawQuad; batches are stored and
+// uploaded as PackedVertex and drawn with the "packed" shader variants
+struct BatchVertex {
+    Vector3 position;
+    Vector2 texCoord;
+    Color color;
+};
+
+struct BatchStats {
+    uint32_t quads = 0;
+    uint32_t flushes = 0;
+    uint32_t textureSwitches = 0;
+    uint32_t shaderSwitches = 0;
+};
+
+// Sprite batch: accumulates textured quads and issues one draw call per
+// run of quads sharing a texture and shader
+class BatchRenderer {
+public:
+    BatchRenderer(size_t maxQuads = 10000);
+    ~BatchRenderer();
+    
+    // GPU resources are created on, and later drawn through, the renderer's backend
+    bool initialize(Renderer& renderer);
+    void shutdown();
+    
+    // Batch lifecycle
+    void begin(Renderer& renderer, std::shared_ptr<Shader> shader,
+               const Matrix4& view, const Matrix4& projection);
+    void end();
+    void flush();
+    
+    // Shader switching; flushes pending quads if the shader changes. For a
+    // shader family variant, untextured batches use its USE_TEXTURE-less sibling
+    void setShader(std::shared_ptr<Shader> shader);
+    std::shared_ptr<Shader> getShader() const { return m_shader; }
+    
+    // Quad submission
+    void drawQuad(const Vector2& position, const Vector2& size, const Color& color, float depth = 0.0f);
+    void drawQuad(const Vector2& position, const Vector2& size, TextureID texture,
+                  const Vector4& uvRect, const Color& color, float depth = 0.0f);
+    void drawQuad(const BatchVertex* vertices, TextureID texture);
+    void drawQuad(const PackedVertex* vertices, TextureID texture);
+    
+    // Pre-built quads sharing one texture, four vertices each; copied in bulk
+    void drawQuads(const PackedVertex* vertices, size_t quadCount, TextureID texture);
+    
+    // Statistics
+    bool isDrawing() const { return m_renderer != nullptr; }
+    const BatchStats& getStats() const { return m_stats; }
+    size_t getMaxQuads() const { return m_maxQuads; }
+
+private:
+    size_t m_maxQuads;
+    RenderBackend* m_backend;
+    unsigned int m_vao;
+    unsigned int m_vbo;
+    unsigned int m_ibo;
+    
+    std::vector<PackedVertex> m_vertices;
+    TextureID m_currentTexture;
+    std::shared_ptr<Shader> m_shader;
+    std::shared_ptr<Shader> m_texturedShader;
+    std::shared_ptr<Shader> m_colorShader;
+    Shader* m_appliedShader;  // Program whose per-batch uniforms are current
+    
+    Renderer* m_renderer;
+    Matrix4 m_view;
+    Matrix4 m_projection;
+    BatchStats m_stats;
+    
+    bool prepareQuad(TextureID texture);
+    void resolveVariants();
+    void applyShader(Shader& shader);
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "types.h"
+#include "graphics/render_target.h"
+#include <vector>
+#include <memory>
+
+namespace GameEngine2D {
+
+class Renderer;
+class BatchRenderer;
+class Shader;
+
+using LayerSpriteID = uint32_t;
+constexpr LayerSpriteID INVALID_LAYER_SPRITE = 0;
+
+struct LayerSprite {
+    Vector2 position = Vector2(0.0f, 0.0f);
+    Vector2 size = Vector2(1.0f, 1.0f);
+    TextureID texture = 0;
+    Vector4 uvRect = Vector4(0.0f, 0.0f, 1.0f, 1.0f);
+    Color color = Color(1.0f, 1.0f, 1.0f, 1.0f);
+};
+
+struct CachedLayerConfig {
+    float resolutionScale = 1.0f;               // Cache texels per world unit at zoom 1
+    size_t memoryBudgetBytes = 32 * 1024 * 1024; // Larger caches fall back to direct drawing
+    int maxTextureSize = 4096;
+    FilterMode filter = FilterMode::LINEAR;
+    float zoomTolerance = 0.01f;                 // Relative zoom change that forces a re-render
+    float fullRedrawThreshold = 0.5f;            // Dirty fraction of the layer above which all of it is redrawn
+};
+
+struct CachedLayerStats {
+    uint32_t fullRedraws = 0;
+    uint32_t partialRedraws = 0;
+    uint32_t cachedFrames = 0;
+    uint32_t directFrames = 0;
+    size_t memoryBytes = 0;
+};
+
+// Layer of rarely changing sprites (backgrounds, parallax planes) that is
+// rendered once into an offscreen texture and composited with a single quad.
+// Edits only mark the area they touch dirty, and just that area is cleared
+// and redrawn under a scissor. A zoom change re-renders the cache at the new
+// resolution. When the cache would exceed the memory budget or the maximum
+// texture size, or the backend cannot render offscreen, the sprites are
+// drawn directly instead.
+class CachedLayer {
+public:
+    CachedLayer(const CachedLayerConfig& config = CachedLayerConfig());
+    ~CachedLayer();
+    
+    CachedLayer(const CachedLayer&) = delete;
+    CachedLayer& operator=(const CachedLayer&) = delete;
+    
+    // Content; sprites are drawn in the order they were added
+    LayerSpriteID addSprite(const LayerSprite& sprite);
+    bool updateSprite(LayerSpriteID id, const LayerSprite& sprite);
+    bool removeSprite(LayerSpriteID id);
+    const LayerSprite* getSprite(LayerSpriteID id) const;
+    void clear();
+    
+    // Dirty tracking for changes the layer cannot see, such as edited textures
+    void markDirty();
+    void markDirty(const Rectangle& region);
+    bool isDirty() const { return m_fullRedraw || m_hasDirtyRegion; }
+    
+    // Rendering; the batch must not be between begin and end, and the frame's
+    // own target must be bound. Sprites use the "packed" shader.
+    void setShader(std::shared_ptr<Shader> shader) { m_shader = shader; }
+    void setDepth(float depth) { m_depth = depth; }
+    void render(Renderer& renderer, BatchRenderer& batch, const Rectangle& viewBounds,
+                const Matrix4& view, const Matrix4& projection, float zoom = 1.0f);
+    
+    // GPU resources
+    void releaseGPUResources();
+    
+    // Properties
+    void setConfig(const CachedLayerConfig& config);
+    const CachedLayerConfig& getConfig() const { return m_config; }
+    bool isCached() const { return m_target != nullptr; }
+    size_t getSpriteCount() const { return m_spriteCount; }
+    Rectangle getBounds();
+    const CachedLayerStats& getStats() const { return m_stats; }
+
+private:
+    struct Slot {
+        LayerSprite sprite;
+        bool alive = false;
+    };
+    
+    CachedLayerConfig m_config;
+    std::vector<Slot> m_slots;
+    size_t m_spriteCount;
+    std::shared_ptr<Shader> m_shader;
+    float m_depth;
+    
+    // Union of all sprite rectangles, recomputed lazily after edits
+    Rectangle m_bounds;
+    bool m_boundsDirty;
+    
+    // Offscreen cache covering m_cacheRect in world units
+    std::unique_ptr<RenderTarget> m_target;
+    Rectangle m_cacheRect;
+    float m_pixelsPerUnit;
+    bool m_cacheFailed;
+    
+    bool m_fullRedraw;
+    bool m_hasDirtyRegion;
+    Rectangle m_dirtyRegion;
+    
+    CachedLayerStats m_stats;
+    
+    void updateBounds();
+    bool prepareCache(Renderer& renderer, float zoom);
+    void redrawCache(Renderer& renderer, BatchRenderer& batch);
+    void drawSprites(BatchRenderer& batch, const Rectangle& area);
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "types.h"
+#include <vector>
+#include <functional>
+
+namespace GameEngine2D {
+
+class DynamicResolution;
+
+struct DynamicResolutionConfig {
+    float targetFrameTimeMs = 1000.0f / 60.0f;
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    float scaleStep = 0.05f;
+    
+    // Frame-time window and the percentile compared against the target
+    int sampleWindow = 60;
+    int minSamples = 15;
+    float percentile = 0.9f;
+    
+    // Hysteresis band: drop below downscaleThreshold * target, and only
+    // raise again once frames fit in upscaleThreshold * target
+    float downscaleThreshold = 1.0f;
+    float upscaleThreshold = 0.8f;
+    int downscaleCooldownFrames = 10;
+    int upscaleCooldownFrames = 60;
+};
+
+// Replaces the built-in policy; returns the new scale for the current samples
+using ResolutionScaleController = std::function<float(const DynamicResolution&, float currentScale)>;
+
+// Chooses a render scale from recent frame times so that the percentile
+// frame time stays within the target frame budget
+class DynamicResolution {
+public:
+    DynamicResolution(const DynamicResolutionConfig& config = DynamicResolutionConfig{});
+    
+    // Sampling
+    void addFrameTime(float frameTimeMs);
+    float update();
+    void reset();
+    
+    // Override
+    void setScaleOverride(float scale);
+    void clearScaleOverride() { m_hasOverride = false; }
+    bool hasScaleOverride() const { return m_hasOverride; }
+    void setController(ResolutionScaleController controller) { m_controller = controller; }
+    
+    // Configuration
+    void setConfig(const DynamicResolutionConfig& config);
+    const DynamicResolutionConfig& getConfig() const { return m_config; }
+    void setTargetFrameTime(float frameTimeMs) { m_config.targetFrameTimeMs = frameTimeMs; }
+    
+    // State
+    float getScale() const { return m_hasOverride ? m_overrideScale : m_scale; }
+    float getPercentileFrameTime(float percentile) const;
+    size_t getSampleCount() const { return m_sampleCount; }
+
+private:
+    DynamicResolutionConfig m_config;
+    std::vector<float> m_samples;
+    size_t m_sampleCount;
+    size_t m_nextSample;
+    mutable std::vector<float> m_sortScratch;
+    
+    float m_scale;
+    int m_framesSinceChange;
+    bool m_hasOverride;
+    float m_overrideScale;
+    ResolutionScaleController m_controller;
+    
+    float computeScale() const;
+    float quantize(float scale) const;
+};
+
+} // namespace GameEngine2D
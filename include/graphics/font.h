@@ -0,0 +1,69 @@
+#pragma once
+
+#include "types.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace GameEngine2D {
+
+using FontID = uint32_t;
+
+// Glyph metrics in pixels; bearingY is measured up from the baseline
+struct GlyphInfo {
+    int width = 0;
+    int height = 0;
+    int bearingX = 0;
+    int bearingY = 0;
+    float advance = 0.0f;
+};
+
+// 8-bit coverage bitmap, row-major, top row first
+struct GlyphBitmap {
+    GlyphInfo info;
+    std::vector<uint8_t> coverage;
+};
+
+// Outline rasterizer backing a font (e.g. FreeType or stb_truetype)
+class GlyphSource {
+public:
+    virtual ~GlyphSource() = default;
+    
+    virtual bool getGlyphInfo(uint32_t codepoint, int pixelSize, GlyphInfo& info) = 0;
+    virtual bool rasterizeGlyph(uint32_t codepoint, int pixelSize, GlyphBitmap& bitmap) = 0;
+    virtual float getAscent(int pixelSize) const = 0;
+    virtual float getLineHeight(int pixelSize) const = 0;
+    virtual float getKerning(uint32_t, uint32_t, int) const { return 0.0f; }
+};
+
+// Font rendered through a signed distance field: glyphs are rasterized once
+// at baseSize with `spread` pixels of distance padding and scaled at draw time
+class Font {
+public:
+    Font(std::shared_ptr<GlyphSource> source, int baseSize = 32, int spread = 4);
+    ~Font();
+    
+    // Metrics at base size; cached per codepoint
+    const GlyphInfo& getGlyphInfo(uint32_t codepoint);
+    float getKerning(uint32_t left, uint32_t right) const;
+    float getAscent() const;
+    float getLineHeight() const;
+    
+    bool rasterizeGlyph(uint32_t codepoint, GlyphBitmap& bitmap);
+    
+    // Properties
+    FontID getID() const { return m_id; }
+    int getBaseSize() const { return m_baseSize; }
+    int getSpread() const { return m_spread; }
+
+private:
+    FontID m_id;
+    std::shared_ptr<GlyphSource> m_source;
+    int m_baseSize;
+    int m_spread;
+    std::unordered_map<uint32_t, GlyphInfo> m_glyphInfo;
+    
+    static FontID s_nextID;
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "types.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+
+namespace GameEngine2D {
+
+enum class CaptureFormat {
+    PNG_SEQUENCE = 0,   // One PNG per frame in the output directory
+    RAW_VIDEO = 1       // Top-down RGBA8 frames appended to one file
+};
+
+struct FrameCaptureConfig {
+    CaptureFormat format = CaptureFormat::PNG_SEQUENCE;
+    std::string outputPath = "captures";    // Directory for PNGs, file path for raw video
+    int bufferCount = 3;                    // Readback ring size; frames are mapped up to this many frames later
+    int frameInterval = 1;                  // Capture every Nth presented frame
+    size_t maxQueuedFrames = 8;             // Frames waiting for the encoder before new ones are dropped
+};
+
+struct FrameCaptureStats {
+    uint64_t captured = 0;
+    uint64_t encoded = 0;
+    uint64_t dropped = 0;           // Ring still busy on the GPU or encoder queue full
+    size_t queuedFrames = 0;
+    float renderThreadMs = 0.0f;    // Cost of the last onPresent call on the render thread
+};
+
+// Asynchronous backbuffer capture. Each captured frame is read into one of
+// a ring of pixel buffer objects guarded by a fence; the buffer is mapped
+// only once its fence has signaled, a few frames later, so the render thread
+// never waits for the GPU. Mapped pixels are copied out and encoded on a
+// background thread. When the GPU or the encoder falls behind, frames are
+// dropped rather than stalling the frame.
+class FrameCapture {
+public:
+    FrameCapture();
+    ~FrameCapture();
+    
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+    
+    // Continuous recording
+    bool start(const FrameCaptureConfig& config);
+    void stop();
+    bool isRecording() const { return m_recording; }
+    
+    // One-shot PNG of the next presented frame; works while not recording
+    void requestScreenshot(const std::string& path);
+    
+    // Called by the renderer after the frame is complete in the default
+    // framebuffer and before buffers are swapped
+    void onPresent(uint64_t frameIndex, int width, int height);
+    bool isActive() const { return m_recording || !m_screenshotPaths.empty() || !m_pending.empty(); }
+    
+    // Waits for outstanding readbacks and encodes, then frees GPU buffers;
+    // needs the GL context that issued the readbacks
+    void shutdown();
+    
+    const FrameCaptureStats& getStats() const { return m_stats; }
+    
+    // Uncompressed (stored deflate) RGBA8 PNG; rows are given bottom-up as GL returns them
+    static void encodePNG(const uint8_t* pixels, int width, int height, std::vector<uint8_t>& output);
+
+private:
+    struct ReadbackSlot {
+        unsigned int buffer = 0;
+        size_t capacity = 0;
+        void* fence = nullptr;
+        bool pending = false;
+        uint64_t frameIndex = 0;
+        int width = 0;
+        int height = 0;
+        std::string screenshotPath;
+        bool recorded = false;
+    };
+    
+    struct EncodeJob {
+        std::vector<uint8_t> pixels;
+        int width = 0;
+        int height = 0;
+        uint64_t frameIndex = 0;
+        CaptureFormat format = CaptureFormat::PNG_SEQUENCE;
+        std::string path;
+    };
+    
+    FrameCaptureConfig m_config;
+    bool m_recording;
+    uint64_t m_presentedFrames;
+    std::vector<std::string> m_screenshotPaths;
+    
+    // Readback ring; m_pending lists slots in the order they were issued
+    std::vector<ReadbackSlot> m_slots;
+    std::deque<int> m_pending;
+    int m_nextSlot;
+    int m_videoWidth;
+    int m_videoHeight;
+    
+    // Encoder thread
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<EncodeJob> m_jobs;
+    std::vector<std::vector<uint8_t>> m_freeBuffers;
+    bool m_workerRunning;
+    bool m_encoding;
+    uint64_t m_encodedFrames;
+    std::ofstream m_videoFile;
+    
+    FrameCaptureStats m_stats;
+    
+    void ensureSlots(int count);
+    void releaseSlots();
+    void issueReadback(ReadbackSlot& slot, uint64_t frameIndex, int width, int height);
+    void collectReadbacks(bool wait);
+    void completeReadback(ReadbackSlot& slot);
+    void startWorker();
+    void stopWorker();
+    void waitForEncoder();
+    void workerLoop();
+    void encode(EncodeJob& job);
+};
+
+} // namespace GameEngine2D
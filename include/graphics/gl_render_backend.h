@@ -0,0 +1,67 @@
+#pragma once
+
+#include "graphics/render_backend.h"
+
+namespace GameEngine2D {
+
+// OpenGL 3.3 core backend; requires a current context and GLEW
+class GLRenderBackend : public RenderBackend {
+public:
+    GLRenderBackend();
+    ~GLRenderBackend() override = default;
+    
+    RenderBackendType getType() const override { return RenderBackendType::OPENGL; }
+    bool initialize() override;
+    void shutdown() override {}
+    
+    void beginFrame(uint64_t) override {}
+    void endFrame() override {}
+    
+    void clear(bool color, bool depth) override;
+    void setClearColor(const Color& color) override;
+    void setViewport(int x, int y, int width, int height) override;
+    void setBlending(bool enable) override;
+    void setBlendMode(BlendMode mode) override;
+    void setDepthTest(bool enable) override;
+    void setDepthWrite(bool enable) override;
+    void setDepthFunc(DepthFunc func) override;
+    void setScissor(bool enable, int x, int y, int width, int height) override;
+    void bindFramebuffer(unsigned int framebuffer) override;
+    
+    unsigned int createBuffer() override;
+    void destroyBuffer(unsigned int buffer) override;
+    void uploadBuffer(unsigned int buffer, const void* data, size_t bytes, bool dynamic) override;
+    void streamBuffer(unsigned int buffer, size_t capacity, const void* data, size_t bytes) override;
+    void updateBuffer(unsigned int buffer, size_t offset, const void* data, size_t bytes) override;
+    void bindUniformBuffer(unsigned int binding, unsigned int buffer) override;
+    unsigned int createVertexArray(const VertexLayout& layout, unsigned int vertexBuffer,
+                                   unsigned int indexBuffer) override;
+    void destroyVertexArray(unsigned int vertexArray) override;
+    
+    bool bindShader(Shader* shader) override;
+    void setUniform(Shader& shader, const std::string& name, int value) override;
+    void setUniform(Shader& shader, const std::string& name, bool value) override;
+    void setUniform(Shader& shader, const std::string& name, const Vector2& value) override;
+    void setUniform(Shader& shader, const std::string& name, const Matrix4& value) override;
+    void setUniform(Shader& shader, UniformHandle handle, int value) override;
+    void setUniform(Shader& shader, UniformHandle handle, bool value) override;
+    void setUniform(Shader& shader, UniformHandle handle, const Vector2& value) override;
+    void setUniform(Shader& shader, UniformHandle handle, const Matrix4& value) override;
+    void bindTexture(unsigned int unit, TextureID texture) override;
+    
+    void drawIndexed(unsigned int vertexArray, uint32_t indexCount, uint32_t firstIndex) override;
+    void drawArrays(unsigned int vertexArray, uint32_t vertexCount) override;
+    
+    bool supportsTimerQueries() const override { return m_timerQueriesSupported; }
+    unsigned int createQuery() override;
+    void destroyQuery(unsigned int query) override;
+    void beginTimerQuery(unsigned int query) override;
+    void endTimerQuery() override;
+    bool isQueryResultAvailable(unsigned int query) override;
+    uint64_t getQueryResult(unsigned int query) override;
+
+private:
+    bool m_timerQueriesSupported;
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "types.h"
+#include <vector>
+#include <list>
+#include <unordered_map>
+
+namespace GameEngine2D {
+
+class Font;
+
+// Location of a glyph in the atlas; the generation detects slot reuse
+struct AtlasGlyph {
+    Vector4 uvRect = Vector4(0.0f);
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+};
+
+struct GlyphAtlasStats {
+    uint32_t residentGlyphs = 0;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;
+    uint32_t failures = 0;
+};
+
+// Single-channel texture of fixed-size cells holding signed distance fields.
+// Glyphs are generated on first use and the least recently used cell is
+// recycled when the atlas is full; glyphs touched this frame are never evicted.
+class GlyphAtlas {
+public:
+    GlyphAtlas(int textureSize = 1024, int cellSize = 48);
+    ~GlyphAtlas();
+    
+    bool initialize();
+    void shutdown();
+    void beginFrame();
+    
+    // Glyph access
+    bool acquire(Font& font, uint32_t codepoint, AtlasGlyph& glyph);
+    bool touch(const AtlasGlyph& glyph);
+    
+    // Properties
+    TextureID getTexture() const { return m_texture; }
+    int getCellSize() const { return m_cellSize; }
+    size_t getCapacity() const { return m_slots.size(); }
+    const GlyphAtlasStats& getStats() const { return m_stats; }
+    
+    // SDF generation from a coverage bitmap; output is padded by spread on each side
+    static void generateSDF(const uint8_t* coverage, int width, int height, int spread,
+                            std::vector<uint8_t>& output);
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        uint64_t lastUsedFrame = 0;
+        uint32_t generation = 0;
+        bool occupied = false;
+        Vector4 uvRect = Vector4(0.0f);
+        std::list<uint32_t>::iterator lruPosition;
+    };
+    
+    int m_textureSize;
+    int m_cellSize;
+    int m_cellsPerRow;
+    TextureID m_texture;
+    uint64_t m_frame;
+    
+    std::vector<Slot> m_slots;
+    std::list<uint32_t> m_lru; // Most recently used at the front
+    std::unordered_map<uint64_t, uint32_t> m_lookup;
+    std::vector<uint8_t> m_cellBuffer;
+    GlyphAtlasStats m_stats;
+    
+    static uint64_t makeKey(uint32_t font, uint32_t codepoint) {
+        return (static_cast<uint64_t>(font) << 32) | codepoint;
+    }
+    
+    void markUsed(uint32_t slot);
+    bool allocateSlot(uint32_t& slot);
+    bool uploadGlyph(Font& font, uint32_t codepoint, uint32_t slot);
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "graphics/render_backend.h"
+
+namespace GameEngine2D {
+
+// Discards every command. Hands out unique non-zero handles so the front
+// end behaves as it would on a GPU, which makes it suitable for measuring
+// the CPU cost of the render path and for running without a context.
+class NullRenderBackend : public RenderBackend {
+public:
+    NullRenderBackend() : m_nextHandle(1) {}
+    ~NullRenderBackend() override = default;
+    
+    RenderBackendType getType() const override { return RenderBackendType::NULL_BACKEND; }
+    bool initialize() override { return true; }
+    void shutdown() override {}
+    
+    void beginFrame(uint64_t) override {}
+    void endFrame() override {}
+    
+    void clear(bool, bool) override {}
+    void setClearColor(const Color&) override {}
+    void setViewport(int, int, int, int) override {}
+    void setBlending(bool) override {}
+    void setBlendMode(BlendMode) override {}
+    void setDepthTest(bool) override {}
+    void setDepthWrite(bool) override {}
+    void setDepthFunc(DepthFunc) override {}
+    void setScissor(bool, int, int, int, int) override {}
+    void bindFramebuffer(unsigned int) override {}
+    
+    unsigned int createBuffer() override { return m_nextHandle++; }
+    void destroyBuffer(unsigned int) override {}
+    void uploadBuffer(unsigned int, const void*, size_t, bool) override {}
+    void streamBuffer(unsigned int, size_t, const void*, size_t) override {}
+    void updateBuffer(unsigned int, size_t, const void*, size_t) override {}
+    void bindUniformBuffer(unsigned int, unsigned int) override {}
+    unsigned int createVertexArray(const VertexLayout&, unsigned int, unsigned int) override { return m_nextHandle++; }
+    void destroyVertexArray(unsigned int) override {}
+    
+    bool bindShader(Shader* shader) override { return shader != nullptr; }
+    void setUniform(Shader&, const std::string&, int) override {}
+    void setUniform(Shader&, const std::string&, bool) override {}
+    void setUniform(Shader&, const std::string&, const Vector2&) override {}
+    void setUniform(Shader&, const std::string&, const Matrix4&) override {}
+    void setUniform(Shader&, UniformHandle, int) override {}
+    void setUniform(Shader&, UniformHandle, bool) override {}
+    void setUniform(Shader&, UniformHandle, const Vector2&) override {}
+    void setUniform(Shader&, UniformHandle, const Matrix4&) override {}
+    void bindTexture(unsigned int, TextureID) override {}
+    
+    void drawIndexed(unsigned int, uint32_t, uint32_t) override {}
+    void drawArrays(unsigned int, uint32_t) override {}
+    
+    bool supportsTimerQueries() const override { return false; }
+    unsigned int createQuery() override { return m_nextHandle++; }
+    void destroyQuery(unsigned int) override {}
+    void beginTimerQuery(unsigned int) override {}
+    void endTimerQuery() override {}
+    bool isQueryResultAvailable(unsigned int) override { return true; }
+    uint64_t getQueryResult(unsigned int) override { return 0; }
+
+private:
+    unsigned int m_nextHandle;
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+namespace GameEngine2D {
+
+struct ProgramBinaryCacheStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t rejected = 0;  // Present on disk but refused by the driver or corrupt
+    uint32_t stored = 0;
+};
+
+// On-disk cache of linked GL program binaries. Entries are keyed by a hash
+// of the final shader sources (defines included, since they are part of the
+// source by the time it is compiled) and the driver's vendor, renderer and
+// version strings, so a driver update simply misses. Anything that fails to
+// load is deleted and the caller compiles from source as if it had missed.
+// Needs a current GL context; not thread safe.
+class ProgramBinaryCache {
+public:
+    static ProgramBinaryCache& getInstance();
+    
+    // Cache location; an empty path disables the cache
+    void setDirectory(const std::string& directory);
+    const std::string& getDirectory() const { return m_directory; }
+    
+    // False when disabled or when the driver exposes no binary formats
+    bool isEnabled();
+    
+    uint64_t computeKey(const std::string& vertexSource, const std::string& fragmentSource);
+    
+    // Returns a linked program, or 0 on a miss or a rejected binary
+    unsigned int load(uint64_t key);
+    
+    // Saves a program linked with the binary retrievable hint
+    bool store(uint64_t key, unsigned int program);
+    
+    void clear();
+    
+    const ProgramBinaryCacheStats& getStats() const { return m_stats; }
+
+private:
+    ProgramBinaryCache();
+    ~ProgramBinaryCache() = default;
+    ProgramBinaryCache(const ProgramBinaryCache&) = delete;
+    ProgramBinaryCache& operator=(const ProgramBinaryCache&) = delete;
+    
+    std::string m_directory;
+    bool m_driverQueried;
+    bool m_supported;
+    uint64_t m_driverHash;
+    ProgramBinaryCacheStats m_stats;
+    
+    void queryDriver();
+    std::string getEntryPath(uint64_t key) const;
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "graphics/render_backend.h"
+#include "graphics/vertex_layout.h"
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+namespace GameEngine2D {
+
+// Writes every command to a line-based text stream, then forwards it to a
+// target backend (a NullRenderBackend when none is given). Streams from
+// identical frames are identical, so recordings can be diffed directly.
+// Buffer contents are stored as a hash unless captureBufferData is set.
+class RecordingRenderBackend : public RenderBackend {
+public:
+    RecordingRenderBackend(const std::string& path, std::unique_ptr<RenderBackend> target = nullptr,
+                           bool captureBufferData = false);
+    ~RecordingRenderBackend() override;
+    
+    RenderBackendType getType() const override { return RenderBackendType::RECORDING; }
+    bool initialize() override;
+    void shutdown() override;
+    
+    void beginFrame(uint64_t frameIndex) override;
+    void endFrame() override;
+    
+    void clear(bool color, bool depth) override;
+    void setClearColor(const Color& color) override;
+    void setViewport(int x, int y, int width, int height) override;
+    void setBlending(bool enable) override;
+    void setBlendMode(BlendMode mode) override;
+    void setDepthTest(bool enable) override;
+    void setDepthWrite(bool enable) override;
+    void setDepthFunc(DepthFunc func) override;
+    void setScissor(bool enable, int x, int y, int width, int height) override;
+    void bindFramebuffer(unsigned int framebuffer) override;
+    
+    unsigned int createBuffer() override;
+    void destroyBuffer(unsigned int buffer) override;
+    void uploadBuffer(unsigned int buffer, const void* data, size_t bytes, bool dynamic) override;
+    void streamBuffer(unsigned int buffer, size_t capacity, const void* data, size_t bytes) override;
+    void updateBuffer(unsigned int buffer, size_t offset, const void* data, size_t bytes) override;
+    void bindUniformBuffer(unsigned int binding, unsigned int buffer) override;
+    unsigned int createVertexArray(const VertexLayout& layout, unsigned int vertexBuffer,
+                                   unsigned int indexBuffer) override;
+    void destroyVertexArray(unsigned int vertexArray) override;
+    
+    bool bindShader(Shader* shader) override;
+    void setUniform(Shader& shader, const std::string& name, int value) override;
+    void setUniform(Shader& shader, const std::string& name, bool value) override;
+    void setUniform(Shader& shader, const std::string& name, const Vector2& value) override;
+    void setUniform(Shader& shader, const std::string& name, const Matrix4& value) override;
+    void setUniform(Shader& shader, UniformHandle handle, int value) override;
+    void setUniform(Shader& shader, UniformHandle handle, bool value) override;
+    void setUniform(Shader& shader, UniformHandle handle, const Vector2& value) override;
+    void setUniform(Shader& shader, UniformHandle handle, const Matrix4& value) override;
+    void bindTexture(unsigned int unit, TextureID texture) override;
+    
+    void drawIndexed(unsigned int vertexArray, uint32_t indexCount, uint32_t firstIndex) override;
+    void drawArrays(unsigned int vertexArray, uint32_t vertexCount) override;
+    
+    // Timer queries are forwarded but not recorded; their results vary per run
+    bool supportsTimerQueries() const override { return m_target->supportsTimerQueries(); }
+    unsigned int createQuery() override { return m_target->createQuery(); }
+    void destroyQuery(unsigned int query) override { m_target->destroyQuery(query); }
+    void beginTimerQuery(unsigned int query) override { m_target->beginTimerQuery(query); }
+    void endTimerQuery() override { m_target->endTimerQuery(); }
+    bool isQueryResultAvailable(unsigned int query) override { return m_target->isQueryResultAvailable(query); }
+    uint64_t getQueryResult(unsigned int query) override { return m_target->getQueryResult(query); }
+    
+    uint64_t getCommandCount() const { return m_commandCount; }
+    RenderBackend& getTarget() { return *m_target; }
+
+private:
+    std::string m_path;
+    std::ofstream m_file;
+    std::unique_ptr<RenderBackend> m_target;
+    bool m_captureBufferData;
+    uint64_t m_commandCount;
+    
+    // Shaders are numbered in order of first use so streams stay stable
+    std::unordered_map<const Shader*, uint32_t> m_shaderIDs;
+    
+    std::ostream& command(const char* name);
+    void writeData(const void* data, size_t bytes);
+    uint32_t getShaderID(const Shader* shader);
+};
+
+// Loads a recorded command stream and issues it against another backend.
+// Resource handles are remapped to the ones the target backend creates.
+// Shader programs are not part of the stream; a resolver maps recorded
+// shader numbers to live shaders, and shader commands are skipped without one.
+class RenderCommandReplayer {
+public:
+    using ShaderResolver = std::function<Shader*(uint32_t shaderID)>;
+    
+    RenderCommandReplayer();
+    
+    bool load(const std::string& path);
+    void setShaderResolver(ShaderResolver resolver) { m_shaderResolver = resolver; }
+    
+    // Replay
+    void replay(RenderBackend& backend);
+    bool replayFrame(RenderBackend& backend, size_t frame);
+    void releaseResources(RenderBackend& backend);
+    
+    size_t getFrameCount() const { return m_frameStarts.size(); }
+    size_t getCommandCount() const { return m_commands.size(); }
+
+private:
+    enum class Op {
+        BEGIN_FRAME, END_FRAME, CLEAR, CLEAR_COLOR, VIEWPORT, BLEND, BLEND_MODE, DEPTH_TEST, DEPTH_WRITE, DEPTH_FUNC,
+        SCISSOR, FRAMEBUFFER, BUFFER_CREATE, BUFFER_DESTROY, BUFFER_UPLOAD, BUFFER_STREAM, BUFFER_UPDATE,
+        UNIFORM_BUFFER, VAO_CREATE, VAO_DESTROY, SHADER, UNIFORM_INT, UNIFORM_BOOL, UNIFORM_VEC2, UNIFORM_MAT4,
+        TEXTURE, DRAW_INDEXED, DRAW_ARRAYS
+    };
+    
+    struct Command {
+        Op op = Op::BEGIN_FRAME;
+        uint64_t args[5] = {};
+        float values[16] = {};
+        std::string name;
+        std::vector<uint8_t> data;
+        std::shared_ptr<VertexLayout> layout;
+    };
+    
+    std::vector<Command> m_commands;
+    std::vector<size_t> m_frameStarts;
+    ShaderResolver m_shaderResolver;
+    Shader* m_currentShader;
+    
+    std::unordered_map<uint64_t, unsigned int> m_buffers;
+    std::unordered_map<uint64_t, unsigned int> m_vertexArrays;
+    std::vector<uint8_t> m_zeroData;
+    
+    bool parseLine(const std::string& line, Command& command) const;
+    void execute(RenderBackend& backend, const Command& command);
+    unsigned int mapBuffer(uint64_t recorded) const;
+    unsigned int mapVertexArray(uint64_t recorded) const;
+};
+
+} // namespace GameEngine2D
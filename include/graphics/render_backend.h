@@ -0,0 +1,91 @@
+#pragma once
+
+#include "types.h"
+#include "graphics/uniform_handle.h"
+#include <string>
+#include <cstdint>
+
+namespace GameEngine2D {
+
+class Shader;
+class VertexLayout;
+
+enum class RenderBackendType {
+    OPENGL = 0,
+    NULL_BACKEND = 1,
+    RECORDING = 2
+};
+
+enum class DepthFunc {
+    LESS = 0,
+    LESS_EQUAL = 1
+};
+
+// Command interface between the Renderer front end (and the systems that
+// submit geometry through it) and the graphics API. Handles returned by a
+// backend are only meaningful to that backend; 0 is never a valid handle.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+    
+    virtual RenderBackendType getType() const = 0;
+    virtual bool initialize() = 0;
+    virtual void shutdown() = 0;
+    
+    // Frame boundaries
+    virtual void beginFrame(uint64_t frameIndex) = 0;
+    virtual void endFrame() = 0;
+    
+    // Pipeline state
+    virtual void clear(bool color, bool depth) = 0;
+    virtual void setClearColor(const Color& color) = 0;
+    virtual void setViewport(int x, int y, int width, int height) = 0;
+    virtual void setBlending(bool enable) = 0;
+    virtual void setBlendMode(BlendMode mode) = 0;
+    virtual void setDepthTest(bool enable) = 0;
+    virtual void setDepthWrite(bool enable) = 0;
+    virtual void setDepthFunc(DepthFunc func) = 0;
+    virtual void setScissor(bool enable, int x, int y, int width, int height) = 0;
+    virtual void bindFramebuffer(unsigned int framebuffer) = 0;
+    
+    // Buffers and vertex arrays. uploadBuffer replaces the whole contents;
+    // streamBuffer orphans a buffer of the given capacity and writes the
+    // data at its start; updateBuffer overwrites a range in place.
+    virtual unsigned int createBuffer() = 0;
+    virtual void destroyBuffer(unsigned int buffer) = 0;
+    virtual void uploadBuffer(unsigned int buffer, const void* data, size_t bytes, bool dynamic) = 0;
+    virtual void streamBuffer(unsigned int buffer, size_t capacity, const void* data, size_t bytes) = 0;
+    virtual void updateBuffer(unsigned int buffer, size_t offset, const void* data, size_t bytes) = 0;
+    virtual void bindUniformBuffer(unsigned int binding, unsigned int buffer) = 0;
+    virtual unsigned int createVertexArray(const VertexLayout& layout, unsigned int vertexBuffer,
+                                           unsigned int indexBuffer) = 0;
+    virtual void destroyVertexArray(unsigned int vertexArray) = 0;
+    
+    // Shaders and textures; bindShader returns false when nothing can be drawn,
+    // which includes a null shader on every backend
+    virtual bool bindShader(Shader* shader) = 0;
+    virtual void setUniform(Shader& shader, const std::string& name, int value) = 0;
+    virtual void setUniform(Shader& shader, const std::string& name, bool value) = 0;
+    virtual void setUniform(Shader& shader, const std::string& name, const Vector2& value) = 0;
+    virtual void setUniform(Shader& shader, const std::string& name, const Matrix4& value) = 0;
+    virtual void setUniform(Shader& shader, UniformHandle handle, int value) = 0;
+    virtual void setUniform(Shader& shader, UniformHandle handle, bool value) = 0;
+    virtual void setUniform(Shader& shader, UniformHandle handle, const Vector2& value) = 0;
+    virtual void setUniform(Shader& shader, UniformHandle handle, const Matrix4& value) = 0;
+    virtual void bindTexture(unsigned int unit, TextureID texture) = 0;
+    
+    // Draws; indexed draws use 16-bit indices and triangle lists
+    virtual void drawIndexed(unsigned int vertexArray, uint32_t indexCount, uint32_t firstIndex) = 0;
+    virtual void drawArrays(unsigned int vertexArray, uint32_t vertexCount) = 0;
+    
+    // GPU timer queries
+    virtual bool supportsTimerQueries() const = 0;
+    virtual unsigned int createQuery() = 0;
+    virtual void destroyQuery(unsigned int query) = 0;
+    virtual void beginTimerQuery(unsigned int query) = 0;
+    virtual void endTimerQuery() = 0;
+    virtual bool isQueryResultAvailable(unsigned int query) = 0;
+    virtual uint64_t getQueryResult(unsigned int query) = 0;
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "types.h"
+
+namespace GameEngine2D {
+
+struct RenderTargetConfig {
+    int width = 0;
+    int height = 0;
+    TextureFormat format = TextureFormat::RGBA8;
+    FilterMode filter = FilterMode::LINEAR;
+    bool depth = true;
+    
+    // Values above 1 render into multisampled buffers that resolve() copies
+    // into the sampleable color texture
+    int samples = 1;
+    
+    bool operator==(const RenderTargetConfig& other) const {
+        return width == other.width && height == other.height && format == other.format &&
+               filter == other.filter && depth == other.depth && samples == other.samples;
+    }
+    bool operator!=(const RenderTargetConfig& other) const { return !(*this == other); }
+};
+
+// Framebuffer with a sampleable color texture and optional depth-stencil buffer.
+// Multisampled targets draw into renderbuffers and resolve into the texture.
+class RenderTarget {
+public:
+    RenderTarget();
+    ~RenderTarget();
+    
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+    
+    // Lifecycle
+    bool create(const RenderTargetConfig& config);
+    bool resize(int width, int height);
+    void destroy();
+    
+    // Usage
+    void bind() const;
+    void resolve() const;
+    static void bindDefault();
+    
+    // Properties
+    bool isValid() const { return m_framebuffer != 0; }
+    bool isMultisampled() const { return m_msaaFramebuffer != 0; }
+    unsigned int getFramebuffer() const { return m_msaaFramebuffer != 0 ? m_msaaFramebuffer : m_framebuffer; }
+    unsigned int getResolveFramebuffer() const { return m_framebuffer; }
+    TextureID getColorTexture() const { return m_colorTexture; }
+    int getWidth() const { return m_config.width; }
+    int getHeight() const { return m_config.height; }
+    const RenderTargetConfig& getConfig() const { return m_config; }
+    size_t getMemoryUsage() const;
+    
+    static size_t getBytesPerPixel(TextureFormat format);
+
+private:
+    RenderTargetConfig m_config;
+    unsigned int m_framebuffer;
+    unsigned int m_colorTexture;
+    unsigned int m_depthBuffer;
+    unsigned int m_msaaFramebuffer;
+    unsigned int m_msaaColorBuffer;
+    
+    bool checkFramebuffer() const;
+};
+
+} // namespace GameEngine2D
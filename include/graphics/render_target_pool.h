@@ -0,0 +1,93 @@
+#pragma once
+
+#include "types.h"
+#include "graphics/render_target.h"
+#include <vector>
+#include <memory>
+
+namespace GameEngine2D {
+
+struct RenderTargetPoolStats {
+    uint32_t targets = 0;
+    uint32_t inUse = 0;
+    uint32_t allocations = 0;
+    uint32_t reuses = 0;
+    uint32_t frees = 0;
+    size_t memoryBytes = 0;
+};
+
+// Transient render targets keyed by size, format and sample count.
+// Targets acquired during a frame are returned to the pool at endFrame()
+// (or earlier through release()); targets left unused for a number of
+// frames are destroyed.
+class RenderTargetPool {
+public:
+    RenderTargetPool(int maxUnusedFrames = 60);
+    ~RenderTargetPool();
+    
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+    
+    // Frame lifecycle
+    void beginFrame();
+    void endFrame();
+    
+    // Targets stay valid until released or until the end of the frame
+    RenderTarget* acquire(const RenderTargetConfig& config);
+    RenderTarget* acquire(int width, int height, TextureFormat format = TextureFormat::RGBA8, int samples = 1);
+    void release(RenderTarget* target);
+    
+    // Destroys every target that is not currently in use
+    void trim();
+    void clear();
+    
+    void setMaxUnusedFrames(int frames) { m_maxUnusedFrames = frames; }
+    int getMaxUnusedFrames() const { return m_maxUnusedFrames; }
+    
+    // Statistics
+    size_t getMemoryUsage() const;
+    const RenderTargetPoolStats& getStats() const { return m_stats; }
+
+private:
+    struct Entry {
+        RenderTarget target;
+        RenderTargetConfig key;
+        uint64_t lastUsedFrame = 0;
+        bool inUse = false;
+    };
+    
+    std::vector<std::unique_ptr<Entry>> m_entries;
+    uint64_t m_frame;
+    int m_maxUnusedFrames;
+    RenderTargetPoolStats m_stats;
+    
+    void updateStats();
+};
+
+// Two pooled targets of the same configuration that alternate as source
+// and destination, for multi-pass filters such as separable blurs
+class PingPongTarget {
+public:
+    PingPongTarget(RenderTargetPool& pool, const RenderTargetConfig& config);
+    ~PingPongTarget();
+    
+    PingPongTarget(const PingPongTarget&) = delete;
+    PingPongTarget& operator=(const PingPongTarget&) = delete;
+    
+    bool isValid() const { return m_targets[0] && m_targets[1]; }
+    
+    // Source holds the result of the last pass; destination receives the next
+    RenderTarget* getSource() const { return m_targets[m_current]; }
+    RenderTarget* getDestination() const { return m_targets[1 - m_current]; }
+    void swap() { m_current = 1 - m_current; }
+    
+    // Returns both targets to the pool early; the destructor does the same
+    void release();
+
+private:
+    RenderTargetPool& m_pool;
+    RenderTarget* m_targets[2];
+    int m_current;
+};
+
+} // namespace GameEngine2D
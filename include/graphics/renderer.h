@@ -1,24 +1,199 @@
 #pragma once
 
 #include "types.h"
+#include "graphics/dynamic_resolution.h"
+#include "graphics/render_target_pool.h"
+#include "graphics/render_backend.h"
+#include "graphics/frame_capture.h"
+#include "graphics/uniform_buffer.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
 
 namespace GameEngine2D {
 
+class Shader;
+class RenderTarget;
+
+// GPU time spent in a single named render pass
+struct RenderPassTiming {
+    std::string name;
+    float gpuTimeMs = 0.0f;
+};
+
+// Per-frame renderer counters
+struct RenderStats {
+    uint64_t frameIndex = 0;
+    
+    // CPU-side counters
+    uint32_t drawCalls = 0;
+    uint64_t vertices = 0;
+    uint64_t instances = 0;
+    uint32_t stateChanges = 0;
+    uint32_t textureBinds = 0;
+    uint64_t bufferUploadBytes = 0;
+    uint32_t uniformUploads = 0;
+    uint32_t uniformUploadsSkipped = 0;     // Redundant sets caught by the shaders' value mirrors
+    float cpuTimeMs = 0.0f;
+    
+    // Fraction of the output resolution the scene was rendered at
+    float resolutionScale = 1.0f;
+    
+    // Pooled offscreen targets
+    uint32_t renderTargets = 0;
+    size_t renderTargetMemoryBytes = 0;
+    
+    // GPU timings lag behind the CPU counters by the query latency;
+    // gpuFrameIndex identifies the frame they were measured on
+    bool gpuTimeValid = false;
+    uint64_t gpuFrameIndex = 0;
+    float gpuTimeMs = 0.0f;
+    std::vector<RenderPassTiming> passes;
+};
+
+using RenderStatsCallback = std::function<void(const RenderStats&)>;
+
 class Renderer {
 public:
-    Renderer();
+    // Defaults to the OpenGL backend
+    explicit Renderer(std::unique_ptr<RenderBackend> backend = nullptr);
     ~Renderer();
     
     bool initialize();
     void shutdown();
     
+    // Frame lifecycle
+    void beginFrame();
+    void endFrame();
+    void beginPass(const std::string& name);
+    void endPass();
+    
     void clear();
     void setViewport(int x, int y, int width, int height);
     void present();
     
     void setClearColor(const Color& color);
     void enableBlending(bool enable);
+    void enableDepthTest(bool enable);
+    void enableDepthWrite(bool enable);
+    void setDepthFunc(DepthFunc func);
     void setBlendMode(BlendMode mode);
+    
+    const Color& getClearColor() const { return m_clearColor; }
+    bool isBlendingEnabled() const { return m_blendingEnabled; }
+    bool isDepthTestEnabled() const { return m_depthTestEnabled; }
+    bool isDepthWriteEnabled() const { return m_depthWriteEnabled; }
+    DepthFunc getDepthFunc() const { return m_depthFunc; }
+    BlendMode getBlendMode() const { return m_blendMode; }
+    
+    // Redirects drawing into an offscreen target sized viewport; nullptr
+    // returns to the frame's own target (the scaled scene or the window)
+    void bindRenderTarget(RenderTarget* target);
+    
+    // Camera for subsequent draws, shared by every shader through the
+    // CameraData block; uploads only when it differs from the current one
+    void setCamera(const Matrix4& view, const Matrix4& projection,
+                   const Vector2& position = Vector2(0.0f), float zoom = 1.0f);
+    SharedUniformBuffers& getSharedUniforms() { return m_sharedUniforms; }
+    
+    // Backend that receives all GPU commands from the renderer and the
+    // systems drawing through it
+    RenderBackend& getBackend() { return *m_backend; }
+    
+    // Output size and dynamic resolution
+    void setOutputSize(int width, int height);
+    int getOutputWidth() const { return m_outputWidth; }
+    int getOutputHeight() const { return m_outputHeight; }
+    int getRenderWidth() const;
+    int getRenderHeight() const;
+    
+    void enableDynamicResolution(bool enable);
+    bool isDynamicResolutionEnabled() const { return m_dynamicResolutionEnabled; }
+    DynamicResolution& getDynamicResolution() { return m_dynamicResolution; }
+    float getResolutionScale() const { return m_dynamicResolutionEnabled ? m_frameScale : 1.0f; }
+    
+    // Transient offscreen targets for post-processing and offscreen passes
+    RenderTargetPool& getRenderTargetPool() { return m_renderTargetPool; }
+    
+    // Asynchronous capture of presented frames (OpenGL backend only)
+    FrameCapture& getFrameCapture() { return m_frameCapture; }
+    
+    // Statistics recording, called by systems that submit GPU work
+    void recordDrawCall(uint32_t vertexCount, uint32_t instanceCount = 1);
+    void recordStateChange() { m_currentStats.stateChanges++; }
+    void recordTextureBind() { m_currentStats.textureBinds++; }
+    void recordBufferUpload(size_t bytes) { m_currentStats.bufferUploadBytes += bytes; }
+    
+    // Statistics access
+    const RenderStats& getFrameStats() const { return m_frameStats; }
+    bool isGPUTimingSupported() const { return m_timerQueriesSupported; }
+    void setStatsCallback(RenderStatsCallback callback) { m_statsCallback = callback; }
+
+private:
+    static constexpr int QUERY_BUFFER_COUNT = 2;
+    
+    struct PassQuery {
+        std::string name;
+        unsigned int query = 0;
+    };
+    
+    struct QuerySet {
+        std::vector<unsigned int> queries;
+        std::vector<PassQuery> passes;
+        uint64_t frameIndex = 0;
+        bool pending = false;
+    };
+    
+    std::unique_ptr<RenderBackend> m_backend;
+    bool m_initialized;
+    bool m_inFrame;
+    bool m_timerQueriesSupported;
+    uint64_t m_frameIndex;
+    TimePoint m_frameStartTime;
+    TimePoint m_initializeTime;
+    
+    // FrameData is rewritten in beginFrame, CameraData by setCamera
+    SharedUniformBuffers m_sharedUniforms;
+    
+    // Timer queries
+    QuerySet m_querySets[QUERY_BUFFER_COUNT];
+    int m_passDepth;
+    
+    // Statistics
+    RenderStats m_currentStats;
+    RenderStats m_frameStats;
+    RenderStatsCallback m_statsCallback;
+    
+    RenderTargetPool m_renderTargetPool;
+    FrameCapture m_frameCapture;
+    
+    // Dynamic resolution
+    bool m_dynamicResolutionEnabled;
+    DynamicResolution m_dynamicResolution;
+    RenderTarget* m_sceneTarget;
+    std::shared_ptr<Shader> m_blitShader;
+    unsigned int m_blitVAO;
+    int m_outputWidth;
+    int m_outputHeight;
+    float m_frameScale;
+    bool m_renderingOffscreen;
+    uint64_t m_lastSampledGPUFrame;
+    
+    // Tracked so passes can restore state without querying the backend
+    bool m_blendingEnabled;
+    bool m_depthTestEnabled;
+    bool m_depthWriteEnabled;
+    DepthFunc m_depthFunc;
+    BlendMode m_blendMode;
+    Color m_clearColor;
+    
+    QuerySet& currentQuerySet() { return m_querySets[m_frameIndex % QUERY_BUFFER_COUNT]; }
+    bool collectQueryResults(QuerySet& set);
+    void destroyQueries();
+    bool prepareSceneTarget();
+    void upscaleSceneTarget();
+    void destroySceneTarget();
 };
 
 } // namespace GameEngine2D
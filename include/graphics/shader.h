@@ -1,12 +1,29 @@
 #pragma once
 
 #include "types.h"
+#include "graphics/uniform_handle.h"
+#include "graphics/uniform_buffer.h"
+#include "graphics/shader_preprocessor.h"
 #include <string>
+#include <vector>
 #include <unordered_map>
 #include <memory>
 
 namespace GameEngine2D {
 
+enum class ShaderStatus {
+    EMPTY = 0,
+    COMPILING = 1,  // Compile and link issued, result not collected yet
+    READY = 2,
+    FAILED = 3
+};
+
+// Uniform uploads counted by the shaders' value mirrors since the last reset
+struct UniformUploadStats {
+    uint32_t issued = 0;
+    uint32_t skipped = 0;   // Value already current on the program
+};
+
 class Shader {
 public:
     Shader();
@@ -17,12 +34,23 @@ public:
     bool loadFromSource(const std::string& vertexSource, const std::string& fragmentSource);
     void destroy();
     
+    // Asynchronous compilation: compileAsync issues the compile and link and
+    // returns at once; pollCompile collects the result without blocking when
+    // the driver supports GL_KHR_parallel_shader_compile (and waits for it
+    // otherwise); finishCompile always waits. Both return true once ready.
+    bool compileAsync(const std::string& vertexSource, const std::string& fragmentSource);
+    bool pollCompile();
+    bool finishCompile();
+    ShaderStatus getStatus() const { return m_status; }
+    bool isPending() const { return m_status == ShaderStatus::COMPILING; }
+    
     // Shader usage
     void bind() const;
     void unbind() const;
-    bool isValid() const { return m_programID != 0; }
+    bool isValid() const { return m_status == ShaderStatus::READY; }
     
-    // Uniform setters
+    // Uniform setters. Every setter compares against a CPU mirror of the
+    // program's current values and skips the glUniform call when unchanged.
     void setUniform(const std::string& name, int value);
     void setUniform(const std::string& name, float value);
     void setUniform(const std::string& name, const Vector2& value);
@@ -43,46 +71,149 @@ public:
     // Texture uniforms
     void setUniform(const std::string& name, int textureUnit);
     
+    // Handle setters; the per-frame path, without string hashing or lookups
+    void setUniform(UniformHandle handle, int value);
+    void setUniform(UniformHandle handle, float value);
+    void setUniform(UniformHandle handle, const Vector2& value);
+    void setUniform(UniformHandle handle, const Vector3& value);
+    void setUniform(UniformHandle handle, const Vector4& value);
+    void setUniform(UniformHandle handle, const Matrix3& value);
+    void setUniform(UniformHandle handle, const Matrix4& value);
+    void setUniform(UniformHandle handle, bool value);
+    
+    // Totals over all shaders; the renderer resets them every frame
+    static const UniformUploadStats& getUploadStats() { return s_uploadStats; }
+    static void resetUploadStats() { s_uploadStats = UniformUploadStats{}; }
+    
     // Shader introspection
     int getUniformLocation(const std::string& name) const;
+    int getUniformLocation(UniformHandle handle);
     int getAttributeLocation(const std::string& name) const;
     std::vector<std::string> getUniformNames() const;
     std::vector<std::string> getAttributeNames() const;
     
+    // Shared blocks (see UniformBlockLayout) found with a valid layout and
+    // assigned to their binding point at link time
+    bool usesUniformBlock(UniformBlockBinding binding) const {
+        return (m_uniformBlocks & (1u << static_cast<unsigned int>(binding))) != 0;
+    }
+    
     // Shader program ID
     unsigned int getProgramID() const { return m_programID; }
+    
+    // Family and define mask of programs built by ShaderManager::getVariant;
+    // empty family for everything else
+    const std::string& getVariantFamily() const { return m_variantFamily; }
+    uint32_t getDefineMask() const { return m_defineMask; }
 
 private:
+    friend class ShaderManager;
+    
     unsigned int m_programID;
+    ShaderStatus m_status;
+    unsigned int m_pendingVertex;
+    unsigned int m_pendingFragment;
+    uint64_t m_cacheKey;
+    bool m_storeBinary;
+    uint32_t m_uniformBlocks;
+    std::string m_variantFamily;
+    uint32_t m_defineMask;
     mutable std::unordered_map<std::string, int> m_uniformCache;
     mutable std::unordered_map<std::string, int> m_attributeCache;
     
+    // Locations indexed by UniformHandle::getIndex(); filled for every active
+    // uniform at link time, and on first use for handles registered later
+    static constexpr int UNRESOLVED_LOCATION = -2;
+    std::vector<int> m_handleLocations;
+    
+    // Mirror of uniform values indexed by location, sized from the active
+    // uniforms at link time. Array elements have consecutive locations and
+    // get an entry each, so partial array updates are tracked as well.
+    struct UniformMirrorEntry {
+        uint32_t offset = 0;        // Into m_uniformValues
+        uint16_t elementBytes = 0;  // 0 for locations that aren't mirrored
+        uint16_t remaining = 0;     // Elements from this one to the end of the array
+        bool known = false;         // Set through this shader since it was linked
+    };
+    static constexpr int MAX_MIRRORED_LOCATION = 4096;
+    std::vector<UniformMirrorEntry> m_uniformMirror;
+    std::vector<unsigned char> m_uniformValues;
+    static UniformUploadStats s_uploadStats;
+    
     // Shader compilation
     unsigned int compileShader(const std::string& source, unsigned int type);
-    bool linkProgram(unsigned int vertexShader, unsigned int fragmentShader);
+    void linkProgram(unsigned int vertexShader, unsigned int fragmentShader);
+    bool checkCompileStatus(unsigned int shader, const char* stage);
+    void onProgramLinked();
+    void releasePendingStages();
     std::string getShaderInfoLog(unsigned int shader);
     std::string getProgramInfoLog(unsigned int program);
     
     // Cache management
     int getCachedUniformLocation(const std::string& name) const;
     int getCachedAttributeLocation(const std::string& name) const;
+    int getHandleLocation(UniformHandle handle) {
+        uint32_t index = handle.getIndex();
+        if (index < m_handleLocations.size() && m_handleLocations[index] != UNRESOLVED_LOCATION) {
+            return m_handleLocations[index];
+        }
+        return resolveHandleLocation(handle);
+    }
+    int resolveHandleLocation(UniformHandle handle);
+    
+    // False when the value is already current and the upload can be skipped;
+    // otherwise records it in the mirror
+    bool updateMirror(int location, const void* data, size_t elementBytes, size_t count = 1);
+    void addMirrorEntries(int location, int count, unsigned int type);
     
     // Shader introspection
     void introspectProgram();
+    void introspectUniformBlocks();
+    bool validateUniformBlock(unsigned int blockIndex, const UniformBlockLayout& layout) const;
     std::vector<std::string> getActiveUniforms() const;
     std::vector<std::string> getActiveAttributes() const;
 };
 
-// Shader manager for caching and managing shaders
+// Shader whose program may still be compiling. The shader object is usable
+// right away; backends skip draws with it until it is ready.
+class ShaderFuture {
+public:
+    ShaderFuture() = default;
+    explicit ShaderFuture(std::shared_ptr<Shader> shader) : m_shader(std::move(shader)) {}
+    
+    bool isValid() const { return m_shader != nullptr; }
+    
+    // Never blocks where GL_KHR_parallel_shader_compile is available
+    bool isReady() const { return m_shader && m_shader->pollCompile(); }
+    
+    // Waits for the driver; nullptr if compiling or linking failed
+    std::shared_ptr<Shader> get() const {
+        return m_shader && m_shader->finishCompile() ? m_shader : nullptr;
+    }
+    
+    const std::shared_ptr<Shader>& getShader() const { return m_shader; }
+
+private:
+    std::shared_ptr<Shader> m_shader;
+};
+
+// Shader manager for caching and managing shaders. Every program is
+// compiled asynchronously, so loading many shaders issues all their
+// compiles before any result is waited on.
 class ShaderManager {
 public:
     static ShaderManager& getInstance();
     
     // Shader management
-    std::shared_ptr<Shader> loadShader(const std::string& name, 
-                                      const std::string& vertexPath, 
-                                      const std::string& fragmentPath);
+    ShaderFuture loadShader(const std::string& name,
+                            const std::string& vertexPath,
+                            const std::string& fragmentPath);
     std::shared_ptr<Shader> getShader(const std::string& name);
+    
+    // Collects the named shader's compile like ShaderFuture::isReady. EMPTY
+    // when no such shader is loaded; FAILED evicts it, so loading or creating
+    // it again compiles anew. getShader and getVariant skip failed entries too.
+    ShaderStatus getShaderStatus(const std::string& name);
     bool unloadShader(const std::string& name);
     void unloadAll();
     
@@ -92,18 +223,76 @@ public:
     std::shared_ptr<Shader> createColorShader();
     std::shared_ptr<Shader> createParticleShader();
     std::shared_ptr<Shader> createLightingShader();
+    std::shared_ptr<Shader> createTextShader();
+    std::shared_ptr<Shader> createBlitShader();
+    
+    // Variant of the basic shader for the 20-byte PackedVertex format
+    std::shared_ptr<Shader> createPackedShader();
+    
+    // Shader families: one source pair specialized by preprocessor defines
+    // instead of runtime branches. Bit i of a define mask enables defines[i];
+    // each (source hash, mask) pair is compiled on first request and cached.
+    // Re-registering a family with new source leaves existing variants with
+    // their users and builds new ones from the new source.
+    bool registerShaderSource(const std::string& family, const std::string& vertexSource,
+                              const std::string& fragmentSource, const std::vector<std::string>& defines);
+    std::shared_ptr<Shader> getVariant(const std::string& family, uint32_t defineMask);
+    
+    // Mask bit of a family define, 0 when the family does not have it
+    uint32_t getDefineBit(const std::string& family, const std::string& define) const;
+    
+    // Variant of shader's family with one define switched on or off; nullptr
+    // when shader is not a family variant or its family lacks the define
+    std::shared_ptr<Shader> getRelatedVariant(const Shader& shader, const std::string& define, bool enabled);
+    
+    // Resolves #include for every program the manager compiles. The shared
+    // uniform blocks are available as "engine/shared_blocks.glsl". Files from
+    // loadShader also resolve includes next to themselves; other directories
+    // have to be added with addIncludeDirectory.
+    ShaderPreprocessor& getPreprocessor() { return m_preprocessor; }
+    
+    // Collects finished compiles without blocking; returns how many are still pending
+    size_t pollPendingShaders();
+    
+    // Waits for every outstanding compile, e.g. behind a loading screen
+    void finishPendingShaders();
     
     // Statistics
-    size_t getShaderCount() const { return m_shaders.size(); }
+    size_t getShaderCount() const { return m_shaders.size() + m_variants.size(); }
     std::vector<std::string> getShaderNames() const;
 
 private:
-    ShaderManager() = default;
+    ShaderManager();
     ~ShaderManager() = default;
     ShaderManager(const ShaderManager&) = delete;
     ShaderManager& operator=(const ShaderManager&) = delete;
     
+    struct ShaderFamily {
+        std::string vertexSource;
+        std::string fragmentSource;
+        std::vector<std::string> defines;
+        uint64_t sourceHash;
+    };
+    
     std::unordered_map<std::string, std::shared_ptr<Shader>> m_shaders;
+    std::unordered_map<std::string, ShaderFamily> m_families;
+    std::unordered_map<uint64_t, std::shared_ptr<Shader>> m_variants;  // By (source hash, define mask)
+    ShaderPreprocessor m_preprocessor;
+    bool m_parallelCompileConfigured;
+    bool m_builtinFamiliesRegistered;
+    
+    // The directories are where file sources were loaded from; relative
+    // includes in them resolve there before the preprocessor's search path
+    std::shared_ptr<Shader> createFromSource(const std::string& name, const std::string& vertexSource,
+                                             const std::string& fragmentSource,
+                                             const std::string& vertexDirectory = "",
+                                             const std::string& fragmentDirectory = "");
+    std::shared_ptr<Shader> compileProgram(const std::string& label, const std::string& vertexSource,
+                                           const std::string& fragmentSource,
+                                           const std::vector<std::string>& defines,
+                                           const std::string& vertexDirectory = "",
+                                           const std::string& fragmentDirectory = "");
+    void registerBuiltinFamilies();
 };
 
 } // namespace GameEngine2D
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace GameEngine2D {
+
+// Expands #include directives and injects #define lines into GLSL sources
+// before compilation. Includes are resolved against registered in-memory
+// sources first, then next to the including file, then against the include
+// directories. A file with #pragma once is expanded at most once per
+// program, even when it ends up including itself; other files are expanded
+// wherever they are included, and including themselves is an include cycle.
+// Defines are inserted right after the #version line, either as "NAME"
+// (defined to 1) or "NAME VALUE".
+class ShaderPreprocessor {
+public:
+    ShaderPreprocessor();
+    
+    void addInclude(const std::string& name, const std::string& source);
+    void addIncludeDirectory(const std::string& directory);
+    bool hasInclude(const std::string& name) const;
+    
+    // Returns false and describes the problem in error on a missing or
+    // recursive include. sourceDirectory, when given, is where the source
+    // was loaded from and is searched only for this call.
+    bool process(const std::string& source, const std::vector<std::string>& defines,
+                 std::string& output, std::string& error, const std::string& sourceDirectory = "") const;
+
+private:
+    static constexpr int MAX_INCLUDE_DEPTH = 16;
+    
+    std::unordered_map<std::string, std::string> m_includes;
+    std::vector<std::string> m_includeDirectories;
+    
+    struct ExpandState {
+        std::vector<std::string> stack;             // Files being expanded, outermost first
+        std::unordered_set<std::string> onceFiles;  // Expanded files containing #pragma once
+    };
+    
+    bool expand(const std::string& source, const std::string& sourceName, const std::string& directory,
+                ExpandState& state, std::string& output, std::string& error) const;
+    
+    // path identifies the include: its name for in-memory sources, the file
+    // path otherwise
+    bool resolveInclude(const std::string& name, const std::string& directory,
+                        std::string& path, std::string& source) const;
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "types.h"
+#include <vector>
+#include <memory>
+
+namespace GameEngine2D {
+
+class Renderer;
+class BatchRenderer;
+class Shader;
+class Texture;
+
+struct SpriteQueueStats {
+    uint32_t opaqueSprites = 0;
+    uint32_t translucentSprites = 0;
+    
+    // Estimated fragments shaded per render-target pixel, drawing everything
+    // back to front without depth rejection versus the two-pass order;
+    // only filled in while overdraw estimation is enabled
+    float overdrawPainter = 0.0f;
+    float overdrawSorted = 0.0f;
+    float overdrawReduction = 0.0f;
+};
+
+// Collects a frame's sprites and draws them in two passes to cut overdraw.
+// Sprites whose texture is fully opaque and whose tint has full alpha are
+// drawn first, front to back with depth writes and blending off, so hidden
+// fragments fail the depth test before shading. Everything else follows
+// back to front with depth testing only. Higher depth is nearer the camera,
+// and the projection must keep every depth inside its clip range. Among
+// sprites at equal depth, later submissions end up on top, and translucent
+// sprites cover opaque ones.
+class SpriteQueue {
+public:
+    SpriteQueue();
+    
+    // Submission
+    void submit(const Vector2& position, const Vector2& size, const Texture& texture,
+                const Vector4& uvRect, const Color& color, float depth = 0.0f);
+    void submit(const Vector2& position, const Vector2& size, TextureID texture, bool opaqueTexture,
+                const Vector4& uvRect, const Color& color, float depth = 0.0f);
+    void clear();
+    size_t getSize() const { return m_opaque.size() + m_translucent.size(); }
+    
+    // Draws and clears the queue; the batch must not be between begin and end
+    void flush(Renderer& renderer, BatchRenderer& batch, std::shared_ptr<Shader> shader,
+               const Matrix4& view, const Matrix4& projection);
+    
+    // Overdraw estimation rasterizes sprite bounds into a coarse screen grid,
+    // which costs CPU time; meant for profiling sessions and benchmarks
+    void setOverdrawEstimation(bool enable, int cellSize = 8);
+    bool isOverdrawEstimationEnabled() const { return m_estimateOverdraw; }
+    
+    // Statistics of the last flush
+    const SpriteQueueStats& getStats() const { return m_stats; }
+
+private:
+    struct Entry {
+        Vector2 position;
+        Vector2 size;
+        TextureID texture;
+        Vector4 uvRect;
+        Color color;
+        float depth;
+        uint32_t order;
+    };
+    
+    std::vector<Entry> m_opaque;
+    std::vector<Entry> m_translucent;
+    uint32_t m_nextOrder;
+    SpriteQueueStats m_stats;
+    
+    bool m_estimateOverdraw;
+    int m_cellSize;
+    std::vector<float> m_cellDepth;
+    
+    void drawEntries(BatchRenderer& batch, const std::vector<Entry>& entries);
+    void estimateOverdraw(Renderer& renderer, const Matrix4& viewProjection);
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "types.h"
+#include "graphics/font.h"
+#include "graphics/glyph_atlas.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace GameEngine2D {
+
+class Shader;
+class BatchRenderer;
+
+// Positioned glyph quad relative to the layout origin (top-left, y down)
+struct LayoutGlyph {
+    uint32_t codepoint = 0;
+    Vector2 position;
+    Vector2 size;
+    AtlasGlyph atlas;
+};
+
+struct TextLayout {
+    std::vector<LayoutGlyph> glyphs;
+    Vector2 size;
+    FontID font = 0;
+    uint64_t lastUsedFrame = 0;
+};
+
+struct TextRendererStats {
+    uint32_t layoutHits = 0;
+    uint32_t layoutsBuilt = 0;
+    uint32_t cachedLayouts = 0;
+    uint32_t glyphsDrawn = 0;
+};
+
+// Lays out strings into cached glyph runs and emits SDF quads into the
+// sprite batch. Layouts are keyed by (text, font, size, wrap width), so an
+// unchanged label costs one hash lookup and a changed one rebuilds only itself.
+class TextRenderer {
+public:
+    TextRenderer(int atlasSize = 1024, int atlasCellSize = 48);
+    ~TextRenderer();
+    
+    bool initialize();
+    void shutdown();
+    void beginFrame();
+    
+    // Layout
+    std::shared_ptr<TextLayout> layout(const std::string& text, Font& font, float size, float wrapWidth = 0.0f);
+    Vector2 measure(const std::string& text, Font& font, float size, float wrapWidth = 0.0f);
+    
+    // Drawing
+    void drawText(BatchRenderer& batch, const std::string& text, Font& font, float size,
+                  const Vector2& position, const Color& color, float wrapWidth = 0.0f);
+    void drawLayout(BatchRenderer& batch, TextLayout& layout, Font& font,
+                    const Vector2& position, const Color& color, float depth = 0.0f);
+    
+    // Cache configuration
+    void setLayoutRetentionFrames(uint32_t frames) { m_retentionFrames = frames; }
+    void clearLayoutCache();
+    
+    // Properties
+    GlyphAtlas& getAtlas() { return m_atlas; }
+    std::shared_ptr<Shader> getShader() const { return m_shader; }
+    const TextRendererStats& getStats() const { return m_stats; }
+
+private:
+    struct LayoutKey {
+        std::string text;
+        FontID font;
+        float size;
+        float wrapWidth;
+        
+        bool operator==(const LayoutKey& other) const {
+            return font == other.font && size == other.size &&
+                   wrapWidth == other.wrapWidth && text == other.text;
+        }
+    };
+    
+    struct LayoutKeyHash {
+        size_t operator()(const LayoutKey& key) const;
+    };
+    
+    GlyphAtlas m_atlas;
+    std::shared_ptr<Shader> m_shader;
+    std::unordered_map<LayoutKey, std::shared_ptr<TextLayout>, LayoutKeyHash> m_layouts;
+    uint64_t m_frame;
+    uint32_t m_retentionFrames;
+    TextRendererStats m_stats;
+    
+    std::shared_ptr<TextLayout> buildLayout(const std::string& text, Font& font, float size, float wrapWidth);
+    void evictUnusedLayouts();
+};
+
+// Retained text element; its layout is only rebuilt when a property changes
+class TextLabel {
+public:
+    TextLabel(std::shared_ptr<Font> font, float size = 16.0f);
+    
+    // Properties
+    void setText(const std::string& text);
+    void setFont(std::shared_ptr<Font> font);
+    void setSize(float size);
+    void setWrapWidth(float wrapWidth);
+    void setPosition(const Vector2& position) { m_position = position; }
+    void setColor(const Color& color) { m_color = color; }
+    void setDepth(float depth) { m_depth = depth; }
+    
+    const std::string& getText() const { return m_text; }
+    const Vector2& getPosition() const { return m_position; }
+    Vector2 getSize(TextRenderer& textRenderer);
+    
+    void draw(TextRenderer& textRenderer, BatchRenderer& batch);
+
+private:
+    std::string m_text;
+    std::shared_ptr<Font> m_font;
+    float m_size;
+    float m_wrapWidth;
+    Vector2 m_position;
+    Color m_color;
+    float m_depth;
+    
+    std::shared_ptr<TextLayout> m_layout;
+    bool m_dirty;
+    
+    void updateLayout(TextRenderer& textRenderer);
+};
+
+} // namespace GameEngine2D
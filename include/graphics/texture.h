@@ -0,0 +1,47 @@
+#pragma once
+
+#include "types.h"
+
+namespace GameEngine2D {
+
+// How a texture's alpha channel affects rendering, decided at load time
+enum class TextureAlpha {
+    FULLY_OPAQUE = 0,   // Every texel has full alpha; safe for depth-sorted opaque drawing
+    TRANSLUCENT = 1     // Some texels are transparent or partially transparent
+};
+
+// RGBA8 2D texture. The alpha channel is scanned once when pixels are
+// uploaded so sprite passes can tell opaque textures from translucent ones.
+class Texture {
+public:
+    Texture();
+    ~Texture();
+    
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+    
+    // Lifecycle; pixels are tightly packed RGBA8 rows, top row first
+    bool create(int width, int height, const uint8_t* pixels, const TextureConfig& config = TextureConfig());
+    void destroy();
+    
+    // Usage
+    void bind(unsigned int unit = 0) const;
+    
+    // Properties
+    bool isValid() const { return m_id != 0; }
+    TextureID getID() const { return m_id; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    TextureAlpha getAlpha() const { return m_alpha; }
+    bool isOpaque() const { return m_alpha == TextureAlpha::FULLY_OPAQUE; }
+    
+    static TextureAlpha analyzeAlpha(const uint8_t* pixels, int width, int height);
+
+private:
+    TextureID m_id;
+    int m_width;
+    int m_height;
+    TextureAlpha m_alpha;
+};
+
+} // namespace GameEngine2D
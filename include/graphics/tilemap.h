@@ -0,0 +1,105 @@
+#pragma once
+
+#include "types.h"
+#include "graphics/vertex_layout.h"
+#include <vector>
+#include <memory>
+
+namespace GameEngine2D {
+
+class Renderer;
+class RenderBackend;
+class Shader;
+
+using TileID = uint16_t;
+constexpr TileID EMPTY_TILE = 0;
+
+struct TilemapConfig {
+    int width = 256;
+    int height = 256;
+    float tileSize = 32.0f;
+    int chunkSize = 32;             // Tiles per chunk side, at most 64
+    int tilesetColumns = 16;
+    int tilesetRows = 16;
+    int evictAfterFrames = 120;     // Drop GPU buffers of chunks unseen for this long
+};
+
+struct TilemapStats {
+    uint32_t visibleChunks = 0;
+    uint32_t drawnChunks = 0;
+    uint32_t rebuiltChunks = 0;
+    uint32_t residentChunks = 0;
+    uint32_t evictedChunks = 0;
+};
+
+// Tile layer split into fixed-size chunks. Each chunk owns a static vertex
+// buffer that is built the first time it becomes visible and rebuilt only
+// when one of its tiles changes; chunks are culled against the view bounds
+// by index range, so frame cost depends on the screen size, not the map size.
+class Tilemap {
+public:
+    Tilemap(const TilemapConfig& config);
+    ~Tilemap();
+    
+    // Tile access
+    void setTile(int x, int y, TileID tile);
+    TileID getTile(int x, int y) const;
+    void fill(int x, int y, int width, int height, TileID tile);
+    void clear();
+    
+    // Rendering; chunks are built from PackedVertex, so use the "packed" shader
+    void setShader(std::shared_ptr<Shader> shader) { m_shader = shader; }
+    void setTileset(TextureID texture, int columns, int rows);
+    void setPosition(const Vector2& position) { m_position = position; }
+    void setColor(const Color& color);
+    void render(Renderer& renderer, const Rectangle& viewBounds,
+                const Matrix4& view, const Matrix4& projection);
+    
+    // GPU resources
+    void releaseGPUResources();
+    
+    // Properties
+    int getWidth() const { return m_config.width; }
+    int getHeight() const { return m_config.height; }
+    float getTileSize() const { return m_config.tileSize; }
+    const Vector2& getPosition() const { return m_position; }
+    Rectangle getBounds() const;
+    const TilemapStats& getStats() const { return m_stats; }
+
+private:
+    struct Chunk {
+        unsigned int vao = 0;
+        unsigned int vbo = 0;
+        uint32_t quadCount = 0;
+        uint64_t lastVisibleFrame = 0;
+        bool dirty = true;
+        bool resident = false;
+    };
+    
+    TilemapConfig m_config;
+    std::vector<TileID> m_tiles;
+    std::vector<Chunk> m_chunks;
+    std::vector<int> m_residentChunks;
+    int m_chunksX;
+    int m_chunksY;
+    RenderBackend* m_backend;
+    
+    std::shared_ptr<Shader> m_shader;
+    TextureID m_tileset;
+    Vector2 m_position;
+    Color m_color;
+    
+    unsigned int m_indexBuffer;
+    uint64_t m_frame;
+    TilemapStats m_stats;
+    
+    // Chunk management
+    int chunkIndex(int chunkX, int chunkY) const { return chunkY * m_chunksX + chunkX; }
+    void markDirty(int x, int y);
+    void rebuildChunk(Renderer& renderer, int index, std::vector<PackedVertex>& scratch);
+    void releaseChunk(Chunk& chunk);
+    void evictStaleChunks();
+    void ensureIndexBuffer(Renderer& renderer);
+};
+
+} // namespace GameEngine2D
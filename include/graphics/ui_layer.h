@@ -0,0 +1,183 @@
+#pragma once
+
+#include "types.h"
+#include "graphics/vertex_layout.h"
+#include <vector>
+#include <memory>
+
+namespace GameEngine2D {
+
+class Renderer;
+class BatchRenderer;
+class Shader;
+class UILayer;
+
+// Insets of a nine-slice border, in source texels
+struct UIBorder {
+    float left = 0.0f;
+    float top = 0.0f;
+    float right = 0.0f;
+    float bottom = 0.0f;
+    
+    UIBorder() = default;
+    UIBorder(float all) : left(all), top(all), right(all), bottom(all) {}
+    UIBorder(float l, float t, float r, float b) : left(l), top(t), right(r), bottom(b) {}
+};
+
+struct UILayerStats {
+    uint32_t widgets = 0;
+    uint32_t rebuiltWidgets = 0;    // Widgets whose geometry was regenerated this frame
+    uint32_t quads = 0;
+    uint32_t runs = 0;              // Texture runs submitted to the batch
+    bool streamRebuilt = false;     // Whole layer stream reassembled this frame
+};
+
+// Retained widget. Geometry is generated into a vertex cache when a property
+// changes and reused untouched on every other frame. Coordinates are in the
+// UI projection's units, with uvRect.xy at the top-left corner as in
+// BatchRenderer::drawQuad.
+class UIWidget {
+public:
+    virtual ~UIWidget() = default;
+    
+    UIWidget(const UIWidget&) = delete;
+    UIWidget& operator=(const UIWidget&) = delete;
+    
+    // Properties; setters only mark the widget dirty when the value changes
+    void setPosition(const Vector2& position);
+    void setSize(const Vector2& size);
+    void setColor(const Color& color);
+    void setTexture(TextureID texture, const Vector4& uvRect = Vector4(0.0f, 0.0f, 1.0f, 1.0f));
+    void setVisible(bool visible);
+    void setLayer(int layer);
+    
+    const Vector2& getPosition() const { return m_position; }
+    const Vector2& getSize() const { return m_size; }
+    const Color& getColor() const { return m_color; }
+    TextureID getTexture() const { return m_texture; }
+    const Vector4& getUVRect() const { return m_uvRect; }
+    bool isVisible() const { return m_visible; }
+    int getLayer() const { return m_layer; }
+    bool isDirty() const { return m_dirty; }
+
+protected:
+    UIWidget();
+    
+    void markDirty();
+    virtual void buildGeometry(std::vector<PackedVertex>& vertices) const = 0;
+    
+    static void appendQuad(std::vector<PackedVertex>& vertices, float x0, float y0, float x1, float y1,
+                           float u0, float v0, float u1, float v1, uint32_t color);
+
+private:
+    friend class UILayer;
+    
+    UILayer* m_owner;
+    uint32_t m_creationIndex;
+    Vector2 m_position;
+    Vector2 m_size;
+    Color m_color;
+    TextureID m_texture;
+    Vector4 m_uvRect;
+    bool m_visible;
+    int m_layer;
+    
+    bool m_dirty;
+    std::vector<PackedVertex> m_vertices;
+    size_t m_streamOffset;  // First vertex in the layer stream; valid while drawn
+};
+
+// Single quad: icons, solid rectangles and plain images
+class UIImage : public UIWidget {
+protected:
+    void buildGeometry(std::vector<PackedVertex>& vertices) const override;
+};
+
+// Nine-slice panel: corners keep their size, edges stretch along one axis
+// and the center stretches along both. Borders shrink proportionally when
+// the panel is smaller than the two opposite insets.
+class UIPanel : public UIWidget {
+public:
+    // sourceSize is the texel size of the uvRect region the insets refer to
+    void setBorder(const UIBorder& border, const Vector2& sourceSize);
+    const UIBorder& getBorder() const { return m_border; }
+
+protected:
+    void buildGeometry(std::vector<PackedVertex>& vertices) const override;
+
+private:
+    UIBorder m_border;
+    Vector2 m_sourceSize = Vector2(1.0f, 1.0f);
+};
+
+// Horizontal bar: a background quad and a fill quad sized by the value
+class UIProgressBar : public UIWidget {
+public:
+    void setValue(float value);
+    void setFillColor(const Color& color);
+    float getValue() const { return m_value; }
+
+protected:
+    void buildGeometry(std::vector<PackedVertex>& vertices) const override;
+
+private:
+    float m_value = 1.0f;
+    Color m_fillColor = Color(1.0f, 1.0f, 1.0f, 1.0f);
+};
+
+// Owns widgets and draws them through the sprite batch. Cached widget
+// vertices are assembled into one stream sorted by layer and then texture,
+// so each texture run within a layer becomes one batch. Widgets sharing a
+// layer should therefore not overlap, or should share a texture. A widget
+// whose quad count is unchanged is patched in place; visibility, layer,
+// texture or quad count changes reassemble the stream. Clean frames do no
+// per-widget work.
+class UILayer {
+public:
+    UILayer();
+    ~UILayer();
+    
+    template<typename T>
+    T* create() {
+        auto widget = std::make_unique<T>();
+        T* pointer = widget.get();
+        attach(std::move(widget));
+        return pointer;
+    }
+    void destroy(UIWidget* widget);
+    void clear();
+    
+    // Draws in the projection's units; the batch must not be between begin and end
+    void render(Renderer& renderer, BatchRenderer& batch, std::shared_ptr<Shader> shader,
+                const Matrix4& projection);
+    
+    size_t getWidgetCount() const { return m_widgets.size(); }
+    const UILayerStats& getStats() const { return m_stats; }
+
+private:
+    friend class UIWidget;
+    
+    struct Run {
+        TextureID texture;
+        size_t firstVertex;
+        size_t quadCount;
+    };
+    
+    std::vector<std::unique_ptr<UIWidget>> m_widgets;
+    std::vector<UIWidget*> m_dirtyWidgets;
+    uint32_t m_nextCreationIndex;
+    
+    // Visible widgets in draw order and their concatenated vertices
+    std::vector<UIWidget*> m_drawOrder;
+    std::vector<PackedVertex> m_stream;
+    std::vector<Run> m_runs;
+    bool m_streamDirty;
+    
+    UILayerStats m_stats;
+    
+    void attach(std::unique_ptr<UIWidget> widget);
+    void onWidgetDirty(UIWidget* widget, bool structural);
+    void rebuildStream();
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "types.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine2D {
+
+class RenderBackend;
+
+// Fixed binding points of the engine's shared uniform blocks; shaders get
+// their blocks assigned to these when the program is introspected
+enum class UniformBlockBinding : unsigned int {
+    FRAME = 0,
+    CAMERA = 1
+};
+
+// std140 mirror of
+//     layout (std140) uniform FrameData {
+//         vec2 uScreenSize; vec2 uRenderSize; float uTime; float uDeltaTime;
+//     };
+struct FrameUniforms {
+    Vector2 screenSize = Vector2(0.0f);     // Output size in pixels
+    Vector2 renderSize = Vector2(0.0f);     // Scene size after dynamic resolution
+    float time = 0.0f;                      // Seconds since the renderer was initialized
+    float deltaTime = 0.0f;
+    float padding[2] = {};
+};
+
+// std140 mirror of
+//     layout (std140) uniform CameraData {
+//         mat4 uView; mat4 uProjection; mat4 uViewProjection;
+//         vec2 uCameraPosition; float uCameraZoom;
+//     };
+struct CameraUniforms {
+    Matrix4 view = Matrix4(1.0f);
+    Matrix4 projection = Matrix4(1.0f);
+    Matrix4 viewProjection = Matrix4(1.0f);
+    Vector2 position = Vector2(0.0f);
+    float zoom = 1.0f;
+    float padding = 0.0f;
+};
+
+static_assert(sizeof(FrameUniforms) == 32, "FrameUniforms must match the std140 FrameData block");
+static_assert(sizeof(CameraUniforms) == 208, "CameraUniforms must match the std140 CameraData block");
+
+// Expected std140 layout of a shared block, checked against what the
+// driver reports when a program using the block is introspected
+struct UniformBlockMember {
+    const char* name;
+    size_t offset;
+};
+
+struct UniformBlockLayout {
+    const char* name;
+    UniformBlockBinding binding;
+    size_t size;
+    std::vector<UniformBlockMember> members;
+    
+    // Known shared block by GLSL block name, nullptr for shader-private blocks
+    static const UniformBlockLayout* find(const std::string& name);
+    
+    // GLSL declarations of every shared block, for inclusion in shader sources
+    static const char* getSource();
+};
+
+// Buffers behind the shared blocks. Each is bound to its binding point once
+// at initialization, so program switches need no per-shader uploads; the
+// frame block is rewritten once per frame and the camera block only when
+// the camera actually changes.
+class SharedUniformBuffers {
+public:
+    SharedUniformBuffers();
+    ~SharedUniformBuffers();
+    
+    SharedUniformBuffers(const SharedUniformBuffers&) = delete;
+    SharedUniformBuffers& operator=(const SharedUniformBuffers&) = delete;
+    
+    bool initialize(RenderBackend& backend);
+    void shutdown();
+    bool isInitialized() const { return m_backend != nullptr; }
+    
+    // Return the bytes uploaded, 0 when the contents were already current
+    size_t updateFrame(const FrameUniforms& frame);
+    size_t updateCamera(const CameraUniforms& camera);
+    
+    const FrameUniforms& getFrame() const { return m_frame; }
+    const CameraUniforms& getCamera() const { return m_camera; }
+
+private:
+    RenderBackend* m_backend;
+    unsigned int m_frameBuffer;
+    unsigned int m_cameraBuffer;
+    FrameUniforms m_frame;
+    CameraUniforms m_camera;
+    bool m_cameraValid;
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "utils/hash_utils.h"
+#include <string>
+#include <cstdint>
+
+namespace GameEngine2D {
+
+// Process-wide index for a uniform name. Every distinct name is assigned a
+// small dense index the first time it is seen, either when a handle is
+// constructed or when a linked program is introspected; shaders then keep
+// their locations in a flat array indexed by it, so setting a uniform
+// through a handle is an array load instead of a string hash and lookup.
+// Handles are meant to be created once, typically as file-scope constants:
+//
+//     static const UniformHandle U_PROJECTION("uProjection");
+class UniformHandle {
+public:
+    static constexpr uint32_t INVALID_INDEX = 0xffffffffu;
+    
+    UniformHandle() : m_index(INVALID_INDEX) {}
+    explicit UniformHandle(const char* name);
+    explicit UniformHandle(const std::string& name);
+    
+    bool isValid() const { return m_index != INVALID_INDEX; }
+    uint32_t getIndex() const { return m_index; }
+    const std::string& getName() const;
+    
+    bool operator==(const UniformHandle& other) const { return m_index == other.m_index; }
+    bool operator!=(const UniformHandle& other) const { return m_index != other.m_index; }
+    
+    // Names are keyed by their FNV-1a hash, so literals can be hashed at compile time
+    static constexpr uint64_t hash(const char* name) { return HashUtils::fnv1a(name); }
+    
+    // Number of names registered so far; upper bound of every handle index
+    static uint32_t getRegisteredCount();
+
+private:
+    uint32_t m_index;
+    
+    static uint32_t registerName(uint64_t hash, const char* name, size_t length);
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "types.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace GameEngine2D {
+
+enum class VertexAttributeType {
+    FLOAT = 0,
+    HALF_FLOAT = 1,
+    BYTE = 2,
+    UNSIGNED_BYTE = 3,
+    SHORT = 4,
+    UNSIGNED_SHORT = 5,
+    INT = 6,
+    UNSIGNED_INT = 7
+};
+
+// How the shader sees an attribute: as floats converted directly, as
+// floats normalized to [0, 1] / [-1, 1], or as integers
+enum class VertexAttributeMode {
+    FLOAT = 0,
+    NORMALIZED = 1,
+    INTEGER = 2
+};
+
+struct VertexAttribute {
+    unsigned int location = 0;
+    int components = 0;
+    VertexAttributeType type = VertexAttributeType::FLOAT;
+    VertexAttributeMode mode = VertexAttributeMode::FLOAT;
+    size_t offset = 0;
+};
+
+// Describes an interleaved vertex format; apply() generates the attribute
+// setup for the currently bound VAO and array buffer
+class VertexLayout {
+public:
+    VertexLayout(size_t stride = 0);
+    
+    VertexLayout& add(unsigned int location, int components, VertexAttributeType type, size_t offset,
+                      VertexAttributeMode mode = VertexAttributeMode::FLOAT);
+    
+    void apply() const;
+    
+    size_t getStride() const { return m_stride; }
+    const std::vector<VertexAttribute>& getAttributes() const { return m_attributes; }
+    bool isValid() const;
+    
+    static size_t getTypeSize(VertexAttributeType type);
+
+private:
+    size_t m_stride;
+    std::vector<VertexAttribute> m_attributes;
+};
+
+// Packed 2D vertex, 20 bytes: float2 position, unorm16 UVs, RGBA8 color,
+// half-float depth and an optional texture index for array textures.
+// Matches the "packed" shader variants (locations 0-4).
+struct PackedVertex {
+    Vector2 position;
+    uint16_t texCoord[2];
+    uint32_t color;
+    uint16_t depth;
+    uint16_t textureIndex;
+    
+    static const VertexLayout& getLayout();
+};
+
+static_assert(sizeof(PackedVertex) == 20, "PackedVertex must stay 20 bytes");
+
+// Conversions into packed attribute formats
+class VertexPacking {
+public:
+    static uint16_t packUnorm16(float value);
+    static uint32_t packColor(const Color& color);
+    static uint16_t packHalf(float value);
+    
+    static PackedVertex pack(const Vector3& position, const Vector2& texCoord, const Color& color,
+                             uint16_t textureIndex = 0);
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "scene/entity.h"
+#include "scene/component_registry.h"
+#include <array>
+#include <vector>
+#include <memory>
+
+namespace GameEngine2D {
+
+constexpr size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+
+// Fixed-size block of rows. Data holds the entity column followed by one
+// column per component (SoA), at offsets shared by every chunk of the
+// archetype.
+struct ArchetypeChunk {
+    alignas(MAX_COMPONENT_ALIGNMENT) unsigned char data[ARCHETYPE_CHUNK_SIZE];
+    uint32_t count = 0;
+};
+
+// Chunks are normally owned by their archetype; adopted chunks live in
+// memory someone else keeps alive (a mapped scene file) and aren't freed
+struct ArchetypeChunkDeleter {
+    bool owned = true;
+    void operator()(ArchetypeChunk* chunk) const {
+        if (owned) {
+            delete chunk;
+        }
+    }
+};
+
+using ArchetypeChunkPtr = std::unique_ptr<ArchetypeChunk, ArchetypeChunkDeleter>;
+
+// Whether change version a is later than b; versions wrap around, so
+// anything up to 2^31 ahead counts as later
+inline bool isVersionNewer(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) > 0;
+}
+
+// Placement of one component column inside a chunk
+struct ChunkColumnLayout {
+    size_t size = 0;
+    size_t alignment = 1;
+    uint32_t offset = 0;
+};
+
+// Storage for all entities with exactly one component set. Rows are dense:
+// removing a row moves the archetype's last row into the hole, so every
+// chunk but the last is full and row r lives in chunk r / capacity.
+class Archetype {
+public:
+    explicit Archetype(ComponentMask mask);
+    
+    // Rows per chunk for the entity column followed by these columns in
+    // order, filling in each column's offset; 0 when a single row won't fit.
+    // Shared with the scene writer so files match the runtime layout.
+    static uint32_t computeChunkLayout(std::vector<ChunkColumnLayout>& columns);
+    
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+    
+    ComponentMask getMask() const { return m_mask; }
+    bool hasComponent(ComponentID id) const { return id < MAX_COMPONENT_TYPES && (m_mask >> id) & 1; }
+    const std::vector<ComponentID>& getComponents() const { return m_components; }
+    
+    uint32_t getChunkCapacity() const { return m_chunkCapacity; }
+    size_t getChunkCount() const { return m_chunks.size(); }
+    ArchetypeChunk& getChunk(size_t index) { return *m_chunks[index]; }
+    uint32_t getEntityCount() const { return m_entityCount; }
+    
+    // Column of a component, -1 when the archetype doesn't have it
+    int getColumn(ComponentID id) const { return id < MAX_COMPONENT_TYPES ? m_columnIndex[id] : -1; }
+    size_t getColumnCount() const { return m_columns.size(); }
+    ComponentID getColumnComponent(int column) const { return m_columns[column].id; }
+    size_t getColumnElementSize(int column) const { return m_columns[column].size; }
+    uint32_t getColumnOffset(int column) const { return m_columns[column].offset; }
+    
+    void* getColumnData(ArchetypeChunk& chunk, int column) const { return chunk.data + m_columns[column].offset; }
+    Entity* getEntities(ArchetypeChunk& chunk) const { return reinterpret_cast<Entity*>(chunk.data); }
+    
+    // Row addressing across chunks
+    void* getComponentData(uint32_t row, int column) {
+        const Column& info = m_columns[column];
+        return m_chunks[row / m_chunkCapacity]->data + info.offset + (row % m_chunkCapacity) * info.size;
+    }
+    Entity getEntity(uint32_t row) {
+        return getEntities(*m_chunks[row / m_chunkCapacity])[row % m_chunkCapacity];
+    }
+    
+    // Appends an uninitialized row and returns its index
+    uint32_t allocateRow(Entity entity);
+    
+    // Appends count rows, entity column included, all uninitialized; returns
+    // the first. The new rows are contiguous, so they span at most
+    // count / capacity + 2 chunks.
+    uint32_t allocateRows(uint32_t count);
+    
+    // Fills the hole with the last row; returns the entity that moved into
+    // row, or a null entity when row was the last one
+    Entity removeRow(uint32_t row);
+    
+    // Appends a chunk whose rows are already filled in, entity column
+    // included; only valid while the last chunk is full (canAppendChunk).
+    // Returns the first row of the chunk.
+    bool canAppendChunk() const { return m_chunks.empty() || m_chunks.back()->count == m_chunkCapacity; }
+    uint32_t appendChunk(ArchetypeChunk* chunk, bool owned);
+    
+    void clear();
+    
+    // World change version of the last write to each column of each chunk.
+    // Structural changes mark every column of the chunks they touch.
+    uint32_t getChangeVersion(size_t chunk, int column) const {
+        return m_changeVersions[chunk * m_columns.size() + column];
+    }
+    void markChanged(size_t chunk, int column, uint32_t version) {
+        m_changeVersions[chunk * m_columns.size() + column] = version;
+    }
+    void markChunkChanged(size_t chunk, uint32_t version) {
+        size_t columns = m_columns.size();
+        uint32_t* versions = m_changeVersions.data() + chunk * columns;
+        for (size_t column = 0; column < columns; ++column) {
+            versions[column] = version;
+        }
+    }
+    
+    // Cached transitions for adding or removing one component
+    Archetype* getAddEdge(ComponentID id) const { return m_addEdges[id]; }
+    Archetype* getRemoveEdge(ComponentID id) const { return m_removeEdges[id]; }
+    void setAddEdge(ComponentID id, Archetype* archetype) { m_addEdges[id] = archetype; }
+    void setRemoveEdge(ComponentID id, Archetype* archetype) { m_removeEdges[id] = archetype; }
+
+private:
+    struct Column {
+        ComponentID id;
+        uint32_t offset;
+        uint32_t size;
+    };
+    
+    ComponentMask m_mask;
+    std::vector<ComponentID> m_components;
+    std::vector<Column> m_columns;
+    std::array<int, MAX_COMPONENT_TYPES> m_columnIndex;
+    uint32_t m_chunkCapacity;
+    uint32_t m_entityCount;
+    
+    std::vector<ArchetypeChunkPtr> m_chunks;
+    std::vector<uint32_t> m_changeVersions;     // Chunk-major, one per column; may outgrow m_chunks
+    ArchetypeChunkPtr m_spareChunk;  // Avoids reallocating when a row flips across a chunk boundary
+    
+    std::array<Archetype*, MAX_COMPONENT_TYPES> m_addEdges;
+    std::array<Archetype*, MAX_COMPONENT_TYPES> m_removeEdges;
+    
+    void addChunk();
+    void growChangeVersions();
+    void releaseChunk(ArchetypeChunkPtr chunk);
+};
+
+} // namespace GameEngine2D
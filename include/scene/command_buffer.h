@@ -0,0 +1,125 @@
+#pragma once
+
+#include "scene/world.h"
+#include <memory>
+#include <vector>
+
+namespace GameEngine2D {
+
+struct CommandPlaybackStats {
+    uint32_t created = 0;
+    uint32_t destroyed = 0;
+    uint32_t added = 0;
+    uint32_t removed = 0;
+    uint32_t skipped = 0;       // Aimed at entities that were dead by the time they ran
+};
+
+// Structural changes recorded for later, so systems can create and destroy
+// entities while queries are iterating. Every command takes a sort key, and
+// playback runs commands in key order, in recording order for equal keys.
+// Keys that identify the unit of work (a chunk index, an entity index) make
+// playback independent of how work was spread over threads.
+//
+// Created entities get real IDs up front from World::reserveEntity, so
+// commands, components and other systems can refer to them before
+// playback; they are only alive afterwards. A create followed directly by
+// adds for the same entity and key lands straight in its final archetype.
+//
+// One buffer belongs to one thread at a time; see ThreadCommandBuffers.
+class CommandBuffer {
+public:
+    explicit CommandBuffer(World& world);
+    ~CommandBuffer();
+    
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+    
+    Entity createEntity(uint64_t sortKey);
+    void destroyEntity(uint64_t sortKey, Entity entity);
+    template<typename T>
+    void addComponent(uint64_t sortKey, Entity entity, const T& value = T()) {
+        recordAdd(sortKey, entity, componentID<T>(), &value, sizeof(T));
+    }
+    template<typename T>
+    void removeComponent(uint64_t sortKey, Entity entity) {
+        removeComponent(sortKey, entity, componentID<T>());
+    }
+    
+    // Untyped forms; value is copied bytewise
+    void addComponent(uint64_t sortKey, Entity entity, ComponentID id, const void* value);
+    void removeComponent(uint64_t sortKey, Entity entity, ComponentID id);
+    
+    // Applies and empties the buffer; main thread, outside queries
+    CommandPlaybackStats playback();
+    
+    // Drops recorded commands and releases the IDs they reserved
+    void clear();
+    
+    bool isEmpty() const { return m_commands.empty(); }
+    size_t getCommandCount() const { return m_commands.size(); }
+
+private:
+    friend class ThreadCommandBuffers;
+    
+    enum class CommandType : uint8_t {
+        CREATE,
+        DESTROY,
+        ADD,
+        REMOVE
+    };
+    
+    struct Command {
+        uint64_t sortKey;
+        Entity entity;
+        ComponentID component;
+        uint32_t dataOffset;    // Value of an ADD within m_data
+        uint32_t dataSize;
+        CommandType type;
+    };
+    
+    // Position of a command across the buffers being played back
+    struct CommandRef {
+        uint64_t sortKey;
+        uint32_t buffer;
+        uint32_t index;
+    };
+    
+    World* m_world;
+    std::vector<Command> m_commands;
+    std::vector<unsigned char> m_data;
+    
+    void recordAdd(uint64_t sortKey, Entity entity, ComponentID id, const void* value, size_t size);
+    static CommandPlaybackStats execute(World& world, CommandBuffer* const* buffers, size_t bufferCount);
+};
+
+// One CommandBuffer per job system thread. Jobs record into local(), which
+// needs no locking; playback merges every buffer by sort key at a sync point
+// chosen by the caller.
+//
+// Sized for the job system's threads by initialize and again at every
+// playback, so call initialize after JobSystem::initialize.
+class ThreadCommandBuffers {
+public:
+    ThreadCommandBuffers();
+    ~ThreadCommandBuffers();
+    
+    ThreadCommandBuffers(const ThreadCommandBuffers&) = delete;
+    ThreadCommandBuffers& operator=(const ThreadCommandBuffers&) = delete;
+    
+    void initialize(World& world);
+    
+    // The calling thread's buffer
+    CommandBuffer& local();
+    
+    CommandPlaybackStats playback();
+    void clear();
+    size_t getCommandCount() const;
+
+private:
+    World* m_world;
+    std::vector<std::unique_ptr<CommandBuffer>> m_buffers;
+    
+    void resize();
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "types.h"
+#include <string>
+#include <deque>
+#include <mutex>
+#include <typeinfo>
+#include <type_traits>
+#include <cstdint>
+
+namespace GameEngine2D {
+
+// Component sets are 64-bit masks, one bit per registered component type
+constexpr size_t MAX_COMPONENT_TYPES = 64;
+constexpr ComponentID INVALID_COMPONENT = 0xffffffffu;
+using ComponentMask = uint64_t;
+
+constexpr size_t MAX_COMPONENT_ALIGNMENT = 64;
+
+struct ComponentInfo {
+    ComponentID id = INVALID_COMPONENT;
+    std::string name;
+    size_t size = 0;
+    size_t alignment = 0;
+};
+
+// Process-wide table of component types. Types are registered on first use
+// and get dense IDs in registration order; registerComponent gives a type a
+// stable name, which serialized data refers to instead of the ID.
+//
+// Components are plain data: chunks move rows with memcpy and never run
+// constructors or destructors, so every component must be trivially copyable.
+class ComponentRegistry {
+public:
+    static ComponentRegistry& getInstance();
+    
+    template<typename T>
+    ComponentID getID() {
+        static_assert(std::is_trivially_copyable<T>::value, "Components must be trivially copyable");
+        static_assert(alignof(T) <= MAX_COMPONENT_ALIGNMENT, "Component alignment exceeds chunk alignment");
+        static const ComponentID id = registerType(typeid(T).name(), sizeof(T), alignof(T));
+        return id;
+    }
+    
+    template<typename T>
+    ComponentID registerComponent(const std::string& name) {
+        ComponentID id = getID<T>();
+        setName(id, name);
+        return id;
+    }
+    
+    const ComponentInfo& getInfo(ComponentID id) const;
+    ComponentID findByName(const std::string& name) const;
+    size_t getCount() const;
+
+private:
+    ComponentRegistry() = default;
+    ~ComponentRegistry() = default;
+    ComponentRegistry(const ComponentRegistry&) = delete;
+    ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+    
+    mutable std::mutex m_mutex;
+    std::deque<ComponentInfo> m_components;  // Deque keeps getInfo references stable
+    
+    ComponentID registerType(const char* name, size_t size, size_t alignment);
+    void setName(ComponentID id, const std::string& name);
+};
+
+template<typename T>
+ComponentID componentID() {
+    return ComponentRegistry::getInstance().getID<std::remove_cv_t<T>>();
+}
+
+template<typename T>
+ComponentMask componentBit() {
+    return ComponentMask(1) << componentID<T>();
+}
+
+} // namespace GameEngine2D
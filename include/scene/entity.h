@@ -0,0 +1,42 @@
+#pragma once
+
+#include "types.h"
+#include <cstdint>
+#include <functional>
+
+namespace GameEngine2D {
+
+// Generational entity handle. The index addresses the world's entity table
+// and the generation is bumped every time that slot is freed, so a handle to
+// a destroyed entity stops resolving instead of aliasing whoever reuses it.
+struct Entity {
+    static constexpr uint32_t INVALID_INDEX = 0xffffffffu;
+    
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+    
+    Entity() = default;
+    Entity(uint32_t entityIndex, uint32_t entityGeneration) : index(entityIndex), generation(entityGeneration) {}
+    
+    bool isNull() const { return index == INVALID_INDEX; }
+    
+    // Packed form for hashing and serialization
+    uint64_t toBits() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+    static Entity fromBits(uint64_t bits) {
+        return Entity(static_cast<uint32_t>(bits), static_cast<uint32_t>(bits >> 32));
+    }
+    
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+} // namespace GameEngine2D
+
+namespace std {
+template<>
+struct hash<GameEngine2D::Entity> {
+    size_t operator()(const GameEngine2D::Entity& entity) const {
+        return hash<uint64_t>()(entity.toBits());
+    }
+};
+} // namespace std
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "scene/world.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace GameEngine2D {
+
+// Run of freshly spawned rows sharing one chunk. Column pointers address the
+// first row of the run; entry i is the (firstIndex + i)-th entity of the batch.
+class SpawnRange {
+public:
+    SpawnRange(Archetype& archetype, ArchetypeChunk& chunk, uint32_t firstRow, uint32_t count, uint32_t firstIndex)
+        : m_archetype(&archetype), m_chunk(&chunk), m_firstRow(firstRow), m_count(count), m_firstIndex(firstIndex) {
+    }
+    
+    uint32_t getCount() const { return m_count; }
+    uint32_t getFirstIndex() const { return m_firstIndex; }
+    const Entity* getEntities() const { return m_archetype->getEntities(*m_chunk) + m_firstRow; }
+    
+    // Null when the prefab has no T
+    template<typename T>
+    T* get() const {
+        int column = m_archetype->getColumn(componentID<T>());
+        return column < 0 ? nullptr : static_cast<T*>(m_archetype->getColumnData(*m_chunk, column)) + m_firstRow;
+    }
+
+private:
+    Archetype* m_archetype;
+    ArchetypeChunk* m_chunk;
+    uint32_t m_firstRow;
+    uint32_t m_count;
+    uint32_t m_firstIndex;
+};
+
+// Called once per chunk run after the prefab's values are copied in, to
+// apply per-entity overrides column by column. Must not make structural
+// changes to the world; the rest of the batch is still being filled in.
+using SpawnInitializer = std::function<void(const SpawnRange&)>;
+
+// Component template for entities spawned in bulk. The prefab's component
+// set picks the archetype once per batch, and a chunk image pre-filled with
+// its values (the stamp) lets every chunk run of a batch be initialized with
+// a single memcpy per column instead of a component write per entity.
+//
+//     Prefab bullet;
+//     bullet.set(Position{}).set(Velocity{ Vector2(0.0f, 400.0f) }).set(Lifetime{ 2.0f });
+//     bullet.instantiate(world, 10000, [&](const SpawnRange& range) {
+//         Position* positions = range.get<Position>();
+//         for (uint32_t i = 0; i < range.getCount(); ++i) { positions[i].value = muzzle; }
+//     });
+//
+// Not thread-safe: the stamp is rebuilt lazily after the prefab changes.
+class Prefab {
+public:
+    Prefab();
+    ~Prefab();
+    
+    Prefab(Prefab&&) = default;
+    Prefab& operator=(Prefab&&) = default;
+    Prefab(const Prefab&) = delete;
+    Prefab& operator=(const Prefab&) = delete;
+    
+    // Adds the component or replaces its value
+    template<typename T>
+    Prefab& set(const T& value) {
+        set(componentID<T>(), &value);
+        return *this;
+    }
+    template<typename T>
+    bool remove() {
+        return remove(componentID<T>());
+    }
+    template<typename T>
+    const T* get() const {
+        return static_cast<const T*>(get(componentID<T>()));
+    }
+    
+    // Untyped forms; value is copied bytewise
+    void set(ComponentID id, const void* value);
+    bool remove(ComponentID id);
+    const void* get(ComponentID id) const;
+    ComponentMask getMask() const { return m_mask; }
+    
+    // Creates count entities with the prefab's components, then hands each
+    // chunk run to initializer. Returns the number created.
+    uint32_t instantiate(World& world, uint32_t count, const SpawnInitializer& initializer = nullptr) const;
+
+private:
+    // Over-aligned storage so get() can hand out typed pointers
+    struct alignas(MAX_COMPONENT_ALIGNMENT) ValueBlock {
+        unsigned char bytes[MAX_COMPONENT_ALIGNMENT];
+    };
+    
+    struct Value {
+        ComponentID id;
+        std::vector<ValueBlock> data;
+    };
+    
+    ComponentMask m_mask;
+    std::vector<Value> m_values;
+    mutable std::unique_ptr<ArchetypeChunk> m_stamp;   // Null until first spawn and after every change
+    
+    const ArchetypeChunk& getStamp(const Archetype& archetype) const;
+};
+
+} // namespace GameEngine2D
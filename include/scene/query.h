@@ -0,0 +1,232 @@
+#pragma once
+
+#include "scene/world.h"
+#include "core/job_system.h"
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GameEngine2D {
+
+// Typed view over every entity that has at least the components Ts. The
+// matching archetypes are cached and topped up when the world creates new
+// ones, and iteration walks their chunks linearly, column by column.
+// Declare read-only components const: Query<Transform, const Velocity>.
+//
+//     Query<Transform, const Velocity> movers(world);
+//     movers.each([dt](Transform& transform, const Velocity& velocity) { ... });
+//
+// The parallel variants split the matching chunks across the JobSystem.
+// Their callbacks run concurrently and may only touch the entity they are
+// given; the declared reads and writes are checked against other parallel
+// queries when ECS_ACCESS_CHECKS is enabled.
+//
+// Every chunk a query visits has its non-const components marked changed.
+// filterChanged makes a query skip chunks whose listed components nothing
+// has written since its own previous run, so incremental systems cost what
+// changed rather than what exists:
+//
+//     Query<const TransformNode> moved(world);
+//     moved.filterChanged<TransformNode>();
+//     moved.eachWithEntity(...);     // Only chunks whose nodes were written
+template<typename... Ts>
+class Query {
+public:
+    static_assert(sizeof...(Ts) > 0, "Query needs at least one component");
+    
+    explicit Query(World& world)
+        : m_world(&world), m_ids{ componentID<Ts>()... },
+          m_mask((ComponentMask(0) | ... | componentBit<Ts>())),
+          m_writeMask((ComponentMask(0) | ... | (std::is_const<Ts>::value ? ComponentMask(0) : componentBit<Ts>()))),
+          m_archetypesSeen(0), m_lastRunVersion(0), m_hasRun(false) {
+    }
+    
+    // Visit only chunks where one of Cs changed since this query last ran.
+    // Granularity is the chunk: unchanged entities sharing a chunk with a
+    // changed one are visited too. The first run visits everything.
+    template<typename... Cs>
+    Query& filterChanged() {
+        m_changedIDs = { componentID<Cs>()... };
+        return *this;
+    }
+    
+    // func(Ts&...) for every matching entity
+    template<typename Func>
+    void each(Func&& func) {
+        eachChunk([&func](uint32_t count, const Entity*, Ts*... columns) {
+            for (uint32_t i = 0; i < count; ++i) {
+                func(columns[i]...);
+            }
+        });
+    }
+    
+    // func(Entity, Ts&...) for every matching entity
+    template<typename Func>
+    void eachWithEntity(Func&& func) {
+        eachChunk([&func](uint32_t count, const Entity* entities, Ts*... columns) {
+            for (uint32_t i = 0; i < count; ++i) {
+                func(entities[i], columns[i]...);
+            }
+        });
+    }
+    
+    // func(count, entities, Ts*...) once per chunk, for loops the compiler
+    // can vectorize over whole columns
+    template<typename Func>
+    void eachChunk(Func&& func) {
+        refresh();
+        uint32_t version = m_world->advanceChangeVersion();
+        for (const auto& match : m_matches) {
+            Archetype& archetype = *match.archetype;
+            for (size_t chunk = 0; chunk < archetype.getChunkCount(); ++chunk) {
+                if (isChunkChanged(archetype, chunk)) {
+                    markWritten(archetype, chunk, match, version);
+                    invoke(func, archetype, archetype.getChunk(chunk), match, std::index_sequence_for<Ts...>{});
+                }
+            }
+        }
+        finishRun(version);
+    }
+    
+    // func(Ts&...) for every matching entity, chunks spread over the workers
+    template<typename Func>
+    void parallelForEach(Func&& func) {
+        parallelForEachChunk([&func](uint32_t count, const Entity*, Ts*... columns) {
+            for (uint32_t i = 0; i < count; ++i) {
+                func(columns[i]...);
+            }
+        });
+    }
+    
+    // func(count, entities, Ts*...) once per chunk, chunks spread over the
+    // workers; the raw column pointers suit hand-written SIMD loops
+    template<typename Func>
+    void parallelForEachChunk(Func&& func) {
+        refresh();
+        uint32_t version = m_world->advanceChangeVersion();
+        m_chunkList.clear();
+        for (uint32_t match = 0; match < m_matches.size(); ++match) {
+            Archetype& archetype = *m_matches[match].archetype;
+            uint32_t chunkCount = static_cast<uint32_t>(archetype.getChunkCount());
+            for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+                if (isChunkChanged(archetype, chunk)) {
+                    m_chunkList.push_back({ match, chunk });
+                }
+            }
+        }
+        
+        // A few ranges per thread so uneven chunks still balance out
+        JobSystem& jobs = JobSystem::getInstance();
+        size_t threads = jobs.getWorkerCount() + 1;
+        size_t grainSize = std::max<size_t>(1, m_chunkList.size() / (threads * 4));
+        
+        ComponentMask reads = m_mask & ~m_writeMask;
+        m_world->beginAccess(reads, m_writeMask);
+        jobs.parallelFor(m_chunkList.size(), grainSize, [this, &func, version](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const Match& match = m_matches[m_chunkList[i].match];
+                Archetype& archetype = *match.archetype;
+                markWritten(archetype, m_chunkList[i].chunk, match, version);
+                invoke(func, archetype, archetype.getChunk(m_chunkList[i].chunk), match,
+                       std::index_sequence_for<Ts...>{});
+            }
+        });
+        m_world->endAccess(reads, m_writeMask);
+        finishRun(version);
+    }
+    
+    size_t count() {
+        refresh();
+        size_t total = 0;
+        for (const auto& match : m_matches) {
+            total += match.archetype->getEntityCount();
+        }
+        return total;
+    }
+    
+    ComponentMask getMask() const { return m_mask; }
+    ComponentMask getWriteMask() const { return m_writeMask; }
+
+private:
+    struct Match {
+        Archetype* archetype;
+        std::array<int, sizeof...(Ts)> columns;
+    };
+    
+    struct ChunkRef {
+        uint32_t match;
+        uint32_t chunk;
+    };
+    
+    World* m_world;
+    std::array<ComponentID, sizeof...(Ts)> m_ids;
+    ComponentMask m_mask;
+    ComponentMask m_writeMask;
+    std::vector<Match> m_matches;
+    std::vector<ChunkRef> m_chunkList;
+    size_t m_archetypesSeen;
+    std::vector<ComponentID> m_changedIDs;
+    uint32_t m_lastRunVersion;
+    bool m_hasRun;
+    
+    static constexpr std::array<bool, sizeof...(Ts)> s_writes = { !std::is_const<Ts>::value... };
+    
+    void refresh() {
+        for (; m_archetypesSeen < m_world->getArchetypeCount(); ++m_archetypesSeen) {
+            Archetype& archetype = m_world->getArchetype(m_archetypesSeen);
+            if ((archetype.getMask() & m_mask) != m_mask) {
+                continue;
+            }
+            
+            Match match;
+            match.archetype = &archetype;
+            for (size_t i = 0; i < m_ids.size(); ++i) {
+                match.columns[i] = archetype.getColumn(m_ids[i]);
+            }
+            m_matches.push_back(match);
+        }
+    }
+    
+    bool isChunkChanged(const Archetype& archetype, size_t chunk) const {
+        if (m_changedIDs.empty() || !m_hasRun) {
+            return true;
+        }
+        for (ComponentID id : m_changedIDs) {
+            int column = archetype.getColumn(id);
+            if (column >= 0 && isVersionNewer(archetype.getChangeVersion(chunk, column), m_lastRunVersion)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Chunks are handed to one thread each, so their versions can be set
+    // without synchronization
+    static void markWritten(Archetype& archetype, size_t chunk, const Match& match, uint32_t version) {
+        for (size_t i = 0; i < sizeof...(Ts); ++i) {
+            if (s_writes[i]) {
+                archetype.markChanged(chunk, match.columns[i], version);
+            }
+        }
+    }
+    
+    // Writes made after the run get a later version than the one recorded,
+    // while the run's own writes don't count as changes next time
+    void finishRun(uint32_t version) {
+        m_lastRunVersion = version;
+        m_hasRun = true;
+        m_world->advanceChangeVersion();
+    }
+    
+    template<typename Func, size_t... Is>
+    static void invoke(Func& func, Archetype& archetype, ArchetypeChunk& chunk, const Match& match,
+                       std::index_sequence<Is...>) {
+        func(chunk.count, archetype.getEntities(chunk),
+             static_cast<Ts*>(archetype.getColumnData(chunk, match.columns[Is]))...);
+    }
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace GameEngine2D {
+
+// Binary scene file, version 1. All integers little-endian; offsets are
+// from the start of the file.
+//
+//     SceneFileHeader
+//     SceneFileComponent[componentCount]
+//     SceneFileArchetype[archetypeCount]
+//     SceneFileColumn[columnCount]
+//     chunk images, each archetype's run starting on a SCENE_CHUNK_ALIGNMENT boundary
+//
+// A chunk image is chunkSize bytes laid out exactly like ArchetypeChunk
+// data (entity column, then one column per component at the archetype's
+// column offsets), the uint32 row count right after it, and padding up to
+// chunkStride. Every chunk but an archetype's last is full, so readers take
+// row counts from the archetype table rather than the images. Entity
+// columns hold file-order indices; loaders replace them with live entities.
+//
+// Components are matched by registered name, so files survive reordered
+// registration; when a reader's layout matches the file byte for byte its
+// chunks can be used in place.
+
+constexpr char SCENE_FILE_MAGIC[8] = { 'G', 'E', '2', 'D', 'S', 'C', 'N', '\0' };
+constexpr uint32_t SCENE_FILE_VERSION = 1;
+constexpr size_t SCENE_COMPONENT_NAME_LENGTH = 48;
+constexpr size_t SCENE_CHUNK_ALIGNMENT = 4096;
+
+struct SceneFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t chunkSize;
+    uint32_t chunkStride;
+    uint32_t componentCount;
+    uint32_t archetypeCount;
+    uint32_t columnCount;
+    uint64_t entityCount;
+    uint64_t componentOffset;
+    uint64_t archetypeOffset;
+    uint64_t columnOffset;
+    uint64_t fileSize;
+};
+
+struct SceneFileComponent {
+    char name[SCENE_COMPONENT_NAME_LENGTH];     // Null-terminated
+    uint32_t size;
+    uint32_t alignment;
+};
+
+struct SceneFileArchetype {
+    uint32_t firstColumn;
+    uint32_t columnCount;
+    uint32_t chunkCapacity;
+    uint32_t chunkCount;
+    uint64_t entityCount;
+    uint64_t chunkOffset;
+};
+
+// Columns of an archetype are listed in chunk order
+struct SceneFileColumn {
+    uint32_t component;     // Index into the component table
+    uint32_t offset;        // Byte offset of the column within chunk data
+};
+
+static_assert(sizeof(SceneFileHeader) == 72, "Scene file header layout changed");
+static_assert(sizeof(SceneFileComponent) == 56, "Scene file component layout changed");
+static_assert(sizeof(SceneFileArchetype) == 32, "Scene file archetype layout changed");
+static_assert(sizeof(SceneFileColumn) == 8, "Scene file column layout changed");
+
+} // namespace GameEngine2D
@@ -1,9 +1,24 @@
 #pragma once
 
 #include "types.h"
+#include "scene/world.h"
+#include "scene/prefab.h"
+#include "scene/command_buffer.h"
+#include "scene/transform.h"
+#include "scene/world_streamer.h"
+#include <string>
 
 namespace GameEngine2D {
 
+// Cost of the most recent spawnBatch and running totals
+struct SpawnStats {
+    uint32_t lastCount = 0;
+    double lastMs = 0.0;
+    double lastNsPerEntity = 0.0;
+    uint64_t totalCount = 0;
+    double totalMs = 0.0;
+};
+
 class SceneManager {
 public:
     SceneManager();
@@ -15,6 +30,42 @@ public:
     void update(float deltaTime);
     void fixedUpdate(float fixedDeltaTime);
     void render();
+    
+    // Replaces the world's entities with those of a binary scene file
+    bool loadScene(const std::string& filepath);
+    
+    // Streams cells of a partitioned world in and out around the focus,
+    // which the game moves with its camera
+    void startStreaming(const StreamingSettings& settings);
+    void stopStreaming();
+    void setStreamingFocus(const Vector2& focus) { m_streamingFocus = focus; }
+    const WorldStreamer& getStreamer() const { return m_streamer; }
+    
+    // Entities and components of the active scene
+    World& getWorld() { return m_world; }
+    const World& getWorld() const { return m_world; }
+    
+    // Creates count entities from prefab in one pass; initializer applies
+    // per-entity overrides a chunk run at a time
+    uint32_t spawnBatch(const Prefab& prefab, uint32_t count, const SpawnInitializer& initializer = nullptr);
+    const SpawnStats& getSpawnStats() const { return m_spawnStats; }
+    
+    // Deferred structural changes from parallel systems. Played back at the
+    // start of every update; playbackCommands adds sync points mid-frame.
+    ThreadCommandBuffers& getCommandBuffers() { return m_commands; }
+    CommandPlaybackStats playbackCommands() { return m_commands.playback(); }
+    
+    // Parent/child transforms; entities refer to their node via TransformNode
+    TransformHierarchy& getTransforms() { return m_transforms; }
+    const TransformHierarchy& getTransforms() const { return m_transforms; }
+
+private:
+    World m_world;
+    TransformHierarchy m_transforms;
+    WorldStreamer m_streamer;
+    Vector2 m_streamingFocus;
+    SpawnStats m_spawnStats;
+    ThreadCommandBuffers m_commands;
 };
 
 } // namespace GameEngine2D
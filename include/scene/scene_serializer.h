@@ -0,0 +1,128 @@
+#pragma once
+
+#include "scene/world.h"
+#include "scene/scene_format.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+
+namespace GameEngine2D {
+
+class MappedFile;
+
+// Builds a binary scene file (see scene_format.h). Entities come from a
+// world, from the text format, or one at a time; they're packed into chunk
+// images with the same layout code the runtime archetypes use.
+//
+// Text format, one statement per line, '#' starts a comment:
+//     component Position float float
+//     component Team int
+//     entity Position 10 20 Team 1
+// Field types are float, int and uint; a component's fields are packed in
+// declaration order and must add up to the size of the registered type
+// with that name.
+class SceneWriter {
+public:
+    SceneWriter();
+    ~SceneWriter();
+    
+    // Index of the component in the file; adding a name twice returns the
+    // existing index, or INVALID_COMPONENT if the sizes disagree
+    uint32_t addComponent(const std::string& name, uint32_t size, uint32_t alignment);
+    
+    // values[i] points at the value of components[i]
+    bool addEntity(const std::vector<uint32_t>& components, const std::vector<const void*>& values);
+    
+    // One entity of a world, with all of its components
+    bool addEntity(World& world, Entity entity);
+    
+    // Every entity of the world, copied a chunk at a time
+    void addWorld(World& world);
+    
+    bool addText(const std::string& text, std::string& error);
+    
+    bool write(const std::string& filepath) const;
+    
+    uint64_t getEntityCount() const { return m_entityCount; }
+
+private:
+    struct PendingArchetype {
+        std::vector<uint32_t> components;   // Ascending file index, one per column
+        std::vector<ChunkColumnLayout> layout;
+        uint32_t capacity = 0;
+        uint64_t entityCount = 0;
+        std::vector<std::unique_ptr<ArchetypeChunk>> chunks;
+    };
+    
+    std::vector<SceneFileComponent> m_components;
+    std::vector<std::unique_ptr<PendingArchetype>> m_archetypes;
+    std::map<std::vector<uint32_t>, PendingArchetype*> m_archetypesByComponents;
+    uint64_t m_entityCount;
+    
+    PendingArchetype* findOrCreateArchetype(const std::vector<uint32_t>& components);
+    ArchetypeChunk& appendRow(PendingArchetype& archetype, uint32_t& index);
+};
+
+enum class SceneLoadMode {
+    ADOPT,  // Use file chunks in place where the layout matches, copy the rest
+    COPY    // Copy every chunk into world-owned memory
+};
+
+struct SceneLoadStats {
+    uint64_t entities = 0;
+    uint32_t chunksAdopted = 0;
+    uint32_t chunksCopied = 0;
+    size_t fileBytes = 0;
+};
+
+// Loads a binary scene file into a world through a memory mapping. The
+// whole file is validated before the world is touched. Adopted chunks stay
+// in the copy-on-write mapping, which the world keeps alive until it is
+// cleared; loading is then bounded by rewriting the entity columns.
+//
+// Loading can also run in two phases: open (and prefetch) only read the file
+// and may run on a worker thread, then mergeChunks moves a bounded number of
+// chunks into the world per call on the thread that owns it.
+class SceneLoader {
+public:
+    explicit SceneLoader(World& world);
+    ~SceneLoader();
+    
+    bool load(const std::string& filepath, SceneLoadMode mode = SceneLoadMode::ADOPT);
+    
+    bool open(const std::string& filepath, SceneLoadMode mode = SceneLoadMode::ADOPT);
+    
+    // Faults the mapped file in, so a merge doesn't wait on I/O
+    void prefetch() const;
+    
+    // Merges up to maxChunks more chunks; true once the whole file is in
+    bool mergeChunks(size_t maxChunks);
+    bool isMerging() const { return m_file != nullptr; }
+    size_t getMergedEntityCount() const { return m_nextEntity; }
+    
+    // Entities of the last load, in file order
+    const std::vector<Entity>& getEntities() const { return m_entities; }
+    const SceneLoadStats& getStats() const { return m_stats; }
+
+private:
+    World& m_world;
+    std::vector<Entity> m_entities;
+    SceneLoadStats m_stats;
+    
+    // Open file and merge position
+    std::shared_ptr<MappedFile> m_file;
+    std::string m_filepath;
+    SceneFileHeader m_header;
+    SceneLoadMode m_mode;
+    std::vector<ComponentID> m_componentIDs;
+    uint32_t m_archetypeCursor;
+    uint32_t m_chunkCursor;
+    size_t m_nextEntity;
+    Archetype* m_target;
+    bool m_adoptable;
+    
+    bool validate(const MappedFile& file, std::vector<ComponentID>& componentIDs) const;
+};
+
+} // namespace GameEngine2D
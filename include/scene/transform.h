@@ -0,0 +1,138 @@
+#pragma once
+
+#include "types.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace GameEngine2D {
+
+// 2D affine transform stored as the top two rows of a 3x3 matrix:
+//     x' = a * x + c * y + tx
+//     y' = b * x + d * y + ty
+struct Affine2 {
+    float a = 1.0f, b = 0.0f;
+    float c = 0.0f, d = 1.0f;
+    float tx = 0.0f, ty = 0.0f;
+    
+    static Affine2 fromTRS(const Vector2& position, float rotation, const Vector2& scale) {
+        float cosine = std::cos(rotation);
+        float sine = std::sin(rotation);
+        return { cosine * scale.x, sine * scale.x, -sine * scale.y, cosine * scale.y, position.x, position.y };
+    }
+    
+    // Applies other first, then this
+    Affine2 operator*(const Affine2& other) const {
+        return { a * other.a + c * other.b, b * other.a + d * other.b,
+                 a * other.c + c * other.d, b * other.c + d * other.d,
+                 a * other.tx + c * other.ty + tx, b * other.tx + d * other.ty + ty };
+    }
+    
+    Vector2 transformPoint(const Vector2& point) const {
+        return Vector2(a * point.x + c * point.y + tx, b * point.x + d * point.y + ty);
+    }
+    
+    Vector2 getPosition() const { return Vector2(tx, ty); }
+    
+    Matrix4 toMatrix4() const {
+        Matrix4 matrix(1.0f);
+        matrix[0][0] = a;
+        matrix[0][1] = b;
+        matrix[1][0] = c;
+        matrix[1][1] = d;
+        matrix[3][0] = tx;
+        matrix[3][1] = ty;
+        return matrix;
+    }
+};
+
+using TransformID = uint32_t;
+constexpr TransformID INVALID_TRANSFORM = 0xffffffffu;
+
+// ECS component linking an entity to its node in the scene's TransformHierarchy
+struct TransformNode {
+    TransformID id = INVALID_TRANSFORM;
+};
+
+struct TransformStats {
+    uint32_t nodes = 0;
+    uint32_t levels = 0;
+    uint32_t updated = 0;       // World transforms recomputed by the last update
+    bool rebuilt = false;       // The last update re-sorted the hierarchy
+};
+
+// Parent/child transforms kept in flat arrays sorted by depth, so every
+// parent precedes its children. update() recomputes world transforms in
+// one forward pass that starts at the first dirty node and only touches
+// nodes whose local transform or parent changed; when nothing is dirty it
+// returns immediately. Within one depth level nodes are independent, which
+// is what updateParallel splits across the job system.
+//
+// Node IDs are stable. Structural changes (create, setParent, destroy) are
+// cheap to record and cost one linear re-sort on the next update; a
+// destroyed node takes its whole subtree with it at that point. World
+// transforms read between a change and the next update are stale.
+class TransformHierarchy {
+public:
+    TransformHierarchy();
+    
+    TransformID create(TransformID parent = INVALID_TRANSFORM);
+    void destroy(TransformID id);
+    bool isAlive(TransformID id) const;
+    void clear();
+    
+    // Refuses parents that would create a cycle
+    bool setParent(TransformID id, TransformID parent);
+    TransformID getParent(TransformID id) const;
+    
+    void setLocal(TransformID id, const Affine2& local);
+    void setLocal(TransformID id, const Vector2& position, float rotation, const Vector2& scale) {
+        setLocal(id, Affine2::fromTRS(position, rotation, scale));
+    }
+    const Affine2& getLocal(TransformID id) const { return m_local[m_nodes[id].slot]; }
+    const Affine2& getWorld(TransformID id) const { return m_world[m_nodes[id].slot]; }
+    Matrix4 getWorldMatrix(TransformID id) const { return getWorld(id).toMatrix4(); }
+    
+    void update();
+    void updateParallel();
+    
+    const TransformStats& getStats() const { return m_stats; }
+
+private:
+    static constexpr uint32_t INVALID_SLOT = 0xffffffffu;
+    
+    enum class NodeState : uint8_t {
+        FREE,
+        ALIVE,
+        DESTROYED   // Freed with its subtree on the next re-sort
+    };
+    
+    struct Node {
+        TransformID parent = INVALID_TRANSFORM;
+        uint32_t slot = INVALID_SLOT;
+        NodeState state = NodeState::FREE;
+    };
+    
+    std::vector<Node> m_nodes;
+    std::vector<TransformID> m_freeIDs;
+    
+    // Depth-sorted, indexed by slot
+    std::vector<TransformID> m_slotIDs;
+    std::vector<uint32_t> m_slotParents;
+    std::vector<Affine2> m_local;
+    std::vector<Affine2> m_world;
+    std::vector<uint8_t> m_dirty;
+    
+    std::vector<uint32_t> m_levelStarts;    // First slot of each depth level, plus an end sentinel
+    uint32_t m_firstDirtySlot;
+    bool m_structureDirty;
+    TransformStats m_stats;
+    
+    bool prepareUpdate();
+    void finishUpdate(uint32_t updated);
+    uint32_t updateRange(uint32_t begin, uint32_t end);
+    void markDirty(uint32_t slot);
+    void rebuild();
+};
+
+} // namespace GameEngine2D
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "scene/archetype.h"
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// Debug builds check the access declared by parallel queries for conflicts
+#ifndef ECS_ACCESS_CHECKS
+#ifdef NDEBUG
+#define ECS_ACCESS_CHECKS 0
+#else
+#define ECS_ACCESS_CHECKS 1
+#endif
+#endif
+
+namespace GameEngine2D {
+
+enum class ComponentEventType : uint8_t {
+    ADDED,      // Component added, or its entity created with it
+    REMOVED     // Component removed, or its entity destroyed
+};
+
+struct ComponentEvent {
+    Entity entity;
+    ComponentID component;
+    ComponentEventType type;
+};
+
+// Entity storage grouped by archetype. Adding or removing a component moves
+// the entity's row to the archetype of its new component set, so component
+// access is a table lookup and queries walk dense chunks.
+//
+// Structural changes (create, destroy, add, remove) invalidate component
+// pointers and must not happen while a query is iterating.
+//
+// Writes are tracked per chunk and component with a change version that
+// advances every time a query runs, so incremental systems can skip chunks
+// nothing touched (see Query::filterChanged). getComponent and addComponent
+// count as writes; readComponent doesn't.
+class World {
+public:
+    World();
+    ~World();
+    
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+    
+    // Entity lifecycle
+    Entity createEntity();
+    template<typename... Ts>
+    Entity createEntity(const Ts&... components);
+    bool destroyEntity(Entity entity);
+    
+    // Hands out the ID of an entity that doesn't exist yet, so deferred
+    // commands can refer to it before playback. Safe from any thread while
+    // no structural change is running, parallel queries included. The entity
+    // isn't alive until createReservedEntity; releaseReservedEntity returns
+    // an unused ID, and clear reclaims any left over.
+    Entity reserveEntity();
+    bool createReservedEntity(Entity reserved, Archetype& archetype);
+    bool releaseReservedEntity(Entity reserved);
+    
+    // Sizes the entity table for count live entities ahead of bulk creation
+    void reserveEntities(size_t count);
+    
+    // Bulk creation for loaders and spawners: count entities in archetype,
+    // written to entities unless it is null, with uninitialized components.
+    // Returns the archetype row of the first; the rest follow it.
+    uint32_t createEntities(Archetype& archetype, uint32_t count, Entity* entities);
+    
+    // Appends a chunk whose component columns are already filled in; its
+    // entity column is overwritten with new entities, also written to
+    // entities unless it is null. Unowned chunks must stay valid until the
+    // world is cleared or destroyed (see keepAlive). Fails when the
+    // archetype's last chunk isn't full.
+    bool adoptChunk(Archetype& archetype, ArchetypeChunk* chunk, bool owned, Entity* entities);
+    
+    // Holds memory backing adopted chunks; released by clear and the destructor
+    void keepAlive(std::shared_ptr<void> owner) { m_keepAlive.push_back(std::move(owner)); }
+    bool isAlive(Entity entity) const;
+    void clear();
+    
+    // Components; pointers stay valid until the next structural change
+    template<typename T>
+    T* addComponent(Entity entity, const T& value = T()) {
+        return static_cast<T*>(addComponent(entity, componentID<T>(), &value));
+    }
+    template<typename T>
+    bool removeComponent(Entity entity) {
+        return removeComponent(entity, componentID<T>());
+    }
+    template<typename T>
+    T* getComponent(Entity entity) {
+        return static_cast<T*>(getComponent(entity, componentID<T>()));
+    }
+    template<typename T>
+    const T* readComponent(Entity entity) const {
+        return static_cast<const T*>(readComponent(entity, componentID<T>()));
+    }
+    template<typename T>
+    bool hasComponent(Entity entity) const {
+        return (getComponentMask(entity) & componentBit<T>()) != 0;
+    }
+    
+    // Untyped forms for serialization and tools; value is copied bytewise
+    void* addComponent(Entity entity, ComponentID id, const void* value);
+    bool removeComponent(Entity entity, ComponentID id);
+    void* getComponent(Entity entity, ComponentID id);
+    const void* readComponent(Entity entity, ComponentID id) const;
+    ComponentMask getComponentMask(Entity entity) const;
+    
+    // Version stamped on writes from now on. Queries advance it once before
+    // and once after each run, so a run never sees its own writes as changes.
+    uint32_t getChangeVersion() const { return m_changeVersion; }
+    uint32_t advanceChangeVersion() { return ++m_changeVersion; }
+    
+    // Added and removed events for the tracked components. Each reader keeps
+    // a cursor, starting from getComponentEventCursor; readComponentEvents
+    // calls func(const ComponentEvent&) for everything after it. Events stay
+    // readable until the second retireComponentEvents after they happen, so
+    // with one retire per frame every reader sees a full frame of them.
+    template<typename... Ts>
+    void trackComponentEvents() {
+        m_trackedEvents |= (ComponentMask(0) | ... | componentBit<Ts>());
+    }
+    void trackComponentEvents(ComponentMask mask) { m_trackedEvents |= mask; }
+    uint64_t getComponentEventCursor() const { return m_firstEventSequence + m_events.size(); }
+    template<typename Func>
+    void readComponentEvents(uint64_t& cursor, Func&& func) const;
+    void retireComponentEvents();
+    
+    // Archetypes are never destroyed, so queries can keep pointers to them
+    Archetype& findOrCreateArchetype(ComponentMask mask);
+    size_t getArchetypeCount() const { return m_archetypes.size(); }
+    Archetype& getArchetype(size_t index) { return *m_archetypes[index]; }
+    
+    // Component access held by running parallel queries. A write overlapping
+    // any other access to the same component is reported as a data race, as
+    // are structural changes and readComponent on a component being written.
+    // getComponent marks the component changed, so parallel callbacks must
+    // use readComponent for other entities; calling it is reported as well.
+    // No-ops unless ECS_ACCESS_CHECKS is enabled.
+    void beginAccess(ComponentMask reads, ComponentMask writes);
+    void endAccess(ComponentMask reads, ComponentMask writes);
+    
+    // Statistics
+    size_t getEntityCount() const { return m_entityCount; }
+
+private:
+    struct EntityRecord {
+        Archetype* archetype = nullptr;
+        uint32_t row = 0;
+        uint32_t generation = 0;
+    };
+    
+    std::vector<EntityRecord> m_records;
+    std::vector<uint32_t> m_freeIndices;
+    std::atomic<uint32_t> m_reservedCount;  // Taken from the back of m_freeIndices, then past m_records
+    std::vector<std::shared_ptr<void>> m_keepAlive;     // Declared first so it outlives the archetypes
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;
+    std::unordered_map<ComponentMask, Archetype*> m_archetypesByMask;
+    size_t m_entityCount;
+    uint32_t m_changeVersion;
+    
+    ComponentMask m_trackedEvents;
+    std::vector<ComponentEvent> m_events;
+    uint64_t m_firstEventSequence;      // Sequence number of m_events[0]
+    uint64_t m_retireSequence;          // Events before this go at the next retire
+    
+    std::array<std::atomic<int>, MAX_COMPONENT_TYPES> m_readers;
+    std::array<std::atomic<int>, MAX_COMPONENT_TYPES> m_writers;
+    std::atomic<int> m_activeAccess;
+    
+    void checkStructuralChange(const char* operation) const;
+    Entity allocateEntity(Archetype& archetype);
+    uint32_t allocateIndex();
+    void flushReservations();
+    EntityRecord* findRecord(Entity entity);
+    const EntityRecord* findRecord(Entity entity) const;
+    void removeRow(EntityRecord& record);
+    void moveEntity(Entity entity, EntityRecord& record, Archetype& target);
+    void writeComponent(Archetype& archetype, uint32_t row, ComponentID id, const void* value);
+    void markRowChanged(Archetype& archetype, uint32_t row) {
+        archetype.markChunkChanged(row / archetype.getChunkCapacity(), m_changeVersion);
+    }
+    
+    // Rows are always appended to the last chunk
+    void markAppendChanged(Archetype& archetype) {
+        archetype.markChunkChanged(archetype.getChunkCount() - 1, m_changeVersion);
+    }
+    
+    // Inline so untracked components cost a mask test
+    void recordEvents(Entity entity, ComponentMask mask, ComponentEventType type) {
+        if (mask & m_trackedEvents) {
+            appendEvents(entity, mask & m_trackedEvents, type);
+        }
+    }
+    void appendEvents(Entity entity, ComponentMask mask, ComponentEventType type);
+};
+
+template<typename... Ts>
+Entity World::createEntity(const Ts&... components) {
+    ComponentMask mask = (ComponentMask(0) | ... | componentBit<Ts>());
+    Archetype& archetype = findOrCreateArchetype(mask);
+    Entity entity = allocateEntity(archetype);
+    uint32_t row = m_records[entity.index].row;
+    (writeComponent(archetype, row, componentID<Ts>(), &components), ...);
+    return entity;
+}
+
+template<typename Func>
+void World::readComponentEvents(uint64_t& cursor, Func&& func) const {
+    // Readers that fell more than a frame behind skip what was retired
+    uint64_t end = m_firstEventSequence + m_events.size();
+    for (uint64_t sequence = std::max(cursor, m_firstEventSequence); sequence < end; ++sequence) {
+        func(m_events[static_cast<size_t>(sequence - m_firstEventSequence)]);
+    }
+    cursor = end;
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "scene/world.h"
+#include "scene/scene_serializer.h"
+#include "core/job_system.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GameEngine2D {
+
+struct StreamingSettings {
+    std::string directory;              // Holds one cell_<x>_<y>.scene file per non-empty cell
+    float cellSize = 512.0f;
+    float loadRadius = 1024.0f;         // Cells nearer than this to the focus are loaded...
+    float unloadRadius = 1536.0f;       // ...and stay until they are farther than this
+    double mergeBudgetMs = 2.0;         // Main-thread time per frame for merging and unloading
+    uint32_t maxConcurrentLoads = 4;
+};
+
+struct StreamingStats {
+    uint32_t residentCells = 0;
+    uint32_t loadingCells = 0;          // Being read on a worker
+    uint32_t pendingCells = 0;          // Read and waiting for, or partway through, a merge or unload
+    uint32_t emptyCells = 0;            // In range without a file
+    uint32_t failedCells = 0;           // In range with a file that could not be opened
+    uint32_t entitiesMerged = 0;        // During the last update
+    uint32_t entitiesUnloaded = 0;      // During the last update
+    double sliceMs = 0.0;               // Main-thread time of the last update
+};
+
+// Keeps the part of a large world around a focus point resident. The world
+// is cut into square cells, each its own scene file. Cells are read and
+// validated on job system workers and merged into the live world a few
+// chunks at a time within the per-frame budget; leaving cells are unloaded
+// the same way. The gap between the load and unload radius keeps cells on
+// the boundary from reloading every frame.
+//
+// Cells without a file are empty, which is normal for sparse maps. A file
+// that cannot be opened is logged once and not read again until the cell
+// has left the unload radius, so a broken file costs one read per visit.
+//
+// Cells are always copied into world-owned chunks rather than adopted, so
+// their mappings are dropped once merged and memory tracks only what is
+// resident. Entities belong to the cell they were loaded from and leave
+// with it, wherever they have moved.
+class WorldStreamer {
+public:
+    WorldStreamer();
+    ~WorldStreamer();
+    
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+    
+    void initialize(World& world, const StreamingSettings& settings);
+    
+    // Waits for outstanding reads and unloads every resident cell
+    void shutdown();
+    bool isEnabled() const { return m_world != nullptr; }
+    
+    // Call once per frame from the thread that owns the world
+    void update(const Vector2& focus);
+    
+    bool isCellResident(int x, int y) const;
+    const StreamingStats& getStats() const { return m_stats; }
+    const StreamingSettings& getSettings() const { return m_settings; }
+    
+    static std::string getCellPath(const std::string& directory, int x, int y);
+    
+    // Authoring side: splits a world into cell files by entity position.
+    // Returns the number of cells written.
+    static size_t writeCells(World& world, const std::string& directory, float cellSize,
+                             const std::function<Vector2(Entity)>& getPosition);
+
+private:
+    enum class CellState : uint8_t {
+        LOADING,    // Reading on a worker; only the worker touches the loader
+        READY,
+        EMPTY,      // No file; kept so it isn't looked for again while in range
+        FAILED,     // Unreadable or invalid file; likewise kept until out of range
+        MERGING,
+        RESIDENT,
+        UNLOADING
+    };
+    
+    struct Cell {
+        int x = 0;
+        int y = 0;
+        std::atomic<CellState> state{ CellState::LOADING };
+        bool reading = false;           // Holds one of the concurrent load slots
+        std::unique_ptr<SceneLoader> loader;
+        std::vector<Entity> entities;
+        size_t unloadCursor = 0;
+    };
+    
+    World* m_world;
+    StreamingSettings m_settings;
+    std::unordered_map<uint64_t, std::unique_ptr<Cell>> m_cells;
+    JobCounter m_jobs;
+    uint32_t m_activeLoads;
+    StreamingStats m_stats;
+    
+    static uint64_t getCellKey(int x, int y);
+    float getCellDistance(int x, int y, const Vector2& focus) const;
+    void requestCells(const Vector2& focus);
+    void releaseCells(const Vector2& focus);
+    void runTimeSlice(const Vector2& focus, double budgetMs);
+    void startLoad(int x, int y);
+    bool unloadSome(Cell& cell, size_t maxEntities);
+};
+
+} // namespace GameEngine2D
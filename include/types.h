@@ -131,7 +131,8 @@ enum class BlendMode {
     ALPHA = 1,
     ADDITIVE = 2,
     MULTIPLY = 3,
-    SCREEN = 4
+    SCREEN = 4,
+    PREMULTIPLIED = 5   // Source color already multiplied by its alpha
 };
 
 enum class FilterMode {
@@ -150,6 +151,14 @@ enum class WrapMode {
     CLAMP_TO_BORDER = 3
 };
 
+enum class TextureFormat {
+    R8 = 0,
+    RG8 = 1,
+    RGBA8 = 2,
+    RGBA16F = 3,
+    RGBA32F = 4
+};
+
 struct TextureConfig {
     FilterMode minFilter = FilterMode::LINEAR;
     FilterMode magFilter = FilterMode::LINEAR;
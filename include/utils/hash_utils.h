@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace GameEngine2D {
+
+// FNV-1a hashing; constexpr so names can be hashed at compile time
+class HashUtils {
+public:
+    static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+    static constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+    
+    static constexpr uint64_t fnv1a(const char* str, size_t length, uint64_t seed = FNV_OFFSET_BASIS) {
+        uint64_t hash = seed;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= static_cast<uint8_t>(str[i]);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+    
+    static constexpr uint64_t fnv1a(const char* str) {
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for (; *str != '\0'; ++str) {
+            hash ^= static_cast<uint8_t>(*str);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+    
+    static uint64_t fnv1a(const std::string& str, uint64_t seed = FNV_OFFSET_BASIS) {
+        return fnv1a(str.data(), str.size(), seed);
+    }
+    
+    static uint64_t fnv1a(const void* data, size_t bytes, uint64_t seed = FNV_OFFSET_BASIS) {
+        return fnv1a(static_cast<const char*>(data), bytes, seed);
+    }
+};
+
+} // namespace GameEngine2D
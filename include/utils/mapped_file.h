@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace GameEngine2D {
+
+// Read-only view of a whole file through the OS page cache. The copy-on-write
+// mode maps it privately writable: pages are shared with the cache until
+// written, and writes never reach the file.
+class MappedFile {
+public:
+    enum class Mode {
+        READ_ONLY,
+        COPY_ON_WRITE
+    };
+    
+    MappedFile();
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool open(const std::string& filepath, Mode mode = Mode::READ_ONLY);
+    void close();
+    
+    // Touches every page so later accesses don't block on disk
+    void prefetch() const;
+    
+    bool isOpen() const { return m_data != nullptr; }
+    unsigned char* getData() const { return m_data; }
+    size_t getSize() const { return m_size; }
+    Mode getMode() const { return m_mode; }
+
+private:
+    unsigned char* m_data;
+    size_t m_size;
+    Mode m_mode;
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#endif
+};
+
+} // namespace GameEngine2D
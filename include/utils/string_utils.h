@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 
 namespace GameEngine2D {
 
@@ -51,6 +52,7 @@ public:
     // String encoding
     static std::string escape(const std::string& str);
     static std::string unescape(const std::string& str);
+    static std::vector<uint32_t> decodeUTF8(const std::string& str);
 };
 
 } // namespace GameEngine2D
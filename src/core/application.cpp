@@ -1,4 +1,5 @@
 #include "core/application.h"
+#include "core/job_system.h"
 #include "utils/logger.h"
 #include <GL/glew.h>
 #include <algorithm>
@@ -173,6 +174,10 @@ void Application::initializeSystems() {
         LOG_ERROR("Failed to initialize renderer");
         throw std::runtime_error("Renderer initialization failed");
     }
+    m_renderer->setOutputSize(m_window->getWidth(), m_window->getHeight());
+    
+    // Worker threads for parallel scene queries
+    JobSystem::getInstance().initialize();
     
     // Initialize scene manager
     if (!m_sceneManager->initialize()) {
@@ -208,6 +213,8 @@ void Application::shutdownSystems() {
         m_sceneManager->shutdown();
     }
     
+    JobSystem::getInstance().shutdown();
+    
     if (m_renderer) {
         m_renderer->shutdown();
     }
@@ -249,9 +256,13 @@ void Application::fixedUpdate(float fixedDeltaTime) {
 }
 
 void Application::render() {
+    m_renderer->beginFrame();
+    
     // Clear screen
     m_renderer->clear();
     
+    m_renderer->beginPass("scene");
+    
     // Render current scene
     m_sceneManager->render();
     
@@ -260,8 +271,12 @@ void Application::render() {
         m_renderCallback();
     }
     
+    m_renderer->endPass();
+    
     // Present frame
     m_renderer->present();
+    
+    m_renderer->endFrame();
 }
 
 void Application::updateStatistics(float deltaTime) {
@@ -282,7 +297,7 @@ void Application::updateStatistics(float deltaTime) {
 
 void Application::onWindowResize(int width, int height) {
     if (m_renderer) {
-        m_renderer->setViewport(0, 0, width, height);
+        m_renderer->setOutputSize(width, height);
     }
     
     LOG_DEBUG_FMT("Window resized to {}x{}", width, height);
@@ -0,0 +1,149 @@
+#include "core/job_system.h"
+#include "utils/logger.h"
+#include <algorithm>
+
+namespace GameEngine2D {
+
+namespace {
+
+thread_local unsigned int t_threadIndex = 0;
+
+} // namespace
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem() : m_stopping(false) {
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+bool JobSystem::initialize(unsigned int workerCount) {
+    if (isInitialized()) {
+        return true;
+    }
+    
+    if (workerCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+    
+    m_stopping = false;
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+    
+    LOG_INFO_FMT("JobSystem initialized with {} worker threads", workerCount);
+    return true;
+}
+
+void JobSystem::shutdown() {
+    if (!isInitialized()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    
+    // Anything still queued runs here so no counter is left waiting
+    while (tryRunJob()) {
+    }
+    LOG_INFO("JobSystem shutdown");
+}
+
+void JobSystem::submit(std::function<void()> job, JobCounter* counter) {
+    if (counter) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    Job entry{ std::move(job), counter };
+    if (!isInitialized()) {
+        runJob(entry);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(entry));
+    }
+    m_condition.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!tryRunJob()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func) {
+    if (count == 0) {
+        return;
+    }
+    grainSize = std::max<size_t>(grainSize, 1);
+    
+    // The caller takes the first range itself instead of idling in wait
+    JobCounter counter;
+    for (size_t begin = grainSize; begin < count; begin += grainSize) {
+        size_t end = std::min(begin + grainSize, count);
+        submit([&func, begin, end]() { func(begin, end); }, &counter);
+    }
+    func(0, std::min(grainSize, count));
+    wait(counter);
+}
+
+unsigned int JobSystem::getThreadIndex() {
+    return t_threadIndex;
+}
+
+void JobSystem::workerLoop(unsigned int threadIndex) {
+    t_threadIndex = threadIndex;
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        runJob(job);
+    }
+}
+
+bool JobSystem::tryRunJob() {
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.empty()) {
+            return false;
+        }
+        job = std::move(m_queue.front());
+        m_queue.pop_front();
+    }
+    runJob(job);
+    return true;
+}
+
+void JobSystem::runJob(Job& job) {
+    job.function();
+    if (job.counter) {
+        job.counter->m_pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,269 @@
+#include "graphics/batch_renderer.h"
+#include "graphics/renderer.h"
+#include "graphics/shader.h"
+#include "utils/logger.h"
+#include <algorithm>
+
+namespace GameEngine2D {
+
+namespace {
+constexpr size_t MAX_BATCH_QUADS = 16384; // 16-bit vertex indices
+
+const UniformHandle U_MODEL("uModel");
+const UniformHandle U_VIEW("uView");
+const UniformHandle U_PROJECTION("uProjection");
+const UniformHandle U_TEXTURE("uTexture");
+}
+
+BatchRenderer::BatchRenderer(size_t maxQuads)
+    : m_maxQuads(std::clamp<size_t>(maxQuads, 1, MAX_BATCH_QUADS)), m_backend(nullptr), m_vao(0), m_vbo(0), m_ibo(0),
+      m_currentTexture(0), m_appliedShader(nullptr), m_renderer(nullptr),
+      m_view(1.0f), m_projection(1.0f) {
+}
+
+BatchRenderer::~BatchRenderer() {
+    shutdown();
+}
+
+bool BatchRenderer::initialize(Renderer& renderer) {
+    if (m_vao != 0) {
+        return true;
+    }
+    m_backend = &renderer.getBackend();
+    
+    std::vector<uint16_t> indices(m_maxQuads * 6);
+    for (size_t i = 0; i < m_maxQuads; ++i) {
+        uint16_t base = static_cast<uint16_t>(i * 4);
+        indices[i * 6 + 0] = base;
+        indices[i * 6 + 1] = base + 1;
+        indices[i * 6 + 2] = base + 2;
+        indices[i * 6 + 3] = base + 2;
+        indices[i * 6 + 4] = base + 3;
+        indices[i * 6 + 5] = base;
+    }
+    
+    m_vbo = m_backend->createBuffer();
+    m_backend->uploadBuffer(m_vbo, nullptr, m_maxQuads * 4 * sizeof(PackedVertex), true);
+    
+    m_ibo = m_backend->createBuffer();
+    m_backend->uploadBuffer(m_ibo, indices.data(), indices.size() * sizeof(uint16_t), false);
+    
+    m_vao = m_backend->createVertexArray(PackedVertex::getLayout(), m_vbo, m_ibo);
+    
+    m_vertices.reserve(m_maxQuads * 4);
+    
+    LOG_INFO_FMT("BatchRenderer initialized with capacity for {} quads", m_maxQuads);
+    return true;
+}
+
+void BatchRenderer::shutdown() {
+    if (m_vao == 0) {
+        return;
+    }
+    
+    m_backend->destroyVertexArray(m_vao);
+    m_backend->destroyBuffer(m_vbo);
+    m_backend->destroyBuffer(m_ibo);
+    m_vao = m_vbo = m_ibo = 0;
+    m_backend = nullptr;
+    m_vertices.clear();
+}
+
+void BatchRenderer::begin(Renderer& renderer, std::shared_ptr<Shader> shader,
+                          const Matrix4& view, const Matrix4& projection) {
+    if (m_renderer) {
+        LOG_WARNING("BatchRenderer::begin called twice without end");
+        flush();
+    }
+    
+    m_renderer = &renderer;
+    if (shader != m_shader) {
+        m_shader = shader;
+        resolveVariants();
+    }
+    m_view = view;
+    m_projection = projection;
+    renderer.setCamera(view, projection);
+    m_appliedShader = nullptr;
+    m_currentTexture = 0;
+    m_vertices.clear();
+    m_stats = BatchStats{};
+}
+
+void BatchRenderer::end() {
+    if (!m_renderer) {
+        LOG_WARNING("BatchRenderer::end called without begin");
+        return;
+    }
+    
+    flush();
+    m_renderer = nullptr;
+}
+
+void BatchRenderer::setShader(std::shared_ptr<Shader> shader) {
+    if (shader == m_shader) {
+        return;
+    }
+    
+    flush();
+    m_shader = shader;
+    resolveVariants();
+    m_appliedShader = nullptr;
+    m_stats.shaderSwitches++;
+}
+
+void BatchRenderer::drawQuad(const Vector2& position, const Vector2& size, const Color& color, float depth) {
+    drawQuad(position, size, 0, Vector4(0.0f, 0.0f, 1.0f, 1.0f), color, depth);
+}
+
+void BatchRenderer::drawQuad(const Vector2& position, const Vector2& size, TextureID texture,
+                             const Vector4& uvRect, const Color& color, float depth) {
+    if (!prepareQuad(texture)) {
+        return;
+    }
+    
+    float x0 = position.x;
+    float y0 = position.y;
+    float x1 = position.x + size.x;
+    float y1 = position.y + size.y;
+    
+    // Pack the shared attributes once and only vary position and UVs
+    PackedVertex vertex = VertexPacking::pack(Vector3(x0, y0, depth), Vector2(uvRect.x, uvRect.y), color);
+    uint16_t u0 = vertex.texCoord[0];
+    uint16_t u1 = VertexPacking::packUnorm16(uvRect.z);
+    uint16_t v1 = VertexPacking::packUnorm16(uvRect.w);
+    
+    m_vertices.push_back(vertex);
+    vertex.position.x = x1;
+    vertex.texCoord[0] = u1;
+    m_vertices.push_back(vertex);
+    vertex.position.y = y1;
+    vertex.texCoord[1] = v1;
+    m_vertices.push_back(vertex);
+    vertex.position.x = x0;
+    vertex.texCoord[0] = u0;
+    m_vertices.push_back(vertex);
+    m_stats.quads++;
+}
+
+void BatchRenderer::drawQuad(const BatchVertex* vertices, TextureID texture) {
+    if (!prepareQuad(texture)) {
+        return;
+    }
+    for (int i = 0; i < 4; ++i) {
+        m_vertices.push_back(VertexPacking::pack(vertices[i].position, vertices[i].texCoord, vertices[i].color));
+    }
+    m_stats.quads++;
+}
+
+void BatchRenderer::drawQuad(const PackedVertex* vertices, TextureID texture) {
+    if (!prepareQuad(texture)) {
+        return;
+    }
+    m_vertices.insert(m_vertices.end(), vertices, vertices + 4);
+    m_stats.quads++;
+}
+
+void BatchRenderer::drawQuads(const PackedVertex* vertices, size_t quadCount, TextureID texture) {
+    while (quadCount > 0) {
+        if (!prepareQuad(texture)) {
+            return;
+        }
+        
+        // prepareQuad leaves room for at least one quad
+        size_t count = std::min(quadCount, m_maxQuads - m_vertices.size() / 4);
+        m_vertices.insert(m_vertices.end(), vertices, vertices + count * 4);
+        m_stats.quads += static_cast<uint32_t>(count);
+        vertices += count * 4;
+        quadCount -= count;
+    }
+}
+
+void BatchRenderer::flush() {
+    if (m_vertices.empty() || !m_renderer) {
+        return;
+    }
+    
+    Shader* shader = (m_currentTexture != 0 ? m_texturedShader : m_colorShader).get();
+    if (m_vao == 0 || !shader || !m_backend->bindShader(shader)) {
+        // A shader still compiling asynchronously just skips its quads
+        if (!shader || !shader->isPending()) {
+            LOG_WARNING("BatchRenderer flushed without a valid shader, dropping quads");
+        }
+        m_vertices.clear();
+        return;
+    }
+    
+    applyShader(*shader);
+    
+    if (m_currentTexture != 0) {
+        m_backend->bindTexture(0, m_currentTexture);
+        m_renderer->recordTextureBind();
+    }
+    
+    // Streaming orphans the buffer so the driver doesn't wait on the previous batch
+    size_t bytes = m_vertices.size() * sizeof(PackedVertex);
+    m_backend->streamBuffer(m_vbo, m_maxQuads * 4 * sizeof(PackedVertex), m_vertices.data(), bytes);
+    m_renderer->recordBufferUpload(bytes);
+    
+    uint32_t quadCount = static_cast<uint32_t>(m_vertices.size() / 4);
+    m_backend->drawIndexed(m_vao, quadCount * 6, 0);
+    
+    m_renderer->recordDrawCall(static_cast<uint32_t>(m_vertices.size()));
+    m_stats.flushes++;
+    m_vertices.clear();
+}
+
+bool BatchRenderer::prepareQuad(TextureID texture) {
+    if (!m_renderer) {
+        LOG_WARNING("BatchRenderer::drawQuad called outside begin/end");
+        return false;
+    }
+    
+    if (texture != m_currentTexture) {
+        flush();
+        m_currentTexture = texture;
+        m_stats.textureSwitches++;
+    } else if (m_vertices.size() + 4 > m_maxQuads * 4) {
+        flush();
+    }
+    return true;
+}
+
+void BatchRenderer::resolveVariants() {
+    // Shader families are specialized on USE_TEXTURE, so textured and
+    // untextured batches bind different programs; other shaders get both
+    m_texturedShader = m_shader;
+    m_colorShader = m_shader;
+    if (!m_shader || m_shader->getVariantFamily().empty()) {
+        return;
+    }
+    
+    ShaderManager& manager = ShaderManager::getInstance();
+    if (auto textured = manager.getRelatedVariant(*m_shader, "USE_TEXTURE", true)) {
+        m_texturedShader = textured;
+    }
+    if (auto color = manager.getRelatedVariant(*m_shader, "USE_TEXTURE", false)) {
+        m_colorShader = color;
+    }
+}
+
+void BatchRenderer::applyShader(Shader& shader) {
+    // Per-batch uniforms only need to be set when the bound program changes
+    if (&shader == m_appliedShader) {
+        return;
+    }
+    
+    m_backend->setUniform(shader, U_MODEL, Matrix4(1.0f));
+    if (!shader.usesUniformBlock(UniformBlockBinding::CAMERA)) {
+        m_backend->setUniform(shader, U_VIEW, m_view);
+        m_backend->setUniform(shader, U_PROJECTION, m_projection);
+    }
+    if (&shader == m_texturedShader.get()) {
+        m_backend->setUniform(shader, U_TEXTURE, 0);
+    }
+    m_appliedShader = &shader;
+    m_renderer->recordStateChange();
+}
+
+} // namespace GameEngine2D
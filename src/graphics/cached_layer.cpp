@@ -0,0 +1,320 @@
+#include "graphics/cached_layer.h"
+#include "graphics/renderer.h"
+#include "graphics/batch_renderer.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GameEngine2D {
+
+namespace {
+
+Rectangle spriteRect(const LayerSprite& sprite) {
+    return Rectangle(sprite.position.x, sprite.position.y, sprite.size.x, sprite.size.y);
+}
+
+Rectangle unite(const Rectangle& a, const Rectangle& b) {
+    float x0 = std::min(a.x, b.x);
+    float y0 = std::min(a.y, b.y);
+    float x1 = std::max(a.x + a.width, b.x + b.width);
+    float y1 = std::max(a.y + a.height, b.y + b.height);
+    return Rectangle(x0, y0, x1 - x0, y1 - y0);
+}
+
+bool sameRect(const Rectangle& a, const Rectangle& b) {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+} // namespace
+
+CachedLayer::CachedLayer(const CachedLayerConfig& config)
+    : m_config(config), m_spriteCount(0), m_depth(0.0f), m_boundsDirty(false), m_pixelsPerUnit(0.0f),
+      m_cacheFailed(false), m_fullRedraw(true), m_hasDirtyRegion(false) {
+}
+
+CachedLayer::~CachedLayer() {
+    releaseGPUResources();
+}
+
+LayerSpriteID CachedLayer::addSprite(const LayerSprite& sprite) {
+    Slot slot;
+    slot.sprite = sprite;
+    slot.alive = true;
+    m_slots.push_back(slot);
+    m_spriteCount++;
+    
+    m_boundsDirty = true;
+    markDirty(spriteRect(sprite));
+    return static_cast<LayerSpriteID>(m_slots.size());
+}
+
+bool CachedLayer::updateSprite(LayerSpriteID id, const LayerSprite& sprite) {
+    if (id == INVALID_LAYER_SPRITE || id > m_slots.size() || !m_slots[id - 1].alive) {
+        return false;
+    }
+    
+    // Both the old and the new footprint need redrawing
+    Slot& slot = m_slots[id - 1];
+    markDirty(unite(spriteRect(slot.sprite), spriteRect(sprite)));
+    slot.sprite = sprite;
+    m_boundsDirty = true;
+    return true;
+}
+
+bool CachedLayer::removeSprite(LayerSpriteID id) {
+    if (id == INVALID_LAYER_SPRITE || id > m_slots.size() || !m_slots[id - 1].alive) {
+        return false;
+    }
+    
+    Slot& slot = m_slots[id - 1];
+    markDirty(spriteRect(slot.sprite));
+    slot.alive = false;
+    m_spriteCount--;
+    m_boundsDirty = true;
+    return true;
+}
+
+const LayerSprite* CachedLayer::getSprite(LayerSpriteID id) const {
+    if (id == INVALID_LAYER_SPRITE || id > m_slots.size() || !m_slots[id - 1].alive) {
+        return nullptr;
+    }
+    return &m_slots[id - 1].sprite;
+}
+
+void CachedLayer::clear() {
+    m_slots.clear();
+    m_spriteCount = 0;
+    m_bounds = Rectangle();
+    m_boundsDirty = false;
+    markDirty();
+}
+
+void CachedLayer::markDirty() {
+    m_fullRedraw = true;
+    m_hasDirtyRegion = false;
+}
+
+void CachedLayer::markDirty(const Rectangle& region) {
+    if (m_fullRedraw) {
+        return;
+    }
+    
+    m_dirtyRegion = m_hasDirtyRegion ? unite(m_dirtyRegion, region) : region;
+    m_hasDirtyRegion = true;
+}
+
+void CachedLayer::render(Renderer& renderer, BatchRenderer& batch, const Rectangle& viewBounds,
+                         const Matrix4& view, const Matrix4& projection, float zoom) {
+    if (m_spriteCount == 0) {
+        return;
+    }
+    if (batch.isDrawing()) {
+        LOG_WARNING("CachedLayer::render called while the batch is drawing");
+        return;
+    }
+    
+    updateBounds();
+    if (!m_bounds.intersects(viewBounds)) {
+        return;
+    }
+    
+    if (!prepareCache(renderer, zoom)) {
+        batch.begin(renderer, m_shader, view, projection);
+        drawSprites(batch, viewBounds);
+        batch.end();
+        m_stats.directFrames++;
+        return;
+    }
+    
+    if (isDirty()) {
+        redrawCache(renderer, batch);
+    }
+    m_stats.cachedFrames++;
+    
+    // The cache holds premultiplied color, see redrawCache
+    BlendMode blendMode = renderer.getBlendMode();
+    renderer.setBlendMode(BlendMode::PREMULTIPLIED);
+    
+    batch.begin(renderer, m_shader, view, projection);
+    batch.drawQuad(Vector2(m_cacheRect.x, m_cacheRect.y), Vector2(m_cacheRect.width, m_cacheRect.height),
+                   m_target->getColorTexture(), Vector4(0.0f, 0.0f, 1.0f, 1.0f), COLOR_WHITE, m_depth);
+    batch.end();
+    
+    renderer.setBlendMode(blendMode);
+}
+
+void CachedLayer::releaseGPUResources() {
+    m_target.reset();
+    m_stats.memoryBytes = 0;
+    markDirty();
+}
+
+void CachedLayer::setConfig(const CachedLayerConfig& config) {
+    m_config = config;
+    m_cacheFailed = false;
+    releaseGPUResources();
+}
+
+Rectangle CachedLayer::getBounds() {
+    updateBounds();
+    return m_bounds;
+}
+
+void CachedLayer::updateBounds() {
+    if (!m_boundsDirty) {
+        return;
+    }
+    m_boundsDirty = false;
+    
+    Rectangle bounds;
+    bool first = true;
+    for (const auto& slot : m_slots) {
+        if (!slot.alive) {
+            continue;
+        }
+        bounds = first ? spriteRect(slot.sprite) : unite(bounds, spriteRect(slot.sprite));
+        first = false;
+    }
+    
+    // The cache is laid out over the bounds, so any change moves every texel
+    if (!sameRect(bounds, m_bounds)) {
+        m_bounds = bounds;
+        markDirty();
+    }
+}
+
+bool CachedLayer::prepareCache(Renderer& renderer, float zoom) {
+    // Render targets are GL objects; other backends always draw directly
+    if (m_cacheFailed || renderer.getBackend().getType() != RenderBackendType::OPENGL) {
+        return false;
+    }
+    
+    float pixelsPerUnit = m_config.resolutionScale * std::max(zoom, 0.001f);
+    bool zoomChanged = std::abs(pixelsPerUnit - m_pixelsPerUnit) > m_pixelsPerUnit * m_config.zoomTolerance;
+    if (m_target && !zoomChanged && !m_fullRedraw) {
+        return true;
+    }
+    
+    int width = std::max(1, static_cast<int>(std::ceil(m_bounds.width * pixelsPerUnit)));
+    int height = std::max(1, static_cast<int>(std::ceil(m_bounds.height * pixelsPerUnit)));
+    size_t bytes = static_cast<size_t>(width) * height * RenderTarget::getBytesPerPixel(TextureFormat::RGBA8);
+    
+    if (width > m_config.maxTextureSize || height > m_config.maxTextureSize || bytes > m_config.memoryBudgetBytes) {
+        if (m_target) {
+            LOG_INFO_FMT("Cached layer needs {}x{} texels, over budget; drawing directly", width, height);
+        }
+        releaseGPUResources();
+        m_pixelsPerUnit = pixelsPerUnit;
+        return false;
+    }
+    
+    if (!m_target || m_target->getWidth() != width || m_target->getHeight() != height) {
+        RenderTargetConfig config;
+        config.width = width;
+        config.height = height;
+        config.format = TextureFormat::RGBA8;
+        config.filter = m_config.filter;
+        config.depth = false;
+        
+        auto target = std::make_unique<RenderTarget>();
+        if (!target->create(config)) {
+            LOG_ERROR("Failed to create cached layer target, drawing directly");
+            releaseGPUResources();
+            m_cacheFailed = true;
+            return false;
+        }
+        m_target = std::move(target);
+        m_stats.memoryBytes = m_target->getMemoryUsage();
+    }
+    
+    // Whole texels cover the bounds, so the cached area can be slightly larger
+    m_pixelsPerUnit = pixelsPerUnit;
+    m_cacheRect = Rectangle(m_bounds.x, m_bounds.y, width / pixelsPerUnit, height / pixelsPerUnit);
+    markDirty();
+    return true;
+}
+
+void CachedLayer::redrawCache(Renderer& renderer, BatchRenderer& batch) {
+    int width = m_target->getWidth();
+    int height = m_target->getHeight();
+    Rectangle area = m_cacheRect;
+    bool partial = false;
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = width;
+    int y1 = height;
+    
+    float cacheArea = m_cacheRect.width * m_cacheRect.height;
+    if (!m_fullRedraw && m_dirtyRegion.width * m_dirtyRegion.height < cacheArea * m_config.fullRedrawThreshold) {
+        // Snap the dirty region outwards to whole texels for the scissor
+        x0 = std::max(0, static_cast<int>(std::floor((m_dirtyRegion.x - m_cacheRect.x) * m_pixelsPerUnit)));
+        y0 = std::max(0, static_cast<int>(std::floor((m_dirtyRegion.y - m_cacheRect.y) * m_pixelsPerUnit)));
+        x1 = std::min(width, static_cast<int>(std::ceil((m_dirtyRegion.x + m_dirtyRegion.width - m_cacheRect.x) *
+                                                         m_pixelsPerUnit)));
+        y1 = std::min(height, static_cast<int>(std::ceil((m_dirtyRegion.y + m_dirtyRegion.height - m_cacheRect.y) *
+                                                          m_pixelsPerUnit)));
+        area = Rectangle(m_cacheRect.x + x0 / m_pixelsPerUnit, m_cacheRect.y + y0 / m_pixelsPerUnit,
+                         (x1 - x0) / m_pixelsPerUnit, (y1 - y0) / m_pixelsPerUnit);
+        partial = true;
+    }
+    
+    m_fullRedraw = false;
+    m_hasDirtyRegion = false;
+    if (x1 <= x0 || y1 <= y0) {
+        return;
+    }
+    
+    bool depthTest = renderer.isDepthTestEnabled();
+    bool blending = renderer.isBlendingEnabled();
+    BlendMode blendMode = renderer.getBlendMode();
+    RenderBackend& backend = renderer.getBackend();
+    
+    renderer.beginPass("cached_layer");
+    renderer.bindRenderTarget(m_target.get());
+    renderer.enableDepthTest(false);
+    renderer.enableBlending(true);
+    renderer.setBlendMode(BlendMode::ALPHA);
+    
+    // Clear and redraw only inside the scissor; sprites overlapping its edge
+    // are redrawn whole and clipped, which matches a full redraw exactly
+    backend.setScissor(partial, x0, y0, x1 - x0, y1 - y0);
+    backend.setClearColor(COLOR_TRANSPARENT);
+    backend.clear(true, false);
+    backend.setClearColor(renderer.getClearColor());
+    
+    // Texel row 0 holds the smallest world y, matching the UVs of the composite quad
+    Matrix4 cacheProjection = glm::ortho(m_cacheRect.x, m_cacheRect.x + m_cacheRect.width,
+                                         m_cacheRect.y, m_cacheRect.y + m_cacheRect.height);
+    batch.begin(renderer, m_shader, Matrix4(1.0f), cacheProjection);
+    drawSprites(batch, area);
+    batch.end();
+    
+    backend.setScissor(false, 0, 0, 0, 0);
+    renderer.bindRenderTarget(nullptr);
+    renderer.enableDepthTest(depthTest);
+    renderer.enableBlending(blending);
+    renderer.setBlendMode(blendMode);
+    renderer.endPass();
+    
+    if (partial) {
+        m_stats.partialRedraws++;
+    } else {
+        m_stats.fullRedraws++;
+    }
+}
+
+void CachedLayer::drawSprites(BatchRenderer& batch, const Rectangle& area) {
+    for (const auto& slot : m_slots) {
+        if (!slot.alive) {
+            continue;
+        }
+        
+        const LayerSprite& sprite = slot.sprite;
+        if (!spriteRect(sprite).intersects(area)) {
+            continue;
+        }
+        batch.drawQuad(sprite.position, sprite.size, sprite.texture, sprite.uvRect, sprite.color);
+    }
+}
+
+} // namespace GameEngine2D
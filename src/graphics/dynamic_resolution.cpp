@@ -0,0 +1,110 @@
+#include "graphics/dynamic_resolution.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GameEngine2D {
+
+DynamicResolution::DynamicResolution(const DynamicResolutionConfig& config)
+    : m_sampleCount(0), m_nextSample(0), m_scale(1.0f), m_framesSinceChange(0),
+      m_hasOverride(false), m_overrideScale(1.0f) {
+    setConfig(config);
+}
+
+void DynamicResolution::addFrameTime(float frameTimeMs) {
+    if (frameTimeMs <= 0.0f || m_samples.empty()) {
+        return;
+    }
+    
+    m_samples[m_nextSample] = frameTimeMs;
+    m_nextSample = (m_nextSample + 1) % m_samples.size();
+    m_sampleCount = std::min(m_sampleCount + 1, m_samples.size());
+}
+
+float DynamicResolution::update() {
+    m_framesSinceChange++;
+    
+    if (m_hasOverride || m_sampleCount < static_cast<size_t>(m_config.minSamples)) {
+        return getScale();
+    }
+    
+    float scale = m_controller ? m_controller(*this, m_scale) : computeScale();
+    scale = std::clamp(scale, m_config.minScale, m_config.maxScale);
+    
+    if (scale != m_scale) {
+        LOG_DEBUG_FMT("Dynamic resolution scale changed to {}", scale);
+        m_scale = scale;
+        m_framesSinceChange = 0;
+        
+        // Samples taken at the old scale no longer describe the new load
+        m_sampleCount = 0;
+        m_nextSample = 0;
+    }
+    
+    return m_scale;
+}
+
+void DynamicResolution::reset() {
+    m_sampleCount = 0;
+    m_nextSample = 0;
+    m_framesSinceChange = 0;
+    m_scale = m_config.maxScale;
+}
+
+void DynamicResolution::setScaleOverride(float scale) {
+    m_overrideScale = std::clamp(scale, 0.1f, 1.0f);
+    m_hasOverride = true;
+}
+
+void DynamicResolution::setConfig(const DynamicResolutionConfig& config) {
+    m_config = config;
+    m_config.minScale = std::clamp(m_config.minScale, 0.1f, 1.0f);
+    m_config.maxScale = std::clamp(m_config.maxScale, m_config.minScale, 1.0f);
+    m_config.sampleWindow = std::max(m_config.sampleWindow, 1);
+    m_config.minSamples = std::clamp(m_config.minSamples, 1, m_config.sampleWindow);
+    
+    m_samples.assign(static_cast<size_t>(m_config.sampleWindow), 0.0f);
+    m_sortScratch.reserve(m_samples.size());
+    m_sampleCount = 0;
+    m_nextSample = 0;
+    m_scale = std::clamp(m_scale, m_config.minScale, m_config.maxScale);
+}
+
+float DynamicResolution::getPercentileFrameTime(float percentile) const {
+    if (m_sampleCount == 0) {
+        return 0.0f;
+    }
+    
+    m_sortScratch.assign(m_samples.begin(), m_samples.begin() + m_sampleCount);
+    size_t index = static_cast<size_t>(std::clamp(percentile, 0.0f, 1.0f) * (m_sampleCount - 1));
+    std::nth_element(m_sortScratch.begin(), m_sortScratch.begin() + index, m_sortScratch.end());
+    return m_sortScratch[index];
+}
+
+float DynamicResolution::computeScale() const {
+    float frameTime = getPercentileFrameTime(m_config.percentile);
+    float target = m_config.targetFrameTimeMs;
+    
+    // Fill cost is proportional to pixel count, i.e. to scale squared
+    if (frameTime > target * m_config.downscaleThreshold &&
+        m_framesSinceChange >= m_config.downscaleCooldownFrames) {
+        float desired = m_scale * std::sqrt(target * m_config.upscaleThreshold / frameTime);
+        return std::min(quantize(desired), m_scale - m_config.scaleStep);
+    }
+    
+    if (frameTime < target * m_config.upscaleThreshold &&
+        m_framesSinceChange >= m_config.upscaleCooldownFrames) {
+        return m_scale + m_config.scaleStep;
+    }
+    
+    return m_scale;
+}
+
+float DynamicResolution::quantize(float scale) const {
+    if (m_config.scaleStep <= 0.0f) {
+        return scale;
+    }
+    return std::floor(scale / m_config.scaleStep) * m_config.scaleStep;
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,60 @@
+#include "graphics/font.h"
+#include "utils/logger.h"
+#include <algorithm>
+
+namespace GameEngine2D {
+
+// Static member initialization
+FontID Font::s_nextID = 1;
+
+Font::Font(std::shared_ptr<GlyphSource> source, int baseSize, int spread)
+    : m_id(s_nextID++), m_source(source), m_baseSize(std::max(baseSize, 1)), m_spread(std::max(spread, 1)) {
+    if (!m_source) {
+        LOG_ERROR("Font created without a glyph source");
+    }
+}
+
+Font::~Font() {
+}
+
+const GlyphInfo& Font::getGlyphInfo(uint32_t codepoint) {
+    auto it = m_glyphInfo.find(codepoint);
+    if (it != m_glyphInfo.end()) {
+        return it->second;
+    }
+    
+    GlyphInfo info;
+    if (!m_source || !m_source->getGlyphInfo(codepoint, m_baseSize, info)) {
+        info = GlyphInfo{};
+    }
+    
+    return m_glyphInfo.emplace(codepoint, info).first->second;
+}
+
+float Font::getKerning(uint32_t left, uint32_t right) const {
+    return m_source ? m_source->getKerning(left, right, m_baseSize) : 0.0f;
+}
+
+float Font::getAscent() const {
+    return m_source ? m_source->getAscent(m_baseSize) : static_cast<float>(m_baseSize);
+}
+
+float Font::getLineHeight() const {
+    return m_source ? m_source->getLineHeight(m_baseSize) : static_cast<float>(m_baseSize);
+}
+
+bool Font::rasterizeGlyph(uint32_t codepoint, GlyphBitmap& bitmap) {
+    if (!m_source || !m_source->rasterizeGlyph(codepoint, m_baseSize, bitmap)) {
+        return false;
+    }
+    
+    size_t expected = static_cast<size_t>(bitmap.info.width) * bitmap.info.height;
+    if (bitmap.coverage.size() < expected) {
+        LOG_ERROR_FMT("Glyph source returned a truncated bitmap for U+{}", codepoint);
+        return false;
+    }
+    
+    return true;
+}
+
+} // namespace GameEngine2D
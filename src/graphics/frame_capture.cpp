@@ -0,0 +1,460 @@
+#include "graphics/frame_capture.h"
+#include "utils/file_utils.h"
+#include "utils/logger.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace GameEngine2D {
+
+namespace {
+
+constexpr size_t PNG_STORED_BLOCK = 65535;
+
+struct CRCTable {
+    uint32_t entries[256];
+    
+    CRCTable() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? 0xedb88320u ^ (value >> 1) : value >> 1;
+            }
+            entries[i] = value;
+        }
+    }
+};
+
+uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    static const CRCTable table;
+    
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table.entries[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void appendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    appendBigEndian(out, static_cast<uint32_t>(data.size()));
+    size_t typeStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    appendBigEndian(out, crc32(&out[typeStart], out.size() - typeStart));
+}
+
+} // namespace
+
+FrameCapture::FrameCapture()
+    : m_recording(false), m_presentedFrames(0), m_nextSlot(0), m_videoWidth(0), m_videoHeight(0),
+      m_workerRunning(false), m_encoding(false), m_encodedFrames(0) {
+}
+
+FrameCapture::~FrameCapture() {
+    // GPU buffers are left to the context; shutdown() frees them while it is current
+    stopWorker();
+}
+
+bool FrameCapture::start(const FrameCaptureConfig& config) {
+    if (m_recording) {
+        stop();
+    }
+    
+    m_config = config;
+    m_config.bufferCount = std::max(2, config.bufferCount);
+    m_config.frameInterval = std::max(1, config.frameInterval);
+    m_config.maxQueuedFrames = std::max<size_t>(1, config.maxQueuedFrames);
+    
+    if (m_config.format == CaptureFormat::PNG_SEQUENCE) {
+        if (!FileUtils::directoryExists(m_config.outputPath) && !FileUtils::createDirectory(m_config.outputPath)) {
+            LOG_ERROR_FMT("Failed to create capture directory: {}", m_config.outputPath);
+            return false;
+        }
+    } else {
+        m_videoFile.open(m_config.outputPath, std::ios::binary | std::ios::trunc);
+        if (!m_videoFile.is_open()) {
+            LOG_ERROR_FMT("Failed to open capture file: {}", m_config.outputPath);
+            return false;
+        }
+        m_videoWidth = 0;
+        m_videoHeight = 0;
+    }
+    
+    ensureSlots(m_config.bufferCount);
+    startWorker();
+    m_presentedFrames = 0;
+    m_recording = true;
+    LOG_INFO_FMT("Frame capture started: {}", m_config.outputPath);
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!m_recording) {
+        return;
+    }
+    m_recording = false;
+    
+    // Frames already read back still belong to the recording
+    collectReadbacks(true);
+    waitForEncoder();
+    
+    if (m_videoFile.is_open()) {
+        m_videoFile.close();
+        LOG_INFO_FMT("Raw capture is {}x{} rgba; e.g. ffmpeg -f rawvideo -pixel_format rgba -video_size {}x{} -i {}",
+                     m_videoWidth, m_videoHeight, m_videoWidth, m_videoHeight, m_config.outputPath);
+    }
+    LOG_INFO_FMT("Frame capture stopped: {} frames captured, {} dropped", m_stats.captured, m_stats.dropped);
+}
+
+void FrameCapture::requestScreenshot(const std::string& path) {
+    m_screenshotPaths.push_back(path);
+}
+
+void FrameCapture::onPresent(uint64_t frameIndex, int width, int height) {
+    if (!isActive() || width <= 0 || height <= 0) {
+        return;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    collectReadbacks(false);
+    
+    bool record = m_recording && (m_presentedFrames++ % m_config.frameInterval) == 0;
+    if (record || !m_screenshotPaths.empty()) {
+        if (m_slots.empty()) {
+            ensureSlots(m_config.bufferCount);
+        }
+        
+        ReadbackSlot& slot = m_slots[m_nextSlot];
+        if (slot.pending) {
+            // Every buffer is still in flight; waiting here would be the stall we avoid
+            m_stats.dropped++;
+        } else {
+            slot.recorded = record;
+            slot.screenshotPath.clear();
+            if (!m_screenshotPaths.empty()) {
+                slot.screenshotPath = m_screenshotPaths.front();
+                m_screenshotPaths.erase(m_screenshotPaths.begin());
+            }
+            issueReadback(slot, frameIndex, width, height);
+            m_pending.push_back(m_nextSlot);
+            m_nextSlot = (m_nextSlot + 1) % static_cast<int>(m_slots.size());
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.encoded = m_encodedFrames;
+        m_stats.queuedFrames = m_jobs.size();
+    }
+    
+    auto elapsed = std::chrono::high_resolution_clock::now() - start;
+    m_stats.renderThreadMs = std::chrono::duration<float, std::milli>(elapsed).count();
+}
+
+void FrameCapture::shutdown() {
+    stop();
+    collectReadbacks(true);
+    stopWorker();
+    releaseSlots();
+}
+
+void FrameCapture::ensureSlots(int count) {
+    // Growing is safe at any time; shrinking would discard pending readbacks
+    if (static_cast<int>(m_slots.size()) >= count) {
+        return;
+    }
+    m_slots.resize(static_cast<size_t>(count));
+}
+
+void FrameCapture::releaseSlots() {
+    for (auto& slot : m_slots) {
+        if (slot.fence) {
+            glDeleteSync(static_cast<GLsync>(slot.fence));
+        }
+        if (slot.buffer != 0) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+    }
+    m_slots.clear();
+    m_pending.clear();
+    m_nextSlot = 0;
+}
+
+void FrameCapture::issueReadback(ReadbackSlot& slot, uint64_t frameIndex, int width, int height) {
+    size_t bytes = static_cast<size_t>(width) * height * 4;
+    if (slot.buffer == 0) {
+        glGenBuffers(1, &slot.buffer);
+    }
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (slot.capacity < bytes) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+        slot.capacity = bytes;
+    }
+    
+    // With a pack buffer bound the read is queued and returns immediately
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.pending = true;
+    slot.frameIndex = frameIndex;
+    slot.width = width;
+    slot.height = height;
+    m_stats.captured++;
+}
+
+void FrameCapture::collectReadbacks(bool wait) {
+    // Fences signal in submission order, so stop at the first unsignaled one
+    while (!m_pending.empty()) {
+        ReadbackSlot& slot = m_slots[m_pending.front()];
+        GLsync fence = static_cast<GLsync>(slot.fence);
+        GLbitfield flags = wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0;
+        GLuint64 timeout = wait ? 1000000000ull : 0;
+        GLenum result = glClientWaitSync(fence, flags, timeout);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+            if (!wait) {
+                return;
+            }
+            LOG_WARNING_FMT("Frame capture readback of frame {} timed out", slot.frameIndex);
+        } else {
+            completeReadback(slot);
+        }
+        
+        glDeleteSync(fence);
+        slot.fence = nullptr;
+        slot.pending = false;
+        m_pending.pop_front();
+    }
+}
+
+void FrameCapture::completeReadback(ReadbackSlot& slot) {
+    size_t bytes = static_cast<size_t>(slot.width) * slot.height * 4;
+    
+    bool record = slot.recorded;
+    if (record && m_config.format == CaptureFormat::RAW_VIDEO) {
+        if (m_videoWidth == 0) {
+            m_videoWidth = slot.width;
+            m_videoHeight = slot.height;
+        } else if (slot.width != m_videoWidth || slot.height != m_videoHeight) {
+            // Raw video has no per-frame size; frames after a resize are skipped
+            m_stats.dropped++;
+            record = false;
+        }
+    }
+    if (!record && slot.screenshotPath.empty()) {
+        return;
+    }
+    
+    std::vector<uint8_t> pixels;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_jobs.size() >= m_config.maxQueuedFrames && slot.screenshotPath.empty()) {
+            m_stats.dropped++;
+            return;
+        }
+        if (!m_freeBuffers.empty()) {
+            pixels = std::move(m_freeBuffers.back());
+            m_freeBuffers.pop_back();
+        }
+    }
+    pixels.resize(bytes);
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT);
+    if (!mapped) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        LOG_WARNING_FMT("Failed to map frame capture buffer for frame {}", slot.frameIndex);
+        m_stats.dropped++;
+        return;
+    }
+    std::memcpy(pixels.data(), mapped, bytes);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    std::vector<EncodeJob> jobs;
+    if (!slot.screenshotPath.empty()) {
+        EncodeJob job;
+        if (record) {
+            job.pixels = pixels;
+        } else {
+            job.pixels = std::move(pixels);
+        }
+        job.width = slot.width;
+        job.height = slot.height;
+        job.frameIndex = slot.frameIndex;
+        job.format = CaptureFormat::PNG_SEQUENCE;
+        job.path = slot.screenshotPath;
+        jobs.push_back(std::move(job));
+    }
+    if (record) {
+        EncodeJob job;
+        job.pixels = std::move(pixels);
+        job.width = slot.width;
+        job.height = slot.height;
+        job.frameIndex = slot.frameIndex;
+        job.format = m_config.format;
+        if (m_config.format == CaptureFormat::PNG_SEQUENCE) {
+            std::string name = std::to_string(slot.frameIndex);
+            name.insert(0, name.size() < 8 ? 8 - name.size() : 0, '0');
+            job.path = FileUtils::combinePath(m_config.outputPath, "frame_" + name + ".png");
+        }
+        jobs.push_back(std::move(job));
+    }
+    
+    startWorker();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& job : jobs) {
+            m_jobs.push_back(std::move(job));
+        }
+    }
+    m_condition.notify_all();
+}
+
+void FrameCapture::startWorker() {
+    if (m_workerRunning) {
+        return;
+    }
+    m_workerRunning = true;
+    m_worker = std::thread(&FrameCapture::workerLoop, this);
+}
+
+void FrameCapture::stopWorker() {
+    if (!m_workerRunning) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_workerRunning = false;
+    }
+    m_condition.notify_all();
+    m_worker.join();
+    
+    if (m_videoFile.is_open()) {
+        m_videoFile.close();
+    }
+}
+
+void FrameCapture::waitForEncoder() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return (m_jobs.empty() && !m_encoding) || !m_workerRunning; });
+    m_stats.encoded = m_encodedFrames;
+    m_stats.queuedFrames = 0;
+}
+
+void FrameCapture::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] { return !m_jobs.empty() || !m_workerRunning; });
+        
+        // Queued frames are still written when stopping
+        if (m_jobs.empty()) {
+            break;
+        }
+        
+        EncodeJob job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_encoding = true;
+        lock.unlock();
+        
+        encode(job);
+        
+        lock.lock();
+        m_freeBuffers.push_back(std::move(job.pixels));
+        m_encoding = false;
+        m_encodedFrames++;
+        m_condition.notify_all();
+    }
+}
+
+void FrameCapture::encode(EncodeJob& job) {
+    if (job.format == CaptureFormat::RAW_VIDEO) {
+        // Rows arrive bottom-up from GL; video frames are stored top-down
+        size_t rowBytes = static_cast<size_t>(job.width) * 4;
+        for (int y = job.height - 1; y >= 0; --y) {
+            m_videoFile.write(reinterpret_cast<const char*>(&job.pixels[rowBytes * y]),
+                              static_cast<std::streamsize>(rowBytes));
+        }
+        return;
+    }
+    
+    std::vector<uint8_t> png;
+    encodePNG(job.pixels.data(), job.width, job.height, png);
+    if (!FileUtils::writeBinaryFile(job.path, png)) {
+        LOG_ERROR_FMT("Failed to write capture: {}", job.path);
+    }
+}
+
+void FrameCapture::encodePNG(const uint8_t* pixels, int width, int height, std::vector<uint8_t>& output) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    output.assign(signature, signature + 8);
+    
+    std::vector<uint8_t> header;
+    appendBigEndian(header, static_cast<uint32_t>(width));
+    appendBigEndian(header, static_cast<uint32_t>(height));
+    header.push_back(8);    // Bit depth
+    header.push_back(6);    // RGBA
+    header.push_back(0);    // Deflate
+    header.push_back(0);    // Adaptive filtering
+    header.push_back(0);    // No interlace
+    appendChunk(output, "IHDR", header);
+    
+    // Filtered scanlines: a zero filter byte before each top-down row
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = height - 1; y >= 0; --y) {
+        raw.push_back(0);
+        raw.insert(raw.end(), pixels + rowBytes * y, pixels + rowBytes * (y + 1));
+    }
+    
+    // zlib stream of stored deflate blocks; compression is left to offline tools
+    std::vector<uint8_t> data;
+    data.reserve(raw.size() + raw.size() / PNG_STORED_BLOCK * 5 + 16);
+    data.push_back(0x78);
+    data.push_back(0x01);
+    size_t offset = 0;
+    do {
+        size_t length = std::min(PNG_STORED_BLOCK, raw.size() - offset);
+        bool last = offset + length == raw.size();
+        data.push_back(last ? 1 : 0);
+        data.push_back(static_cast<uint8_t>(length));
+        data.push_back(static_cast<uint8_t>(length >> 8));
+        data.push_back(static_cast<uint8_t>(~length));
+        data.push_back(static_cast<uint8_t>(~length >> 8));
+        data.insert(data.end(), raw.begin() + offset, raw.begin() + offset + length);
+        offset += length;
+    } while (offset < raw.size());
+    
+    // Adler-32; 5552 bytes is the longest run before the sums can overflow
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (size_t start = 0; start < raw.size(); start += 5552) {
+        size_t end = std::min(raw.size(), start + 5552);
+        for (size_t i = start; i < end; ++i) {
+            a += raw[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    appendBigEndian(data, (b << 16) | a);
+    appendChunk(output, "IDAT", data);
+    
+    appendChunk(output, "IEND", std::vector<uint8_t>());
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,265 @@
+#include "graphics/gl_render_backend.h"
+#include "graphics/shader.h"
+#include "graphics/vertex_layout.h"
+#include "utils/logger.h"
+#include <GL/glew.h>
+
+namespace GameEngine2D {
+
+GLRenderBackend::GLRenderBackend() : m_timerQueriesSupported(false) {
+}
+
+bool GLRenderBackend::initialize() {
+    // Set initial OpenGL state
+    glEnable(GL_BLEND);
+    setBlendMode(BlendMode::ALPHA);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_MULTISAMPLE);
+    
+    // Set clear color
+    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+    
+    // Timer queries are core since 3.3; software rasterizers such as llvmpipe
+    // expose them as well, but fall back to CPU-only stats if they are missing
+    m_timerQueriesSupported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+    if (!m_timerQueriesSupported) {
+        LOG_WARNING("Timer queries not supported, GPU frame timings disabled");
+    }
+    
+    return true;
+}
+
+void GLRenderBackend::clear(bool color, bool depth) {
+    GLbitfield mask = 0;
+    if (color) {
+        mask |= GL_COLOR_BUFFER_BIT;
+    }
+    if (depth) {
+        mask |= GL_DEPTH_BUFFER_BIT;
+    }
+    glClear(mask);
+}
+
+void GLRenderBackend::setClearColor(const Color& color) {
+    glClearColor(color.r, color.g, color.b, color.a);
+}
+
+void GLRenderBackend::setViewport(int x, int y, int width, int height) {
+    glViewport(x, y, width, height);
+}
+
+void GLRenderBackend::setBlending(bool enable) {
+    if (enable) {
+        glEnable(GL_BLEND);
+    } else {
+        glDisable(GL_BLEND);
+    }
+}
+
+void GLRenderBackend::setBlendMode(BlendMode mode) {
+    switch (mode) {
+        case BlendMode::ALPHA:
+            // Alpha accumulates with "over" so offscreen targets end up with
+            // premultiplied color and correct coverage
+            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::ADDITIVE:
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+            break;
+        case BlendMode::MULTIPLY:
+            glBlendFunc(GL_DST_COLOR, GL_ZERO);
+            break;
+        case BlendMode::SCREEN:
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_COLOR);
+            break;
+        case BlendMode::PREMULTIPLIED:
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        default:
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+    }
+}
+
+void GLRenderBackend::setDepthTest(bool enable) {
+    if (enable) {
+        glEnable(GL_DEPTH_TEST);
+    } else {
+        glDisable(GL_DEPTH_TEST);
+    }
+}
+
+void GLRenderBackend::setDepthWrite(bool enable) {
+    glDepthMask(enable ? GL_TRUE : GL_FALSE);
+}
+
+void GLRenderBackend::setDepthFunc(DepthFunc func) {
+    glDepthFunc(func == DepthFunc::LESS_EQUAL ? GL_LEQUAL : GL_LESS);
+}
+
+void GLRenderBackend::setScissor(bool enable, int x, int y, int width, int height) {
+    if (enable) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x, y, width, height);
+    } else {
+        glDisable(GL_SCISSOR_TEST);
+    }
+}
+
+void GLRenderBackend::bindFramebuffer(unsigned int framebuffer) {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+}
+
+unsigned int GLRenderBackend::createBuffer() {
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    return buffer;
+}
+
+void GLRenderBackend::destroyBuffer(unsigned int buffer) {
+    if (buffer != 0) {
+        glDeleteBuffers(1, &buffer);
+    }
+}
+
+void GLRenderBackend::uploadBuffer(unsigned int buffer, const void* data, size_t bytes, bool dynamic) {
+    // Uploads go through GL_ARRAY_BUFFER so the element binding of
+    // whichever VAO is bound is left alone
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+}
+
+void GLRenderBackend::streamBuffer(unsigned int buffer, size_t capacity, const void* data, size_t bytes) {
+    // Orphan the buffer so the driver doesn't wait on draws still reading it
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), data);
+}
+
+void GLRenderBackend::updateBuffer(unsigned int buffer, size_t offset, const void* data, size_t bytes) {
+    // The copy-write target leaves the array and indexed uniform bindings alone
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+}
+
+void GLRenderBackend::bindUniformBuffer(unsigned int binding, unsigned int buffer) {
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+}
+
+unsigned int GLRenderBackend::createVertexArray(const VertexLayout& layout, unsigned int vertexBuffer,
+                                                unsigned int indexBuffer) {
+    GLuint vertexArray = 0;
+    glGenVertexArrays(1, &vertexArray);
+    glBindVertexArray(vertexArray);
+    
+    // Attribute-less arrays are valid; core profile still needs one bound
+    if (vertexBuffer != 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        layout.apply();
+    }
+    if (indexBuffer != 0) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    }
+    
+    glBindVertexArray(0);
+    return vertexArray;
+}
+
+void GLRenderBackend::destroyVertexArray(unsigned int vertexArray) {
+    if (vertexArray != 0) {
+        glDeleteVertexArrays(1, &vertexArray);
+    }
+}
+
+bool GLRenderBackend::bindShader(Shader* shader) {
+    // Programs still compiling in the driver are skipped, not waited on
+    if (!shader || !shader->pollCompile()) {
+        return false;
+    }
+    shader->bind();
+    return true;
+}
+
+void GLRenderBackend::setUniform(Shader& shader, const std::string& name, int value) {
+    shader.setUniform(name, value);
+}
+
+void GLRenderBackend::setUniform(Shader& shader, const std::string& name, bool value) {
+    shader.setUniform(name, value);
+}
+
+void GLRenderBackend::setUniform(Shader& shader, const std::string& name, const Vector2& value) {
+    shader.setUniform(name, value);
+}
+
+void GLRenderBackend::setUniform(Shader& shader, const std::string& name, const Matrix4& value) {
+    shader.setUniform(name, value);
+}
+
+void GLRenderBackend::setUniform(Shader& shader, UniformHandle handle, int value) {
+    shader.setUniform(handle, value);
+}
+
+void GLRenderBackend::setUniform(Shader& shader, UniformHandle handle, bool value) {
+    shader.setUniform(handle, value);
+}
+
+void GLRenderBackend::setUniform(Shader& shader, UniformHandle handle, const Vector2& value) {
+    shader.setUniform(handle, value);
+}
+
+void GLRenderBackend::setUniform(Shader& shader, UniformHandle handle, const Matrix4& value) {
+    shader.setUniform(handle, value);
+}
+
+void GLRenderBackend::bindTexture(unsigned int unit, TextureID texture) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLRenderBackend::drawIndexed(unsigned int vertexArray, uint32_t indexCount, uint32_t firstIndex) {
+    glBindVertexArray(vertexArray);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_SHORT,
+                   reinterpret_cast<const void*>(static_cast<uintptr_t>(firstIndex) * sizeof(uint16_t)));
+    glBindVertexArray(0);
+}
+
+void GLRenderBackend::drawArrays(unsigned int vertexArray, uint32_t vertexCount) {
+    glBindVertexArray(vertexArray);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertexCount));
+    glBindVertexArray(0);
+}
+
+unsigned int GLRenderBackend::createQuery() {
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    return query;
+}
+
+void GLRenderBackend::destroyQuery(unsigned int query) {
+    if (query != 0) {
+        glDeleteQueries(1, &query);
+    }
+}
+
+void GLRenderBackend::beginTimerQuery(unsigned int query) {
+    glBeginQuery(GL_TIME_ELAPSED, query);
+}
+
+void GLRenderBackend::endTimerQuery() {
+    glEndQuery(GL_TIME_ELAPSED);
+}
+
+bool GLRenderBackend::isQueryResultAvailable(unsigned int query) {
+    GLint available = 0;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available != 0;
+}
+
+uint64_t GLRenderBackend::getQueryResult(unsigned int query) {
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+    return elapsed;
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,270 @@
+#include "graphics/glyph_atlas.h"
+#include "graphics/font.h"
+#include "utils/logger.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+
+namespace GameEngine2D {
+
+namespace {
+
+constexpr float EDT_INFINITY = 1e20f;
+
+// One-dimensional squared Euclidean distance transform (Felzenszwalb & Huttenlocher)
+void distanceTransform1D(const float* f, int n, float* d, int* v, float* z) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -EDT_INFINITY;
+    z[1] = EDT_INFINITY;
+    
+    for (int q = 1; q < n; ++q) {
+        float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = EDT_INFINITY;
+    }
+    
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) {
+            ++k;
+        }
+        float dq = static_cast<float>(q - v[k]);
+        d[q] = dq * dq + f[v[k]];
+    }
+}
+
+void distanceTransform2D(std::vector<float>& grid, int width, int height) {
+    int n = std::max(width, height);
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+    
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            f[y] = grid[y * width + x];
+        }
+        distanceTransform1D(f.data(), height, d.data(), v.data(), z.data());
+        for (int y = 0; y < height; ++y) {
+            grid[y * width + x] = d[y];
+        }
+    }
+    
+    for (int y = 0; y < height; ++y) {
+        distanceTransform1D(&grid[y * width], width, d.data(), v.data(), z.data());
+        std::copy(d.begin(), d.begin() + width, grid.begin() + y * width);
+    }
+}
+
+} // namespace
+
+GlyphAtlas::GlyphAtlas(int textureSize, int cellSize)
+    : m_textureSize(std::max(textureSize, 64)), m_cellSize(std::clamp(cellSize, 8, m_textureSize)),
+      m_cellsPerRow(0), m_texture(0), m_frame(1) {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    shutdown();
+}
+
+bool GlyphAtlas::initialize() {
+    if (m_texture != 0) {
+        return true;
+    }
+    
+    m_cellsPerRow = m_textureSize / m_cellSize;
+    m_slots.assign(static_cast<size_t>(m_cellsPerRow) * m_cellsPerRow, Slot{});
+    m_lru.clear();
+    m_lookup.clear();
+    for (uint32_t i = 0; i < m_slots.size(); ++i) {
+        m_slots[i].lruPosition = m_lru.insert(m_lru.end(), i);
+    }
+    m_cellBuffer.assign(static_cast<size_t>(m_cellSize) * m_cellSize, 0);
+    
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_textureSize, m_textureSize, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    LOG_INFO_FMT("GlyphAtlas initialized with {} cells", m_slots.size());
+    return true;
+}
+
+void GlyphAtlas::shutdown() {
+    if (m_texture != 0) {
+        glDeleteTextures(1, &m_texture);
+        m_texture = 0;
+    }
+    m_slots.clear();
+    m_lru.clear();
+    m_lookup.clear();
+}
+
+void GlyphAtlas::beginFrame() {
+    m_frame++;
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.evictions = 0;
+    m_stats.failures = 0;
+}
+
+bool GlyphAtlas::acquire(Font& font, uint32_t codepoint, AtlasGlyph& glyph) {
+    if (m_texture == 0) {
+        return false;
+    }
+    
+    uint64_t key = makeKey(font.getID(), codepoint);
+    auto it = m_lookup.find(key);
+    if (it != m_lookup.end()) {
+        Slot& slot = m_slots[it->second];
+        markUsed(it->second);
+        glyph.uvRect = slot.uvRect;
+        glyph.slot = it->second;
+        glyph.generation = slot.generation;
+        m_stats.hits++;
+        return true;
+    }
+    
+    m_stats.misses++;
+    
+    uint32_t index = 0;
+    if (!allocateSlot(index) || !uploadGlyph(font, codepoint, index)) {
+        m_stats.failures++;
+        return false;
+    }
+    
+    Slot& slot = m_slots[index];
+    slot.key = key;
+    slot.occupied = true;
+    slot.generation++;
+    m_lookup[key] = index;
+    m_stats.residentGlyphs++;
+    markUsed(index);
+    
+    glyph.uvRect = slot.uvRect;
+    glyph.slot = index;
+    glyph.generation = slot.generation;
+    return true;
+}
+
+bool GlyphAtlas::touch(const AtlasGlyph& glyph) {
+    if (glyph.slot >= m_slots.size()) {
+        return false;
+    }
+    
+    const Slot& slot = m_slots[glyph.slot];
+    if (!slot.occupied || slot.generation != glyph.generation) {
+        return false;
+    }
+    
+    markUsed(glyph.slot);
+    m_stats.hits++;
+    return true;
+}
+
+void GlyphAtlas::generateSDF(const uint8_t* coverage, int width, int height, int spread,
+                             std::vector<uint8_t>& output) {
+    int paddedWidth = width + spread * 2;
+    int paddedHeight = height + spread * 2;
+    size_t count = static_cast<size_t>(paddedWidth) * paddedHeight;
+    
+    std::vector<float> outside(count, EDT_INFINITY);
+    std::vector<float> inside(count, 0.0f);
+    
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (coverage[y * width + x] >= 128) {
+                size_t index = static_cast<size_t>(y + spread) * paddedWidth + (x + spread);
+                outside[index] = 0.0f;
+                inside[index] = EDT_INFINITY;
+            }
+        }
+    }
+    
+    // Squared distance to the nearest inside pixel, and to the nearest outside pixel
+    distanceTransform2D(outside, paddedWidth, paddedHeight);
+    distanceTransform2D(inside, paddedWidth, paddedHeight);
+    
+    output.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        float distance = inside[i] > 0.0f ? -(std::sqrt(inside[i]) - 0.5f)
+                                          : std::sqrt(outside[i]) - 0.5f;
+        float value = std::clamp(0.5f - distance / (2.0f * spread), 0.0f, 1.0f);
+        output[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+}
+
+void GlyphAtlas::markUsed(uint32_t slot) {
+    m_slots[slot].lastUsedFrame = m_frame;
+    m_lru.splice(m_lru.begin(), m_lru, m_slots[slot].lruPosition);
+}
+
+bool GlyphAtlas::allocateSlot(uint32_t& slot) {
+    slot = m_lru.back();
+    Slot& candidate = m_slots[slot];
+    if (!candidate.occupied) {
+        return true;
+    }
+    
+    // Everything resident was drawn this frame; the atlas is too small
+    if (candidate.lastUsedFrame == m_frame) {
+        LOG_WARNING("GlyphAtlas full, glyph dropped for this frame");
+        return false;
+    }
+    
+    m_lookup.erase(candidate.key);
+    candidate.occupied = false;
+    m_stats.residentGlyphs--;
+    m_stats.evictions++;
+    return true;
+}
+
+bool GlyphAtlas::uploadGlyph(Font& font, uint32_t codepoint, uint32_t slot) {
+    GlyphBitmap bitmap;
+    if (!font.rasterizeGlyph(codepoint, bitmap)) {
+        return false;
+    }
+    
+    int spread = font.getSpread();
+    int paddedWidth = bitmap.info.width + spread * 2;
+    int paddedHeight = bitmap.info.height + spread * 2;
+    if (paddedWidth > m_cellSize || paddedHeight > m_cellSize) {
+        LOG_WARNING_FMT("Glyph U+{} does not fit in a {}px atlas cell", codepoint, m_cellSize);
+        return false;
+    }
+    
+    std::vector<uint8_t> sdf;
+    generateSDF(bitmap.coverage.data(), bitmap.info.width, bitmap.info.height, spread, sdf);
+    
+    // Upload the whole cell so stale texels from an evicted glyph can't bleed in
+    std::fill(m_cellBuffer.begin(), m_cellBuffer.end(), 0);
+    for (int y = 0; y < paddedHeight; ++y) {
+        std::copy_n(sdf.begin() + y * paddedWidth, paddedWidth, m_cellBuffer.begin() + y * m_cellSize);
+    }
+    
+    int cellX = static_cast<int>(slot % m_cellsPerRow) * m_cellSize;
+    int cellY = static_cast<int>(slot / m_cellsPerRow) * m_cellSize;
+    
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, cellX, cellY, m_cellSize, m_cellSize,
+                    GL_RED, GL_UNSIGNED_BYTE, m_cellBuffer.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    float scale = 1.0f / m_textureSize;
+    m_slots[slot].uvRect = Vector4(cellX * scale, cellY * scale,
+                                   (cellX + paddedWidth) * scale, (cellY + paddedHeight) * scale);
+    return true;
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,193 @@
+#include "graphics/program_binary_cache.h"
+#include "utils/file_utils.h"
+#include "utils/hash_utils.h"
+#include "utils/logger.h"
+#include <GL/glew.h>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+
+namespace GameEngine2D {
+
+namespace {
+
+constexpr char ENTRY_MAGIC[8] = { 'G', 'E', '2', 'D', 'P', 'B', 'I', 'N' };
+constexpr uint32_t ENTRY_VERSION = 1;
+
+// Entry file: this header followed by the driver's binary blob
+struct EntryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t binaryFormat;
+    uint64_t key;
+    uint64_t payloadHash;
+    uint64_t payloadSize;
+};
+
+std::string getGLString(GLenum name) {
+    const char* value = reinterpret_cast<const char*>(glGetString(name));
+    return value ? value : "";
+}
+
+} // namespace
+
+ProgramBinaryCache& ProgramBinaryCache::getInstance() {
+    static ProgramBinaryCache instance;
+    return instance;
+}
+
+ProgramBinaryCache::ProgramBinaryCache()
+    : m_directory("cache/shaders"), m_driverQueried(false), m_supported(false), m_driverHash(0) {
+}
+
+void ProgramBinaryCache::setDirectory(const std::string& directory) {
+    m_directory = directory;
+}
+
+bool ProgramBinaryCache::isEnabled() {
+    if (m_directory.empty()) {
+        return false;
+    }
+    if (!m_driverQueried) {
+        queryDriver();
+    }
+    return m_supported;
+}
+
+void ProgramBinaryCache::queryDriver() {
+    m_driverQueried = true;
+    
+    GLint formatCount = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    }
+    m_supported = formatCount > 0;
+    if (!m_supported) {
+        LOG_INFO("Driver exposes no program binary formats, shader binary cache disabled");
+        return;
+    }
+    
+    std::string driver = getGLString(GL_VENDOR) + '\n' + getGLString(GL_RENDERER) + '\n' + getGLString(GL_VERSION);
+    m_driverHash = HashUtils::fnv1a(driver);
+}
+
+uint64_t ProgramBinaryCache::computeKey(const std::string& vertexSource, const std::string& fragmentSource) {
+    if (!m_driverQueried) {
+        queryDriver();
+    }
+    
+    // Lengths are mixed in so moving text between the stages changes the key
+    uint64_t lengths[2] = { vertexSource.size(), fragmentSource.size() };
+    uint64_t hash = HashUtils::fnv1a(lengths, sizeof(lengths), m_driverHash);
+    hash = HashUtils::fnv1a(vertexSource, hash);
+    return HashUtils::fnv1a(fragmentSource, hash);
+}
+
+unsigned int ProgramBinaryCache::load(uint64_t key) {
+    if (!isEnabled()) {
+        return 0;
+    }
+    
+    std::string path = getEntryPath(key);
+    if (!FileUtils::fileExists(path)) {
+        m_stats.misses++;
+        return 0;
+    }
+    
+    std::vector<unsigned char> data = FileUtils::readBinaryFile(path);
+    EntryHeader header;
+    bool valid = data.size() >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, data.data(), sizeof(header));
+        const unsigned char* payload = data.data() + sizeof(header);
+        valid = std::memcmp(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) == 0 &&
+                header.version == ENTRY_VERSION && header.key == key &&
+                header.payloadSize == data.size() - sizeof(header) &&
+                header.payloadHash == HashUtils::fnv1a(payload, header.payloadSize);
+    }
+    
+    GLuint program = 0;
+    if (valid) {
+        program = glCreateProgram();
+        glProgramBinary(program, header.binaryFormat, data.data() + sizeof(header),
+                        static_cast<GLsizei>(header.payloadSize));
+        
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked != GL_TRUE) {
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+    
+    // Stale or corrupt entries are dropped and the caller recompiles
+    if (program == 0) {
+        LOG_DEBUG_FMT("Discarding rejected program binary {}", path);
+        FileUtils::deleteFile(path);
+        m_stats.rejected++;
+        return 0;
+    }
+    
+    m_stats.hits++;
+    return program;
+}
+
+bool ProgramBinaryCache::store(uint64_t key, unsigned int program) {
+    if (!isEnabled() || program == 0) {
+        return false;
+    }
+    
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return false;
+    }
+    
+    std::vector<unsigned char> data(sizeof(EntryHeader) + static_cast<size_t>(length));
+    GLenum binaryFormat = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &binaryFormat, data.data() + sizeof(EntryHeader));
+    if (written <= 0) {
+        return false;
+    }
+    data.resize(sizeof(EntryHeader) + static_cast<size_t>(written));
+    
+    EntryHeader header;
+    std::memcpy(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+    header.version = ENTRY_VERSION;
+    header.binaryFormat = binaryFormat;
+    header.key = key;
+    header.payloadSize = static_cast<uint64_t>(written);
+    header.payloadHash = HashUtils::fnv1a(data.data() + sizeof(EntryHeader), header.payloadSize);
+    std::memcpy(data.data(), &header, sizeof(header));
+    
+    if (!FileUtils::directoryExists(m_directory)) {
+        FileUtils::createDirectory(m_directory);
+    }
+    if (!FileUtils::writeBinaryFile(getEntryPath(key), data)) {
+        return false;
+    }
+    
+    m_stats.stored++;
+    return true;
+}
+
+void ProgramBinaryCache::clear() {
+    if (m_directory.empty() || !FileUtils::directoryExists(m_directory)) {
+        return;
+    }
+    
+    for (const auto& file : FileUtils::listFiles(m_directory)) {
+        if (FileUtils::getExtension(file) == ".bin") {
+            FileUtils::deleteFile(file);
+        }
+    }
+}
+
+std::string ProgramBinaryCache::getEntryPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return FileUtils::combinePath(m_directory, name);
+}
+
+} // namespace GameEngine2D
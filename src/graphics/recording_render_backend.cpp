@@ -0,0 +1,654 @@
+#include "graphics/recording_render_backend.h"
+#include "graphics/null_render_backend.h"
+#include "utils/hash_utils.h"
+#include "utils/logger.h"
+#include <sstream>
+#include <iomanip>
+#include <limits>
+
+namespace GameEngine2D {
+
+namespace {
+
+const char* const STREAM_HEADER = "# GameEngine2D render command stream v1";
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+bool decodeHex(const std::string& hex, std::vector<uint8_t>& out) {
+    if (hex.size() % 2 != 0) {
+        return false;
+    }
+    
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    };
+    
+    out.resize(hex.size() / 2);
+    for (size_t i = 0; i < out.size(); ++i) {
+        int high = nibble(hex[i * 2]);
+        int low = nibble(hex[i * 2 + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        out[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+} // namespace
+
+RecordingRenderBackend::RecordingRenderBackend(const std::string& path, std::unique_ptr<RenderBackend> target,
+                                               bool captureBufferData)
+    : m_path(path), m_target(std::move(target)), m_captureBufferData(captureBufferData), m_commandCount(0) {
+    if (!m_target) {
+        m_target = std::make_unique<NullRenderBackend>();
+    }
+}
+
+RecordingRenderBackend::~RecordingRenderBackend() {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+}
+
+bool RecordingRenderBackend::initialize() {
+    m_file.open(m_path, std::ios::out | std::ios::trunc);
+    if (!m_file.is_open()) {
+        LOG_ERROR_FMT("Failed to open render command recording: {}", m_path);
+        return false;
+    }
+    
+    // Enough digits for floats to round-trip exactly through the text stream
+    m_file << std::setprecision(std::numeric_limits<float>::max_digits10);
+    m_file << STREAM_HEADER << '\n';
+    
+    LOG_INFO_FMT("Recording render commands to {}", m_path);
+    return m_target->initialize();
+}
+
+void RecordingRenderBackend::shutdown() {
+    m_target->shutdown();
+    if (m_file.is_open()) {
+        m_file.flush();
+        m_file.close();
+        LOG_INFO_FMT("Recorded {} render commands", m_commandCount);
+    }
+}
+
+void RecordingRenderBackend::beginFrame(uint64_t frameIndex) {
+    command("frame") << ' ' << frameIndex << '\n';
+    m_target->beginFrame(frameIndex);
+}
+
+void RecordingRenderBackend::endFrame() {
+    command("end_frame") << '\n';
+    m_target->endFrame();
+}
+
+void RecordingRenderBackend::clear(bool color, bool depth) {
+    command("clear") << ' ' << color << ' ' << depth << '\n';
+    m_target->clear(color, depth);
+}
+
+void RecordingRenderBackend::setClearColor(const Color& color) {
+    command("clear_color") << ' ' << color.r << ' ' << color.g << ' ' << color.b << ' ' << color.a << '\n';
+    m_target->setClearColor(color);
+}
+
+void RecordingRenderBackend::setViewport(int x, int y, int width, int height) {
+    command("viewport") << ' ' << x << ' ' << y << ' ' << width << ' ' << height << '\n';
+    m_target->setViewport(x, y, width, height);
+}
+
+void RecordingRenderBackend::setBlending(bool enable) {
+    command("blend") << ' ' << enable << '\n';
+    m_target->setBlending(enable);
+}
+
+void RecordingRenderBackend::setBlendMode(BlendMode mode) {
+    command("blend_mode") << ' ' << static_cast<int>(mode) << '\n';
+    m_target->setBlendMode(mode);
+}
+
+void RecordingRenderBackend::setDepthTest(bool enable) {
+    command("depth_test") << ' ' << enable << '\n';
+    m_target->setDepthTest(enable);
+}
+
+void RecordingRenderBackend::setDepthWrite(bool enable) {
+    command("depth_write") << ' ' << enable << '\n';
+    m_target->setDepthWrite(enable);
+}
+
+void RecordingRenderBackend::setDepthFunc(DepthFunc func) {
+    command("depth_func") << ' ' << static_cast<int>(func) << '\n';
+    m_target->setDepthFunc(func);
+}
+
+void RecordingRenderBackend::setScissor(bool enable, int x, int y, int width, int height) {
+    command("scissor") << ' ' << enable << ' ' << x << ' ' << y << ' ' << width << ' ' << height << '\n';
+    m_target->setScissor(enable, x, y, width, height);
+}
+
+void RecordingRenderBackend::bindFramebuffer(unsigned int framebuffer) {
+    command("framebuffer") << ' ' << framebuffer << '\n';
+    m_target->bindFramebuffer(framebuffer);
+}
+
+unsigned int RecordingRenderBackend::createBuffer() {
+    unsigned int buffer = m_target->createBuffer();
+    command("buffer_create") << ' ' << buffer << '\n';
+    return buffer;
+}
+
+void RecordingRenderBackend::destroyBuffer(unsigned int buffer) {
+    command("buffer_destroy") << ' ' << buffer << '\n';
+    m_target->destroyBuffer(buffer);
+}
+
+void RecordingRenderBackend::uploadBuffer(unsigned int buffer, const void* data, size_t bytes, bool dynamic) {
+    command("buffer_upload") << ' ' << buffer << ' ' << bytes << ' ' << dynamic;
+    writeData(data, bytes);
+    m_target->uploadBuffer(buffer, data, bytes, dynamic);
+}
+
+void RecordingRenderBackend::streamBuffer(unsigned int buffer, size_t capacity, const void* data, size_t bytes) {
+    command("buffer_stream") << ' ' << buffer << ' ' << capacity << ' ' << bytes;
+    writeData(data, bytes);
+    m_target->streamBuffer(buffer, capacity, data, bytes);
+}
+
+void RecordingRenderBackend::updateBuffer(unsigned int buffer, size_t offset, const void* data, size_t bytes) {
+    command("buffer_update") << ' ' << buffer << ' ' << offset << ' ' << bytes;
+    writeData(data, bytes);
+    m_target->updateBuffer(buffer, offset, data, bytes);
+}
+
+void RecordingRenderBackend::bindUniformBuffer(unsigned int binding, unsigned int buffer) {
+    command("uniform_buffer") << ' ' << binding << ' ' << buffer << '\n';
+    m_target->bindUniformBuffer(binding, buffer);
+}
+
+unsigned int RecordingRenderBackend::createVertexArray(const VertexLayout& layout, unsigned int vertexBuffer,
+                                                       unsigned int indexBuffer) {
+    unsigned int vertexArray = m_target->createVertexArray(layout, vertexBuffer, indexBuffer);
+    
+    std::ostream& out = command("vao_create");
+    out << ' ' << vertexArray << ' ' << vertexBuffer << ' ' << indexBuffer << ' ' << layout.getStride()
+        << ' ' << layout.getAttributes().size();
+    for (const auto& attribute : layout.getAttributes()) {
+        out << ' ' << attribute.location << ' ' << attribute.components << ' ' << static_cast<int>(attribute.type)
+            << ' ' << static_cast<int>(attribute.mode) << ' ' << attribute.offset;
+    }
+    out << '\n';
+    return vertexArray;
+}
+
+void RecordingRenderBackend::destroyVertexArray(unsigned int vertexArray) {
+    command("vao_destroy") << ' ' << vertexArray << '\n';
+    m_target->destroyVertexArray(vertexArray);
+}
+
+bool RecordingRenderBackend::bindShader(Shader* shader) {
+    command("shader") << ' ' << getShaderID(shader) << '\n';
+    return m_target->bindShader(shader);
+}
+
+void RecordingRenderBackend::setUniform(Shader& shader, const std::string& name, int value) {
+    command("uniform_int") << ' ' << getShaderID(&shader) << ' ' << name << ' ' << value << '\n';
+    m_target->setUniform(shader, name, value);
+}
+
+void RecordingRenderBackend::setUniform(Shader& shader, const std::string& name, bool value) {
+    command("uniform_bool") << ' ' << getShaderID(&shader) << ' ' << name << ' ' << value << '\n';
+    m_target->setUniform(shader, name, value);
+}
+
+void RecordingRenderBackend::setUniform(Shader& shader, const std::string& name, const Vector2& value) {
+    command("uniform_vec2") << ' ' << getShaderID(&shader) << ' ' << name << ' ' << value.x << ' ' << value.y << '\n';
+    m_target->setUniform(shader, name, value);
+}
+
+void RecordingRenderBackend::setUniform(Shader& shader, const std::string& name, const Matrix4& value) {
+    std::ostream& out = command("uniform_mat4");
+    out << ' ' << getShaderID(&shader) << ' ' << name;
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            out << ' ' << value[column][row];
+        }
+    }
+    out << '\n';
+    m_target->setUniform(shader, name, value);
+}
+
+// Handles are recorded by name, so recordings stay valid across processes
+void RecordingRenderBackend::setUniform(Shader& shader, UniformHandle handle, int value) {
+    command("uniform_int") << ' ' << getShaderID(&shader) << ' ' << handle.getName() << ' ' << value << '\n';
+    m_target->setUniform(shader, handle, value);
+}
+
+void RecordingRenderBackend::setUniform(Shader& shader, UniformHandle handle, bool value) {
+    command("uniform_bool") << ' ' << getShaderID(&shader) << ' ' << handle.getName() << ' ' << value << '\n';
+    m_target->setUniform(shader, handle, value);
+}
+
+void RecordingRenderBackend::setUniform(Shader& shader, UniformHandle handle, const Vector2& value) {
+    command("uniform_vec2") << ' ' << getShaderID(&shader) << ' ' << handle.getName() << ' ' << value.x << ' '
+                            << value.y << '\n';
+    m_target->setUniform(shader, handle, value);
+}
+
+void RecordingRenderBackend::setUniform(Shader& shader, UniformHandle handle, const Matrix4& value) {
+    std::ostream& out = command("uniform_mat4");
+    out << ' ' << getShaderID(&shader) << ' ' << handle.getName();
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            out << ' ' << value[column][row];
+        }
+    }
+    out << '\n';
+    m_target->setUniform(shader, handle, value);
+}
+
+void RecordingRenderBackend::bindTexture(unsigned int unit, TextureID texture) {
+    command("texture") << ' ' << unit << ' ' << texture << '\n';
+    m_target->bindTexture(unit, texture);
+}
+
+void RecordingRenderBackend::drawIndexed(unsigned int vertexArray, uint32_t indexCount, uint32_t firstIndex) {
+    command("draw_indexed") << ' ' << vertexArray << ' ' << indexCount << ' ' << firstIndex << '\n';
+    m_target->drawIndexed(vertexArray, indexCount, firstIndex);
+}
+
+void RecordingRenderBackend::drawArrays(unsigned int vertexArray, uint32_t vertexCount) {
+    command("draw_arrays") << ' ' << vertexArray << ' ' << vertexCount << '\n';
+    m_target->drawArrays(vertexArray, vertexCount);
+}
+
+std::ostream& RecordingRenderBackend::command(const char* name) {
+    m_commandCount++;
+    m_file << name;
+    return m_file;
+}
+
+void RecordingRenderBackend::writeData(const void* data, size_t bytes) {
+    uint64_t hash = data ? HashUtils::fnv1a(data, bytes) : 0;
+    m_file << ' ' << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << std::setfill(' ');
+    
+    if (m_captureBufferData && data && bytes > 0) {
+        std::string hex(bytes * 2, '0');
+        const uint8_t* bytePtr = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < bytes; ++i) {
+            hex[i * 2] = HEX_DIGITS[bytePtr[i] >> 4];
+            hex[i * 2 + 1] = HEX_DIGITS[bytePtr[i] & 0x0f];
+        }
+        m_file << ' ' << hex;
+    }
+    m_file << '\n';
+}
+
+uint32_t RecordingRenderBackend::getShaderID(const Shader* shader) {
+    if (!shader) {
+        return 0;
+    }
+    
+    auto it = m_shaderIDs.find(shader);
+    if (it != m_shaderIDs.end()) {
+        return it->second;
+    }
+    
+    uint32_t id = static_cast<uint32_t>(m_shaderIDs.size() + 1);
+    m_shaderIDs.emplace(shader, id);
+    return id;
+}
+
+// RenderCommandReplayer implementation
+RenderCommandReplayer::RenderCommandReplayer() : m_currentShader(nullptr) {
+}
+
+bool RenderCommandReplayer::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        LOG_ERROR_FMT("Failed to open render command stream: {}", path);
+        return false;
+    }
+    
+    m_commands.clear();
+    m_frameStarts.clear();
+    
+    std::string line;
+    if (!std::getline(file, line) || line != STREAM_HEADER) {
+        LOG_ERROR_FMT("Not a render command stream: {}", path);
+        return false;
+    }
+    
+    size_t lineNumber = 1;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        
+        Command command;
+        if (!parseLine(line, command)) {
+            LOG_ERROR_FMT("Malformed render command at {}:{}", path, lineNumber);
+            m_commands.clear();
+            m_frameStarts.clear();
+            return false;
+        }
+        
+        if (command.op == Op::BEGIN_FRAME) {
+            m_frameStarts.push_back(m_commands.size());
+        }
+        m_commands.push_back(std::move(command));
+    }
+    
+    LOG_INFO_FMT("Loaded {} render commands ({} frames) from {}", m_commands.size(), m_frameStarts.size(), path);
+    return true;
+}
+
+void RenderCommandReplayer::replay(RenderBackend& backend) {
+    for (const auto& command : m_commands) {
+        execute(backend, command);
+    }
+}
+
+bool RenderCommandReplayer::replayFrame(RenderBackend& backend, size_t frame) {
+    if (frame >= m_frameStarts.size()) {
+        return false;
+    }
+    
+    size_t begin = m_frameStarts[frame];
+    size_t end = frame + 1 < m_frameStarts.size() ? m_frameStarts[frame + 1] : m_commands.size();
+    for (size_t i = begin; i < end; ++i) {
+        execute(backend, m_commands[i]);
+    }
+    return true;
+}
+
+void RenderCommandReplayer::releaseResources(RenderBackend& backend) {
+    for (const auto& pair : m_vertexArrays) {
+        backend.destroyVertexArray(pair.second);
+    }
+    for (const auto& pair : m_buffers) {
+        backend.destroyBuffer(pair.second);
+    }
+    m_vertexArrays.clear();
+    m_buffers.clear();
+    m_currentShader = nullptr;
+}
+
+bool RenderCommandReplayer::parseLine(const std::string& line, Command& command) const {
+    static const std::unordered_map<std::string, Op> ops = {
+        {"frame", Op::BEGIN_FRAME}, {"end_frame", Op::END_FRAME}, {"clear", Op::CLEAR},
+        {"clear_color", Op::CLEAR_COLOR}, {"viewport", Op::VIEWPORT}, {"blend", Op::BLEND},
+        {"blend_mode", Op::BLEND_MODE}, {"depth_test", Op::DEPTH_TEST}, {"depth_write", Op::DEPTH_WRITE},
+        {"depth_func", Op::DEPTH_FUNC}, {"scissor", Op::SCISSOR},
+        {"framebuffer", Op::FRAMEBUFFER},
+        {"buffer_create", Op::BUFFER_CREATE}, {"buffer_destroy", Op::BUFFER_DESTROY},
+        {"buffer_upload", Op::BUFFER_UPLOAD}, {"buffer_stream", Op::BUFFER_STREAM},
+        {"buffer_update", Op::BUFFER_UPDATE}, {"uniform_buffer", Op::UNIFORM_BUFFER},
+        {"vao_create", Op::VAO_CREATE}, {"vao_destroy", Op::VAO_DESTROY}, {"shader", Op::SHADER},
+        {"uniform_int", Op::UNIFORM_INT}, {"uniform_bool", Op::UNIFORM_BOOL},
+        {"uniform_vec2", Op::UNIFORM_VEC2}, {"uniform_mat4", Op::UNIFORM_MAT4},
+        {"texture", Op::TEXTURE}, {"draw_indexed", Op::DRAW_INDEXED}, {"draw_arrays", Op::DRAW_ARRAYS}
+    };
+    
+    std::istringstream in(line);
+    std::string name;
+    in >> name;
+    
+    auto it = ops.find(name);
+    if (it == ops.end()) {
+        return false;
+    }
+    command.op = it->second;
+    
+    auto readArgs = [&](int count) {
+        for (int i = 0; i < count; ++i) {
+            in >> command.args[i];
+        }
+    };
+    auto readValues = [&](int count) {
+        for (int i = 0; i < count; ++i) {
+            in >> command.values[i];
+        }
+    };
+    auto readData = [&](size_t bytes) {
+        std::string hash;
+        std::string hex;
+        in >> hash;
+        if (in >> hex) {
+            return decodeHex(hex, command.data) && command.data.size() == bytes;
+        }
+        in.clear();
+        return true;
+    };
+    
+    switch (command.op) {
+        case Op::BEGIN_FRAME:
+        case Op::BLEND:
+        case Op::BLEND_MODE:
+        case Op::DEPTH_TEST:
+        case Op::DEPTH_WRITE:
+        case Op::DEPTH_FUNC:
+        case Op::FRAMEBUFFER:
+        case Op::BUFFER_CREATE:
+        case Op::BUFFER_DESTROY:
+        case Op::VAO_DESTROY:
+        case Op::SHADER:
+            readArgs(1);
+            break;
+        case Op::END_FRAME:
+            break;
+        case Op::CLEAR:
+        case Op::TEXTURE:
+        case Op::UNIFORM_BUFFER:
+        case Op::DRAW_ARRAYS:
+            readArgs(2);
+            break;
+        case Op::DRAW_INDEXED:
+            readArgs(3);
+            break;
+        case Op::VIEWPORT:
+            readArgs(4);
+            break;
+        case Op::SCISSOR:
+            readArgs(5);
+            break;
+        case Op::CLEAR_COLOR:
+            readValues(4);
+            break;
+        case Op::BUFFER_UPLOAD:
+            readArgs(3);
+            if (!readData(command.args[1])) {
+                return false;
+            }
+            break;
+        case Op::BUFFER_STREAM:
+        case Op::BUFFER_UPDATE:
+            readArgs(3);
+            if (!readData(command.args[2])) {
+                return false;
+            }
+            break;
+        case Op::VAO_CREATE: {
+            readArgs(5);
+            command.layout = std::make_shared<VertexLayout>(command.args[3]);
+            for (uint64_t i = 0; i < command.args[4]; ++i) {
+                unsigned int location = 0;
+                int components = 0;
+                int type = 0;
+                int mode = 0;
+                size_t offset = 0;
+                in >> location >> components >> type >> mode >> offset;
+                command.layout->add(location, components, static_cast<VertexAttributeType>(type), offset,
+                                    static_cast<VertexAttributeMode>(mode));
+            }
+            break;
+        }
+        case Op::UNIFORM_INT:
+        case Op::UNIFORM_BOOL:
+            in >> command.args[0] >> command.name >> command.args[1];
+            break;
+        case Op::UNIFORM_VEC2:
+            in >> command.args[0] >> command.name;
+            readValues(2);
+            break;
+        case Op::UNIFORM_MAT4:
+            in >> command.args[0] >> command.name;
+            readValues(16);
+            break;
+    }
+    
+    return !in.fail();
+}
+
+void RenderCommandReplayer::execute(RenderBackend& backend, const Command& command) {
+    const uint64_t* args = command.args;
+    const float* values = command.values;
+    
+    switch (command.op) {
+        case Op::BEGIN_FRAME:
+            backend.beginFrame(args[0]);
+            break;
+        case Op::END_FRAME:
+            backend.endFrame();
+            break;
+        case Op::CLEAR:
+            backend.clear(args[0] != 0, args[1] != 0);
+            break;
+        case Op::CLEAR_COLOR:
+            backend.setClearColor(Color(values[0], values[1], values[2], values[3]));
+            break;
+        case Op::VIEWPORT:
+            backend.setViewport(static_cast<int>(args[0]), static_cast<int>(args[1]),
+                                static_cast<int>(args[2]), static_cast<int>(args[3]));
+            break;
+        case Op::BLEND:
+            backend.setBlending(args[0] != 0);
+            break;
+        case Op::BLEND_MODE:
+            backend.setBlendMode(static_cast<BlendMode>(args[0]));
+            break;
+        case Op::DEPTH_TEST:
+            backend.setDepthTest(args[0] != 0);
+            break;
+        case Op::DEPTH_WRITE:
+            backend.setDepthWrite(args[0] != 0);
+            break;
+        case Op::DEPTH_FUNC:
+            backend.setDepthFunc(static_cast<DepthFunc>(args[0]));
+            break;
+        case Op::SCISSOR:
+            backend.setScissor(args[0] != 0, static_cast<int>(args[1]), static_cast<int>(args[2]),
+                               static_cast<int>(args[3]), static_cast<int>(args[4]));
+            break;
+        case Op::FRAMEBUFFER:
+            // Offscreen framebuffers are not part of the stream; draw to the default one
+            backend.bindFramebuffer(0);
+            break;
+        case Op::BUFFER_CREATE:
+            m_buffers[args[0]] = backend.createBuffer();
+            break;
+        case Op::BUFFER_DESTROY: {
+            auto it = m_buffers.find(args[0]);
+            if (it != m_buffers.end()) {
+                backend.destroyBuffer(it->second);
+                m_buffers.erase(it);
+            }
+            break;
+        }
+        case Op::BUFFER_UPLOAD:
+        case Op::BUFFER_STREAM:
+        case Op::BUFFER_UPDATE: {
+            // Without captured contents, upload zeroes of the recorded size
+            size_t bytes = command.op == Op::BUFFER_UPLOAD ? args[1] : args[2];
+            const void* data = command.data.data();
+            if (command.data.empty()) {
+                if (m_zeroData.size() < bytes) {
+                    m_zeroData.resize(bytes, 0);
+                }
+                data = m_zeroData.data();
+            }
+            
+            if (command.op == Op::BUFFER_UPLOAD) {
+                backend.uploadBuffer(mapBuffer(args[0]), data, bytes, args[2] != 0);
+            } else if (command.op == Op::BUFFER_STREAM) {
+                backend.streamBuffer(mapBuffer(args[0]), args[1], data, bytes);
+            } else {
+                backend.updateBuffer(mapBuffer(args[0]), args[1], data, bytes);
+            }
+            break;
+        }
+        case Op::UNIFORM_BUFFER:
+            backend.bindUniformBuffer(static_cast<unsigned int>(args[0]), mapBuffer(args[1]));
+            break;
+        case Op::VAO_CREATE:
+            m_vertexArrays[args[0]] = backend.createVertexArray(*command.layout, mapBuffer(args[1]), mapBuffer(args[2]));
+            break;
+        case Op::VAO_DESTROY: {
+            auto it = m_vertexArrays.find(args[0]);
+            if (it != m_vertexArrays.end()) {
+                backend.destroyVertexArray(it->second);
+                m_vertexArrays.erase(it);
+            }
+            break;
+        }
+        case Op::SHADER:
+            m_currentShader = m_shaderResolver ? m_shaderResolver(static_cast<uint32_t>(args[0])) : nullptr;
+            if (m_currentShader) {
+                backend.bindShader(m_currentShader);
+            }
+            break;
+        case Op::UNIFORM_INT:
+            if (m_currentShader) {
+                backend.setUniform(*m_currentShader, command.name, static_cast<int>(args[1]));
+            }
+            break;
+        case Op::UNIFORM_BOOL:
+            if (m_currentShader) {
+                backend.setUniform(*m_currentShader, command.name, args[1] != 0);
+            }
+            break;
+        case Op::UNIFORM_VEC2:
+            if (m_currentShader) {
+                backend.setUniform(*m_currentShader, command.name, Vector2(values[0], values[1]));
+            }
+            break;
+        case Op::UNIFORM_MAT4:
+            if (m_currentShader) {
+                Matrix4 matrix(1.0f);
+                for (int column = 0; column < 4; ++column) {
+                    for (int row = 0; row < 4; ++row) {
+                        matrix[column][row] = values[column * 4 + row];
+                    }
+                }
+                backend.setUniform(*m_currentShader, command.name, matrix);
+            }
+            break;
+        case Op::TEXTURE:
+            backend.bindTexture(static_cast<unsigned int>(args[0]), static_cast<TextureID>(args[1]));
+            break;
+        case Op::DRAW_INDEXED:
+            backend.drawIndexed(mapVertexArray(args[0]), static_cast<uint32_t>(args[1]), static_cast<uint32_t>(args[2]));
+            break;
+        case Op::DRAW_ARRAYS:
+            backend.drawArrays(mapVertexArray(args[0]), static_cast<uint32_t>(args[1]));
+            break;
+    }
+}
+
+unsigned int RenderCommandReplayer::mapBuffer(uint64_t recorded) const {
+    auto it = m_buffers.find(recorded);
+    return it != m_buffers.end() ? it->second : 0;
+}
+
+unsigned int RenderCommandReplayer::mapVertexArray(uint64_t recorded) const {
+    auto it = m_vertexArrays.find(recorded);
+    return it != m_vertexArrays.end() ? it->second : 0;
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,206 @@
+#include "graphics/render_target.h"
+#include "utils/logger.h"
+#include <GL/glew.h>
+#include <algorithm>
+
+namespace GameEngine2D {
+
+namespace {
+
+struct GLTextureFormat {
+    GLint internalFormat;
+    GLenum format;
+    GLenum type;
+};
+
+GLTextureFormat toGLFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8:
+            return {GL_R8, GL_RED, GL_UNSIGNED_BYTE};
+        case TextureFormat::RG8:
+            return {GL_RG8, GL_RG, GL_UNSIGNED_BYTE};
+        case TextureFormat::RGBA16F:
+            return {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT};
+        case TextureFormat::RGBA32F:
+            return {GL_RGBA32F, GL_RGBA, GL_FLOAT};
+        case TextureFormat::RGBA8:
+        default:
+            return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE};
+    }
+}
+
+} // namespace
+
+RenderTarget::RenderTarget()
+    : m_framebuffer(0), m_colorTexture(0), m_depthBuffer(0), m_msaaFramebuffer(0), m_msaaColorBuffer(0) {
+}
+
+RenderTarget::~RenderTarget() {
+    destroy();
+}
+
+bool RenderTarget::create(const RenderTargetConfig& config) {
+    destroy();
+    
+    if (config.width <= 0 || config.height <= 0) {
+        LOG_ERROR_FMT("Invalid render target size: {}x{}", config.width, config.height);
+        return false;
+    }
+    
+    m_config = config;
+    GLTextureFormat glFormat = toGLFormat(config.format);
+    GLint filter = config.filter == FilterMode::NEAREST ? GL_NEAREST : GL_LINEAR;
+    
+    GLint maxSamples = 1;
+    glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+    m_config.samples = std::clamp(config.samples, 1, std::max(maxSamples, 1));
+    bool multisampled = m_config.samples > 1;
+    
+    // Color attachment
+    glGenTextures(1, &m_colorTexture);
+    glBindTexture(GL_TEXTURE_2D, m_colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, glFormat.internalFormat, config.width, config.height, 0,
+                 glFormat.format, glFormat.type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_colorTexture, 0);
+    
+    if (multisampled) {
+        if (!checkFramebuffer()) {
+            destroy();
+            return false;
+        }
+        
+        // Rendering happens in the multisampled framebuffer; the texture
+        // framebuffer above only receives resolves
+        glGenRenderbuffers(1, &m_msaaColorBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_msaaColorBuffer);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_config.samples, glFormat.internalFormat,
+                                         config.width, config.height);
+        
+        glGenFramebuffers(1, &m_msaaFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_msaaFramebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_msaaColorBuffer);
+    }
+    
+    // Depth-stencil attachment
+    if (config.depth) {
+        glGenRenderbuffers(1, &m_depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+        if (multisampled) {
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_config.samples, GL_DEPTH24_STENCIL8,
+                                             config.width, config.height);
+        } else {
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, config.width, config.height);
+        }
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    if (!checkFramebuffer()) {
+        destroy();
+        return false;
+    }
+    
+    return true;
+}
+
+bool RenderTarget::resize(int width, int height) {
+    if (isValid() && width == m_config.width && height == m_config.height) {
+        return true;
+    }
+    
+    RenderTargetConfig config = m_config;
+    config.width = width;
+    config.height = height;
+    return create(config);
+}
+
+void RenderTarget::destroy() {
+    if (m_msaaFramebuffer != 0) {
+        glDeleteFramebuffers(1, &m_msaaFramebuffer);
+        m_msaaFramebuffer = 0;
+    }
+    if (m_msaaColorBuffer != 0) {
+        glDeleteRenderbuffers(1, &m_msaaColorBuffer);
+        m_msaaColorBuffer = 0;
+    }
+    if (m_framebuffer != 0) {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+    if (m_colorTexture != 0) {
+        glDeleteTextures(1, &m_colorTexture);
+        m_colorTexture = 0;
+    }
+    if (m_depthBuffer != 0) {
+        glDeleteRenderbuffers(1, &m_depthBuffer);
+        m_depthBuffer = 0;
+    }
+}
+
+void RenderTarget::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, getFramebuffer());
+}
+
+void RenderTarget::resolve() const {
+    if (m_msaaFramebuffer == 0) {
+        return;
+    }
+    
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_msaaFramebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+    glBlitFramebuffer(0, 0, m_config.width, m_config.height, 0, 0, m_config.width, m_config.height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void RenderTarget::bindDefault() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+size_t RenderTarget::getMemoryUsage() const {
+    if (!isValid()) {
+        return 0;
+    }
+    
+    // Multisampled targets keep both the sample buffers and the resolved texture
+    size_t pixels = static_cast<size_t>(m_config.width) * m_config.height;
+    size_t samples = static_cast<size_t>(m_config.samples);
+    size_t colorBytes = pixels * getBytesPerPixel(m_config.format);
+    size_t bytes = isMultisampled() ? colorBytes * (samples + 1) : colorBytes;
+    if (m_config.depth) {
+        bytes += pixels * 4 * samples;
+    }
+    return bytes;
+}
+
+bool RenderTarget::checkFramebuffer() const {
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR_FMT("Render target framebuffer incomplete (status {})", status);
+        return false;
+    }
+    return true;
+}
+
+size_t RenderTarget::getBytesPerPixel(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8: return 1;
+        case TextureFormat::RG8: return 2;
+        case TextureFormat::RGBA16F: return 8;
+        case TextureFormat::RGBA32F: return 16;
+        case TextureFormat::RGBA8:
+        default: return 4;
+    }
+}
+
+} // namespace GameEngine2D
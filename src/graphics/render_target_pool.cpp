@@ -0,0 +1,144 @@
+#include "graphics/render_target_pool.h"
+#include "utils/logger.h"
+#include <algorithm>
+
+namespace GameEngine2D {
+
+RenderTargetPool::RenderTargetPool(int maxUnusedFrames)
+    : m_frame(0), m_maxUnusedFrames(maxUnusedFrames) {
+}
+
+RenderTargetPool::~RenderTargetPool() {
+    clear();
+}
+
+void RenderTargetPool::beginFrame() {
+    m_frame++;
+    m_stats.allocations = 0;
+    m_stats.reuses = 0;
+    m_stats.frees = 0;
+}
+
+void RenderTargetPool::endFrame() {
+    for (auto& entry : m_entries) {
+        entry->inUse = false;
+    }
+    
+    // Free targets that no pass has asked for in a while, e.g. after a
+    // resize or once an effect is switched off
+    size_t before = m_entries.size();
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [this](const std::unique_ptr<Entry>& entry) {
+            return m_frame - entry->lastUsedFrame > static_cast<uint64_t>(m_maxUnusedFrames);
+        }), m_entries.end());
+    m_stats.frees += static_cast<uint32_t>(before - m_entries.size());
+    
+    updateStats();
+}
+
+RenderTarget* RenderTargetPool::acquire(const RenderTargetConfig& config) {
+    RenderTargetConfig key = config;
+    key.samples = std::max(key.samples, 1);
+    
+    for (auto& entry : m_entries) {
+        if (!entry->inUse && entry->key == key) {
+            entry->inUse = true;
+            entry->lastUsedFrame = m_frame;
+            m_stats.reuses++;
+            updateStats();
+            return &entry->target;
+        }
+    }
+    
+    auto entry = std::make_unique<Entry>();
+    if (!entry->target.create(key)) {
+        LOG_ERROR_FMT("Failed to allocate pooled render target {}x{}", key.width, key.height);
+        return nullptr;
+    }
+    
+    // Keyed on the requested config; the driver may clamp the sample count
+    entry->key = key;
+    entry->inUse = true;
+    entry->lastUsedFrame = m_frame;
+    m_stats.allocations++;
+    
+    RenderTarget* target = &entry->target;
+    m_entries.push_back(std::move(entry));
+    updateStats();
+    return target;
+}
+
+RenderTarget* RenderTargetPool::acquire(int width, int height, TextureFormat format, int samples) {
+    RenderTargetConfig config;
+    config.width = width;
+    config.height = height;
+    config.format = format;
+    config.samples = samples;
+    return acquire(config);
+}
+
+void RenderTargetPool::release(RenderTarget* target) {
+    if (!target) {
+        return;
+    }
+    
+    for (auto& entry : m_entries) {
+        if (&entry->target == target) {
+            entry->inUse = false;
+            updateStats();
+            return;
+        }
+    }
+    
+    LOG_WARNING("Released a render target that does not belong to the pool");
+}
+
+void RenderTargetPool::trim() {
+    size_t before = m_entries.size();
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [](const std::unique_ptr<Entry>& entry) { return !entry->inUse; }), m_entries.end());
+    m_stats.frees += static_cast<uint32_t>(before - m_entries.size());
+    updateStats();
+}
+
+void RenderTargetPool::clear() {
+    m_entries.clear();
+    updateStats();
+}
+
+size_t RenderTargetPool::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& entry : m_entries) {
+        bytes += entry->target.getMemoryUsage();
+    }
+    return bytes;
+}
+
+void RenderTargetPool::updateStats() {
+    m_stats.targets = static_cast<uint32_t>(m_entries.size());
+    m_stats.inUse = static_cast<uint32_t>(std::count_if(m_entries.begin(), m_entries.end(),
+        [](const std::unique_ptr<Entry>& entry) { return entry->inUse; }));
+    m_stats.memoryBytes = getMemoryUsage();
+}
+
+// PingPongTarget implementation
+PingPongTarget::PingPongTarget(RenderTargetPool& pool, const RenderTargetConfig& config)
+    : m_pool(pool), m_targets{nullptr, nullptr}, m_current(0) {
+    m_targets[0] = m_pool.acquire(config);
+    m_targets[1] = m_pool.acquire(config);
+}
+
+PingPongTarget::~PingPongTarget() {
+    release();
+}
+
+void PingPongTarget::release() {
+    for (auto& target : m_targets) {
+        if (target) {
+            m_pool.release(target);
+            target = nullptr;
+        }
+    }
+}
+
+} // namespace GameEngine2D
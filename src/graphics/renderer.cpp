@@ -1,10 +1,30 @@
 #include "graphics/renderer.h"
+#include "graphics/gl_render_backend.h"
+#include "graphics/render_target.h"
+#include "graphics/shader.h"
+#include "graphics/vertex_layout.h"
 #include "utils/logger.h"
-#include <GL/glew.h>
+#include <algorithm>
 
 namespace GameEngine2D {
 
-Renderer::Renderer() {
+namespace {
+const UniformHandle U_UV_SCALE("uUVScale");
+const UniformHandle U_UV_MAX("uUVMax");
+const UniformHandle U_TEXTURE("uTexture");
+}
+
+Renderer::Renderer(std::unique_ptr<RenderBackend> backend)
+    : m_backend(std::move(backend)), m_initialized(false), m_inFrame(false), m_timerQueriesSupported(false),
+      m_frameIndex(0), m_passDepth(0), m_dynamicResolutionEnabled(false),
+      m_sceneTarget(nullptr), m_blitVAO(0), m_outputWidth(0), m_outputHeight(0), m_frameScale(1.0f),
+      m_renderingOffscreen(false), m_lastSampledGPUFrame(0),
+      m_blendingEnabled(true), m_depthTestEnabled(true), m_depthWriteEnabled(true), m_depthFunc(DepthFunc::LESS),
+      m_blendMode(BlendMode::ALPHA),
+      m_clearColor(0.2f, 0.3f, 0.3f, 1.0f) {
+    if (!m_backend) {
+        m_backend = std::make_unique<GLRenderBackend>();
+    }
 }
 
 Renderer::~Renderer() {
@@ -12,64 +32,448 @@ Renderer::~Renderer() {
 }
 
 bool Renderer::initialize() {
-    // Set initial OpenGL state
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_MULTISAMPLE);
+    // The backend sets up its default state: alpha blending and depth testing
+    if (!m_backend->initialize()) {
+        LOG_ERROR("Failed to initialize render backend");
+        return false;
+    }
     
-    // Set clear color
-    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+    m_timerQueriesSupported = m_backend->supportsTimerQueries();
+    m_blendingEnabled = true;
+    m_depthTestEnabled = true;
+    m_depthWriteEnabled = true;
+    m_depthFunc = DepthFunc::LESS;
+    m_blendMode = BlendMode::ALPHA;
+    m_backend->setClearColor(m_clearColor);
     
+    if (!m_sharedUniforms.initialize(*m_backend)) {
+        LOG_WARNING("Shared uniform buffers unavailable, shaders using FrameData or CameraData will not draw");
+    }
+    m_initializeTime = std::chrono::high_resolution_clock::now();
+    m_frameStartTime = m_initializeTime;
+    
+    m_initialized = true;
     LOG_INFO("Renderer initialized");
     return true;
 }
 
 void Renderer::shutdown() {
+    if (!m_initialized) {
+        return;
+    }
+    
+    m_frameCapture.shutdown();
+    m_sharedUniforms.shutdown();
+    destroyQueries();
+    destroySceneTarget();
+    m_renderTargetPool.clear();
+    m_backend->shutdown();
+    m_initialized = false;
     LOG_INFO("Renderer shutdown");
 }
 
+void Renderer::beginFrame() {
+    if (m_inFrame) {
+        LOG_WARNING("Renderer::beginFrame called twice without endFrame");
+        return;
+    }
+    
+    m_inFrame = true;
+    m_frameIndex++;
+    TimePoint previousFrameStart = m_frameStartTime;
+    m_frameStartTime = std::chrono::high_resolution_clock::now();
+    
+    m_currentStats = RenderStats{};
+    m_currentStats.frameIndex = m_frameIndex;
+    m_backend->beginFrame(m_frameIndex);
+    Shader::resetUploadStats();
+    
+    // Reuse the query set from two frames ago; if the GPU still hasn't
+    // finished it, drop those timings rather than stall
+    QuerySet& set = currentQuerySet();
+    if (set.pending && !collectQueryResults(set)) {
+        set.pending = false;
+    }
+    set.passes.clear();
+    set.frameIndex = m_frameIndex;
+    
+    m_renderTargetPool.beginFrame();
+    
+    // The scale chosen at the end of the previous frame applies to this one
+    m_renderingOffscreen = m_dynamicResolutionEnabled && prepareSceneTarget();
+    m_frameScale = m_renderingOffscreen ? m_dynamicResolution.getScale() : 1.0f;
+    m_currentStats.resolutionScale = m_frameScale;
+    if (m_renderingOffscreen) {
+        m_backend->bindFramebuffer(m_sceneTarget->getFramebuffer());
+        setViewport(0, 0, getRenderWidth(), getRenderHeight());
+    }
+    
+    FrameUniforms frame;
+    frame.screenSize = Vector2(static_cast<float>(m_outputWidth), static_cast<float>(m_outputHeight));
+    frame.renderSize = Vector2(static_cast<float>(getRenderWidth()), static_cast<float>(getRenderHeight()));
+    frame.time = std::chrono::duration<float>(m_frameStartTime - m_initializeTime).count();
+    frame.deltaTime = std::chrono::duration<float>(m_frameStartTime - previousFrameStart).count();
+    recordBufferUpload(m_sharedUniforms.updateFrame(frame));
+}
+
+void Renderer::setCamera(const Matrix4& view, const Matrix4& projection, const Vector2& position, float zoom) {
+    CameraUniforms camera;
+    camera.view = view;
+    camera.projection = projection;
+    camera.viewProjection = projection * view;
+    camera.position = position;
+    camera.zoom = zoom;
+    
+    size_t bytes = m_sharedUniforms.updateCamera(camera);
+    if (bytes > 0) {
+        recordBufferUpload(bytes);
+        recordStateChange();
+    }
+}
+
+void Renderer::endFrame() {
+    if (!m_inFrame) {
+        LOG_WARNING("Renderer::endFrame called without beginFrame");
+        return;
+    }
+    
+    while (m_passDepth > 0) {
+        LOG_WARNING("Render pass left open at end of frame");
+        endPass();
+    }
+    
+    QuerySet& set = currentQuerySet();
+    set.pending = !set.passes.empty();
+    
+    // Results of the previous frame are usually ready by now
+    QuerySet& previous = m_querySets[(m_frameIndex + 1) % QUERY_BUFFER_COUNT];
+    if (previous.pending) {
+        collectQueryResults(previous);
+    }
+    
+    auto frameDuration = std::chrono::high_resolution_clock::now() - m_frameStartTime;
+    m_currentStats.cpuTimeMs = std::chrono::duration<float, std::milli>(frameDuration).count();
+    m_currentStats.uniformUploads = Shader::getUploadStats().issued;
+    m_currentStats.uniformUploadsSkipped = Shader::getUploadStats().skipped;
+    
+    // Fill cost shows up in GPU time; without timer queries the CPU time of
+    // the frame is the best available approximation
+    if (m_dynamicResolutionEnabled) {
+        if (m_timerQueriesSupported) {
+            if (m_frameStats.gpuTimeValid && m_frameStats.gpuFrameIndex != m_lastSampledGPUFrame) {
+                m_dynamicResolution.addFrameTime(m_frameStats.gpuTimeMs);
+                m_lastSampledGPUFrame = m_frameStats.gpuFrameIndex;
+            }
+        } else {
+            m_dynamicResolution.addFrameTime(m_currentStats.cpuTimeMs);
+        }
+        m_dynamicResolution.update();
+    }
+    
+    if (m_renderingOffscreen) {
+        LOG_WARNING("Frame ended without present, offscreen scene was not upscaled");
+        m_backend->bindFramebuffer(0);
+        m_renderingOffscreen = false;
+    }
+    
+    // Transient targets go back to the pool; long-unused ones are freed
+    m_sceneTarget = nullptr;
+    m_renderTargetPool.endFrame();
+    m_currentStats.renderTargets = m_renderTargetPool.getStats().targets;
+    m_currentStats.renderTargetMemoryBytes = m_renderTargetPool.getStats().memoryBytes;
+    
+    // Publish CPU counters for this frame together with the latest GPU timings
+    m_currentStats.gpuTimeValid = m_frameStats.gpuTimeValid;
+    m_currentStats.gpuFrameIndex = m_frameStats.gpuFrameIndex;
+    m_currentStats.gpuTimeMs = m_frameStats.gpuTimeMs;
+    m_currentStats.passes = std::move(m_frameStats.passes);
+    m_frameStats = std::move(m_currentStats);
+    
+    m_backend->endFrame();
+    m_inFrame = false;
+    
+    if (m_statsCallback) {
+        m_statsCallback(m_frameStats);
+    }
+}
+
+void Renderer::beginPass(const std::string& name) {
+    // GL_TIME_ELAPSED queries cannot nest, so only the outermost pass is timed
+    if (m_passDepth++ > 0 || !m_inFrame || !m_timerQueriesSupported) {
+        return;
+    }
+    
+    QuerySet& set = currentQuerySet();
+    size_t index = set.passes.size();
+    if (index >= set.queries.size()) {
+        set.queries.push_back(m_backend->createQuery());
+    }
+    
+    PassQuery pass;
+    pass.name = name;
+    pass.query = set.queries[index];
+    set.passes.push_back(pass);
+    
+    m_backend->beginTimerQuery(pass.query);
+}
+
+void Renderer::endPass() {
+    if (m_passDepth == 0) {
+        LOG_WARNING("Renderer::endPass called without beginPass");
+        return;
+    }
+    
+    if (--m_passDepth > 0 || !m_inFrame || !m_timerQueriesSupported) {
+        return;
+    }
+    
+    m_backend->endTimerQuery();
+}
+
 void Renderer::clear() {
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_backend->clear(true, true);
 }
 
 void Renderer::setViewport(int x, int y, int width, int height) {
-    glViewport(x, y, width, height);
+    m_backend->setViewport(x, y, width, height);
+    recordStateChange();
 }
 
 void Renderer::present() {
-    // Present is handled by window swap buffers
+    // Buffer swap is handled by the window; only the upscale and frame
+    // capture happen here
+    if (m_renderingOffscreen) {
+        beginPass("upscale");
+        upscaleSceneTarget();
+        endPass();
+        m_renderTargetPool.release(m_sceneTarget);
+        m_sceneTarget = nullptr;
+        m_renderingOffscreen = false;
+    }
+    
+    if (m_frameCapture.isActive() && m_backend->getType() == RenderBackendType::OPENGL) {
+        m_frameCapture.onPresent(m_frameIndex, m_outputWidth, m_outputHeight);
+    }
 }
 
 void Renderer::setClearColor(const Color& color) {
-    glClearColor(color.r, color.g, color.b, color.a);
+    m_backend->setClearColor(color);
+    m_clearColor = color;
+    recordStateChange();
 }
 
 void Renderer::enableBlending(bool enable) {
-    if (enable) {
-        glEnable(GL_BLEND);
+    m_backend->setBlending(enable);
+    m_blendingEnabled = enable;
+    recordStateChange();
+}
+
+void Renderer::enableDepthTest(bool enable) {
+    m_backend->setDepthTest(enable);
+    m_depthTestEnabled = enable;
+    recordStateChange();
+}
+
+void Renderer::enableDepthWrite(bool enable) {
+    m_backend->setDepthWrite(enable);
+    m_depthWriteEnabled = enable;
+    recordStateChange();
+}
+
+void Renderer::setDepthFunc(DepthFunc func) {
+    m_backend->setDepthFunc(func);
+    m_depthFunc = func;
+    recordStateChange();
+}
+
+void Renderer::setBlendMode(BlendMode mode) {
+    m_backend->setBlendMode(mode);
+    m_blendMode = mode;
+    recordStateChange();
+}
+
+void Renderer::bindRenderTarget(RenderTarget* target) {
+    if (target) {
+        m_backend->bindFramebuffer(target->getFramebuffer());
+        setViewport(0, 0, target->getWidth(), target->getHeight());
+    } else if (m_renderingOffscreen) {
+        m_backend->bindFramebuffer(m_sceneTarget->getFramebuffer());
+        setViewport(0, 0, getRenderWidth(), getRenderHeight());
     } else {
-        glDisable(GL_BLEND);
+        m_backend->bindFramebuffer(0);
+        if (m_outputWidth > 0 && m_outputHeight > 0) {
+            setViewport(0, 0, m_outputWidth, m_outputHeight);
+        }
     }
 }
 
-void Renderer::setBlendMode(BlendMode mode) {
-    switch (mode) {
-        case BlendMode::ALPHA:
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            break;
-        case BlendMode::ADDITIVE:
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-            break;
-        case BlendMode::MULTIPLY:
-            glBlendFunc(GL_DST_COLOR, GL_ZERO);
-            break;
-        case BlendMode::SCREEN:
-            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_COLOR);
-            break;
-        default:
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            break;
+void Renderer::setOutputSize(int width, int height) {
+    m_outputWidth = std::max(width, 1);
+    m_outputHeight = std::max(height, 1);
+    
+    if (!m_renderingOffscreen) {
+        setViewport(0, 0, m_outputWidth, m_outputHeight);
+    }
+}
+
+int Renderer::getRenderWidth() const {
+    return std::max(1, static_cast<int>(m_outputWidth * getResolutionScale() + 0.5f));
+}
+
+int Renderer::getRenderHeight() const {
+    return std::max(1, static_cast<int>(m_outputHeight * getResolutionScale() + 0.5f));
+}
+
+void Renderer::enableDynamicResolution(bool enable) {
+    if (enable == m_dynamicResolutionEnabled) {
+        return;
+    }
+    
+    m_dynamicResolutionEnabled = enable;
+    m_dynamicResolution.reset();
+    m_lastSampledGPUFrame = m_frameStats.gpuFrameIndex;
+    
+    if (!enable) {
+        destroySceneTarget();
+    }
+    LOG_INFO_FMT("Dynamic resolution {}", enable ? "enabled" : "disabled");
+}
+
+void Renderer::recordDrawCall(uint32_t vertexCount, uint32_t instanceCount) {
+    m_currentStats.drawCalls++;
+    m_currentStats.vertices += static_cast<uint64_t>(vertexCount) * instanceCount;
+    m_currentStats.instances += instanceCount;
+}
+
+bool Renderer::collectQueryResults(QuerySet& set) {
+    if (set.passes.empty()) {
+        set.pending = false;
+        return true;
+    }
+    
+    // Queries complete in submission order, so checking the last one is enough
+    if (!m_backend->isQueryResultAvailable(set.passes.back().query)) {
+        return false;
+    }
+    
+    m_frameStats.passes.clear();
+    m_frameStats.gpuTimeMs = 0.0f;
+    
+    for (const auto& pass : set.passes) {
+        uint64_t elapsed = m_backend->getQueryResult(pass.query);
+        
+        RenderPassTiming timing;
+        timing.name = pass.name;
+        timing.gpuTimeMs = static_cast<float>(elapsed) / 1000000.0f;
+        m_frameStats.gpuTimeMs += timing.gpuTimeMs;
+        m_frameStats.passes.push_back(timing);
+    }
+    
+    m_frameStats.gpuTimeValid = true;
+    m_frameStats.gpuFrameIndex = set.frameIndex;
+    set.pending = false;
+    return true;
+}
+
+bool Renderer::prepareSceneTarget() {
+    // Render targets are GL objects; other backends render at full scale
+    if (m_outputWidth <= 0 || m_outputHeight <= 0 || m_backend->getType() != RenderBackendType::OPENGL) {
+        return false;
+    }
+    
+    if (!m_blitShader) {
+        m_blitShader = ShaderManager::getInstance().getShader("blit");
+        if (!m_blitShader) {
+            m_blitShader = ShaderManager::getInstance().createBlitShader();
+        }
+    }
+    
+    // Draw straight to the default framebuffer until the blit program has
+    // linked; the offscreen target could not be presented before that
+    if (m_blitShader && !m_blitShader->pollCompile() && m_blitShader->getStatus() == ShaderStatus::COMPILING) {
+        return false;
+    }
+    if (!m_blitShader || m_blitShader->getStatus() == ShaderStatus::FAILED) {
+        LOG_ERROR("Failed to create blit shader, dynamic resolution disabled");
+        m_blitShader.reset();
+        m_dynamicResolutionEnabled = false;
+        return false;
+    }
+    
+    if (m_blitVAO == 0) {
+        // Core profile requires a bound VAO even for attribute-less draws
+        m_blitVAO = m_backend->createVertexArray(VertexLayout(), 0, 0);
+    }
+    
+    // The target always matches the output size and the scene is drawn into
+    // its lower-left corner, so scale changes never need a different target
+    RenderTargetConfig config;
+    config.width = m_outputWidth;
+    config.height = m_outputHeight;
+    config.filter = FilterMode::LINEAR;
+    config.depth = true;
+    
+    m_sceneTarget = m_renderTargetPool.acquire(config);
+    if (!m_sceneTarget) {
+        LOG_ERROR("Failed to acquire scene render target, dynamic resolution disabled");
+        m_dynamicResolutionEnabled = false;
+        return false;
+    }
+    return true;
+}
+
+void Renderer::upscaleSceneTarget() {
+    // A shader draw rather than glBlitFramebuffer: the default framebuffer is
+    // multisampled, and blitting into a multisampled buffer is not allowed
+    m_backend->bindFramebuffer(0);
+    setViewport(0, 0, m_outputWidth, m_outputHeight);
+    
+    bool depthTest = m_depthTestEnabled;
+    bool blending = m_blendingEnabled;
+    m_backend->setDepthTest(false);
+    m_backend->setBlending(false);
+    
+    float renderWidth = static_cast<float>(getRenderWidth());
+    float renderHeight = static_cast<float>(getRenderHeight());
+    float targetWidth = static_cast<float>(m_sceneTarget->getWidth());
+    float targetHeight = static_cast<float>(m_sceneTarget->getHeight());
+    
+    if (m_backend->bindShader(m_blitShader.get())) {
+        m_backend->setUniform(*m_blitShader, U_UV_SCALE, Vector2(renderWidth / targetWidth, renderHeight / targetHeight));
+        m_backend->setUniform(*m_blitShader, U_UV_MAX,
+                              Vector2((renderWidth - 0.5f) / targetWidth, (renderHeight - 0.5f) / targetHeight));
+        m_backend->setUniform(*m_blitShader, U_TEXTURE, 0);
+        
+        m_backend->bindTexture(0, m_sceneTarget->getColorTexture());
+        recordTextureBind();
+        
+        m_backend->drawArrays(m_blitVAO, 3);
+        recordDrawCall(3);
+    }
+    
+    m_backend->setDepthTest(depthTest);
+    m_backend->setBlending(blending);
+}
+
+void Renderer::destroySceneTarget() {
+    m_renderTargetPool.release(m_sceneTarget);
+    m_sceneTarget = nullptr;
+    m_blitShader.reset();
+    if (m_blitVAO != 0) {
+        m_backend->destroyVertexArray(m_blitVAO);
+        m_blitVAO = 0;
+    }
+    m_renderingOffscreen = false;
+}
+
+void Renderer::destroyQueries() {
+    for (auto& set : m_querySets) {
+        for (unsigned int query : set.queries) {
+            m_backend->destroyQuery(query);
+        }
+        set.queries.clear();
+        set.passes.clear();
+        set.pending = false;
     }
 }
 
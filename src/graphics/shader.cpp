@@ -1,14 +1,120 @@
 #include "graphics/shader.h"
+#include "graphics/program_binary_cache.h"
 #include "utils/logger.h"
 #include "utils/file_utils.h"
+#include "utils/hash_utils.h"
 #include <GL/glew.h>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
 
 namespace GameEngine2D {
 
-Shader::Shader() : m_programID(0) {
+namespace {
+
+const char* const SHARED_BLOCKS_INCLUDE = "engine/shared_blocks.glsl";
+
+// Vertex stage for the 36-byte Vertex format used by the basic shaders
+const char* const SPRITE_VERTEX_SOURCE = R"(
+    #version 330 core
+    #include "engine/shared_blocks.glsl"
+    layout (location = 0) in vec3 aPosition;
+    layout (location = 1) in vec2 aTexCoord;
+    layout (location = 2) in vec4 aColor;
+    
+    uniform mat4 uModel;
+    
+    out vec2 TexCoord;
+    out vec4 Color;
+    
+    void main() {
+        gl_Position = uProjection * uView * uModel * vec4(aPosition, 1.0);
+        TexCoord = aTexCoord;
+        Color = aColor;
+    }
+)";
+
+// Vertex stage for PackedVertex: the UVs and color arrive normalized, and
+// depth is a half float carried outside the 2D position
+const char* const PACKED_VERTEX_SOURCE = R"(
+    #version 330 core
+    #include "engine/shared_blocks.glsl"
+    layout (location = 0) in vec2 aPosition;
+    layout (location = 1) in vec2 aTexCoord;
+    layout (location = 2) in vec4 aColor;
+    layout (location = 3) in float aDepth;
+    
+    uniform mat4 uModel;
+    
+    out vec2 TexCoord;
+    out vec4 Color;
+    
+    void main() {
+        gl_Position = uProjection * uView * uModel * vec4(aPosition, aDepth, 1.0);
+        TexCoord = aTexCoord;
+        Color = aColor;
+    }
+)";
+
+// Vertex color, optionally modulated by a texture. USE_TEXTURE is a define
+// rather than a uniform so untextured batches don't pay for the sampler
+const char* const SPRITE_FRAGMENT_SOURCE = R"(
+    #version 330 core
+    in vec2 TexCoord;
+    in vec4 Color;
+    
+    #ifdef USE_TEXTURE
+    uniform sampler2D uTexture;
+    #endif
+    
+    out vec4 FragColor;
+    
+    void main() {
+    #ifdef USE_TEXTURE
+        FragColor = texture(uTexture, TexCoord) * Color;
+    #else
+        FragColor = Color;
+    #endif
+    }
+)";
+
+constexpr uint32_t MAX_FAMILY_DEFINES = 32;
+
+// Bytes the setters pass per element of a uniform of the given GL type;
+// 0 for types no setter writes, which are left out of the value mirror
+size_t getUniformElementBytes(GLenum type) {
+    switch (type) {
+        case GL_FLOAT:
+        case GL_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_CUBE:
+            return 4;
+        case GL_FLOAT_VEC2:
+            return 8;
+        case GL_FLOAT_VEC3:
+            return 12;
+        case GL_FLOAT_VEC4:
+            return 16;
+        case GL_FLOAT_MAT3:
+            return 36;
+        case GL_FLOAT_MAT4:
+            return 64;
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+UniformUploadStats Shader::s_uploadStats;
+
+Shader::Shader()
+    : m_programID(0), m_status(ShaderStatus::EMPTY), m_pendingVertex(0), m_pendingFragment(0),
+      m_cacheKey(0), m_storeBinary(false), m_uniformBlocks(0), m_defineMask(0) {
 }
 
 Shader::~Shader() {
@@ -28,46 +134,123 @@ bool Shader::loadFromFile(const std::string& vertexPath, const std::string& frag
 }
 
 bool Shader::loadFromSource(const std::string& vertexSource, const std::string& fragmentSource) {
-    // Compile vertex shader
-    unsigned int vertexShader = compileShader(vertexSource, GL_VERTEX_SHADER);
-    if (vertexShader == 0) {
-        LOG_ERROR("Failed to compile vertex shader");
-        return false;
+    return compileAsync(vertexSource, fragmentSource) && finishCompile();
+}
+
+bool Shader::compileAsync(const std::string& vertexSource, const std::string& fragmentSource) {
+    destroy();
+    
+    // A cached binary for these exact sources and this driver skips
+    // compilation and linking altogether
+    ProgramBinaryCache& binaryCache = ProgramBinaryCache::getInstance();
+    m_storeBinary = binaryCache.isEnabled();
+    m_cacheKey = m_storeBinary ? binaryCache.computeKey(vertexSource, fragmentSource) : 0;
+    if (m_storeBinary) {
+        unsigned int program = binaryCache.load(m_cacheKey);
+        if (program != 0) {
+            m_programID = program;
+            m_storeBinary = false;
+            onProgramLinked();
+            LOG_INFO("Shader program loaded from binary cache");
+            return true;
+        }
     }
     
-    // Compile fragment shader
-    unsigned int fragmentShader = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
-    if (fragmentShader == 0) {
-        LOG_ERROR("Failed to compile fragment shader");
-        glDeleteShader(vertexShader);
+    // Compile and link without asking for status, which would make the
+    // driver finish the work right here; finishCompile collects the result
+    m_pendingVertex = compileShader(vertexSource, GL_VERTEX_SHADER);
+    m_pendingFragment = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
+    if (m_pendingVertex == 0 || m_pendingFragment == 0) {
+        LOG_ERROR("Failed to create shader objects");
+        releasePendingStages();
+        m_status = ShaderStatus::FAILED;
         return false;
     }
     
-    // Link program
-    if (!linkProgram(vertexShader, fragmentShader)) {
-        LOG_ERROR("Failed to link shader program");
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
+    linkProgram(m_pendingVertex, m_pendingFragment);
+    m_status = ShaderStatus::COMPILING;
+    return true;
+}
+
+bool Shader::pollCompile() {
+    if (m_status != ShaderStatus::COMPILING) {
+        return m_status == ShaderStatus::READY;
+    }
+    
+    // Without the extension there is no way to ask without waiting
+    if (GLEW_KHR_parallel_shader_compile) {
+        int complete = GL_FALSE;
+        glGetProgramiv(m_programID, GL_COMPLETION_STATUS_KHR, &complete);
+        if (complete != GL_TRUE) {
+            return false;
+        }
+    }
+    return finishCompile();
+}
+
+bool Shader::finishCompile() {
+    if (m_status != ShaderStatus::COMPILING) {
+        return m_status == ShaderStatus::READY;
+    }
+    
+    int linked = GL_FALSE;
+    glGetProgramiv(m_programID, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        // A stage that failed to compile explains the link failure best
+        bool vertexCompiled = checkCompileStatus(m_pendingVertex, "vertex");
+        bool fragmentCompiled = checkCompileStatus(m_pendingFragment, "fragment");
+        if (vertexCompiled && fragmentCompiled) {
+            LOG_ERROR_FMT("Shader program linking failed: {}", getProgramInfoLog(m_programID));
+        }
+        releasePendingStages();
+        glDeleteProgram(m_programID);
+        m_programID = 0;
+        m_status = ShaderStatus::FAILED;
         return false;
     }
     
-    // Clean up shaders
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    releasePendingStages();
+    onProgramLinked();
     
-    // Introspect the program
-    introspectProgram();
+    if (m_storeBinary) {
+        ProgramBinaryCache::getInstance().store(m_cacheKey, m_programID);
+        m_storeBinary = false;
+    }
     
     LOG_INFO("Shader program created successfully");
     return true;
 }
 
+void Shader::onProgramLinked() {
+    introspectProgram();
+    introspectUniformBlocks();
+    m_status = ShaderStatus::READY;
+}
+
+void Shader::releasePendingStages() {
+    if (m_pendingVertex != 0) {
+        glDeleteShader(m_pendingVertex);
+        m_pendingVertex = 0;
+    }
+    if (m_pendingFragment != 0) {
+        glDeleteShader(m_pendingFragment);
+        m_pendingFragment = 0;
+    }
+}
+
 void Shader::destroy() {
+    releasePendingStages();
+    m_status = ShaderStatus::EMPTY;
+    m_storeBinary = false;
     if (m_programID != 0) {
         glDeleteProgram(m_programID);
         m_programID = 0;
         m_uniformCache.clear();
         m_attributeCache.clear();
+        m_handleLocations.clear();
+        m_uniformMirror.clear();
+        m_uniformValues.clear();
+        m_uniformBlocks = 0;
     }
 }
 
@@ -83,49 +266,49 @@ void Shader::unbind() const {
 
 void Shader::setUniform(const std::string& name, int value) {
     int location = getCachedUniformLocation(name);
-    if (location != -1) {
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
         glUniform1i(location, value);
     }
 }
 
 void Shader::setUniform(const std::string& name, float value) {
     int location = getCachedUniformLocation(name);
-    if (location != -1) {
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
         glUniform1f(location, value);
     }
 }
 
 void Shader::setUniform(const std::string& name, const Vector2& value) {
     int location = getCachedUniformLocation(name);
-    if (location != -1) {
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
         glUniform2f(location, value.x, value.y);
     }
 }
 
 void Shader::setUniform(const std::string& name, const Vector3& value) {
     int location = getCachedUniformLocation(name);
-    if (location != -1) {
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
         glUniform3f(location, value.x, value.y, value.z);
     }
 }
 
 void Shader::setUniform(const std::string& name, const Vector4& value) {
     int location = getCachedUniformLocation(name);
-    if (location != -1) {
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
         glUniform4f(location, value.x, value.y, value.z, value.w);
     }
 }
 
 void Shader::setUniform(const std::string& name, const Matrix3& value) {
     int location = getCachedUniformLocation(name);
-    if (location != -1) {
+    if (location != -1 && updateMirror(location, glm::value_ptr(value), sizeof(value))) {
         glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
     }
 }
 
 void Shader::setUniform(const std::string& name, const Matrix4& value) {
     int location = getCachedUniformLocation(name);
-    if (location != -1) {
+    if (location != -1 && updateMirror(location, glm::value_ptr(value), sizeof(value))) {
         glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
     }
 }
@@ -140,35 +323,40 @@ void Shader::setUniform(const std::string& name, bool value) {
 
 void Shader::setUniform(const std::string& name, const std::vector<int>& values) {
     int location = getCachedUniformLocation(name);
-    if (location != -1 && !values.empty()) {
+    if (location != -1 && !values.empty() &&
+        updateMirror(location, values.data(), sizeof(values[0]), values.size())) {
         glUniform1iv(location, static_cast<GLsizei>(values.size()), values.data());
     }
 }
 
 void Shader::setUniform(const std::string& name, const std::vector<float>& values) {
     int location = getCachedUniformLocation(name);
-    if (location != -1 && !values.empty()) {
+    if (location != -1 && !values.empty() &&
+        updateMirror(location, values.data(), sizeof(values[0]), values.size())) {
         glUniform1fv(location, static_cast<GLsizei>(values.size()), values.data());
     }
 }
 
 void Shader::setUniform(const std::string& name, const std::vector<Vector2>& values) {
     int location = getCachedUniformLocation(name);
-    if (location != -1 && !values.empty()) {
+    if (location != -1 && !values.empty() &&
+        updateMirror(location, values.data(), sizeof(values[0]), values.size())) {
         glUniform2fv(location, static_cast<GLsizei>(values.size()), reinterpret_cast<const float*>(values.data()));
     }
 }
 
 void Shader::setUniform(const std::string& name, const std::vector<Vector3>& values) {
     int location = getCachedUniformLocation(name);
-    if (location != -1 && !values.empty()) {
+    if (location != -1 && !values.empty() &&
+        updateMirror(location, values.data(), sizeof(values[0]), values.size())) {
         glUniform3fv(location, static_cast<GLsizei>(values.size()), reinterpret_cast<const float*>(values.data()));
     }
 }
 
 void Shader::setUniform(const std::string& name, const std::vector<Vector4>& values) {
     int location = getCachedUniformLocation(name);
-    if (location != -1 && !values.empty()) {
+    if (location != -1 && !values.empty() &&
+        updateMirror(location, values.data(), sizeof(values[0]), values.size())) {
         glUniform4fv(location, static_cast<GLsizei>(values.size()), reinterpret_cast<const float*>(values.data()));
     }
 }
@@ -177,10 +365,67 @@ void Shader::setUniform(const std::string& name, int textureUnit) {
     setUniform(name, textureUnit);
 }
 
+void Shader::setUniform(UniformHandle handle, int value) {
+    int location = getHandleLocation(handle);
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
+        glUniform1i(location, value);
+    }
+}
+
+void Shader::setUniform(UniformHandle handle, float value) {
+    int location = getHandleLocation(handle);
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
+        glUniform1f(location, value);
+    }
+}
+
+void Shader::setUniform(UniformHandle handle, const Vector2& value) {
+    int location = getHandleLocation(handle);
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
+        glUniform2f(location, value.x, value.y);
+    }
+}
+
+void Shader::setUniform(UniformHandle handle, const Vector3& value) {
+    int location = getHandleLocation(handle);
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
+        glUniform3f(location, value.x, value.y, value.z);
+    }
+}
+
+void Shader::setUniform(UniformHandle handle, const Vector4& value) {
+    int location = getHandleLocation(handle);
+    if (location != -1 && updateMirror(location, &value, sizeof(value))) {
+        glUniform4f(location, value.x, value.y, value.z, value.w);
+    }
+}
+
+void Shader::setUniform(UniformHandle handle, const Matrix3& value) {
+    int location = getHandleLocation(handle);
+    if (location != -1 && updateMirror(location, glm::value_ptr(value), sizeof(value))) {
+        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+}
+
+void Shader::setUniform(UniformHandle handle, const Matrix4& value) {
+    int location = getHandleLocation(handle);
+    if (location != -1 && updateMirror(location, glm::value_ptr(value), sizeof(value))) {
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+}
+
+void Shader::setUniform(UniformHandle handle, bool value) {
+    setUniform(handle, value ? 1 : 0);
+}
+
 int Shader::getUniformLocation(const std::string& name) const {
     return getCachedUniformLocation(name);
 }
 
+int Shader::getUniformLocation(UniformHandle handle) {
+    return getHandleLocation(handle);
+}
+
 int Shader::getAttributeLocation(const std::string& name) const {
     return getCachedAttributeLocation(name);
 }
@@ -203,40 +448,32 @@ std::vector<std::string> Shader::getAttributeNames() const {
 
 unsigned int Shader::compileShader(const std::string& source, unsigned int type) {
     unsigned int shader = glCreateShader(type);
+    if (shader == 0) {
+        return 0;
+    }
     const char* src = source.c_str();
     glShaderSource(shader, 1, &src, nullptr);
     glCompileShader(shader);
-    
-    // Check compilation status
-    int success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        std::string infoLog = getShaderInfoLog(shader);
-        LOG_ERROR_FMT("Shader compilation failed: {}", infoLog);
-        glDeleteShader(shader);
-        return 0;
-    }
-    
     return shader;
 }
 
-bool Shader::linkProgram(unsigned int vertexShader, unsigned int fragmentShader) {
+void Shader::linkProgram(unsigned int vertexShader, unsigned int fragmentShader) {
     m_programID = glCreateProgram();
     glAttachShader(m_programID, vertexShader);
     glAttachShader(m_programID, fragmentShader);
+    if (m_storeBinary) {
+        glProgramParameteri(m_programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(m_programID);
-    
-    // Check linking status
-    int success;
-    glGetProgramiv(m_programID, GL_LINK_STATUS, &success);
-    if (!success) {
-        std::string infoLog = getProgramInfoLog(m_programID);
-        LOG_ERROR_FMT("Shader program linking failed: {}", infoLog);
-        glDeleteProgram(m_programID);
-        m_programID = 0;
+}
+
+bool Shader::checkCompileStatus(unsigned int shader, const char* stage) {
+    int success = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (success != GL_TRUE) {
+        LOG_ERROR_FMT("Shader compilation failed ({} stage): {}", stage, getShaderInfoLog(shader));
         return false;
     }
-    
     return true;
 }
 
@@ -298,6 +535,74 @@ int Shader::getCachedAttributeLocation(const std::string& name) const {
     return location;
 }
 
+int Shader::resolveHandleLocation(UniformHandle handle) {
+    if (!handle.isValid() || m_programID == 0) {
+        return -1;
+    }
+    
+    // The handle was registered after this program was introspected, or
+    // names a uniform the program doesn't have; resolved once either way
+    uint32_t index = handle.getIndex();
+    if (index >= m_handleLocations.size()) {
+        m_handleLocations.resize(UniformHandle::getRegisteredCount(), UNRESOLVED_LOCATION);
+    }
+    int location = getCachedUniformLocation(handle.getName());
+    m_handleLocations[index] = location;
+    return location;
+}
+
+bool Shader::updateMirror(int location, const void* data, size_t elementBytes, size_t count) {
+    if (static_cast<size_t>(location) >= m_uniformMirror.size() ||
+        m_uniformMirror[location].elementBytes != elementBytes) {
+        s_uploadStats.issued++;
+        return true;
+    }
+    
+    // GL ignores elements past the end of the array, so the mirror does too
+    UniformMirrorEntry* entries = &m_uniformMirror[location];
+    count = std::min<size_t>(count, entries->remaining);
+    unsigned char* current = m_uniformValues.data() + entries->offset;
+    size_t bytes = count * elementBytes;
+    
+    bool known = true;
+    for (size_t i = 0; i < count && known; ++i) {
+        known = entries[i].known;
+    }
+    if (known && std::memcmp(current, data, bytes) == 0) {
+        s_uploadStats.skipped++;
+        return false;
+    }
+    
+    std::memcpy(current, data, bytes);
+    for (size_t i = 0; i < count; ++i) {
+        entries[i].known = true;
+    }
+    s_uploadStats.issued++;
+    return true;
+}
+
+void Shader::addMirrorEntries(int location, int count, unsigned int type) {
+    size_t elementBytes = getUniformElementBytes(type);
+    if (location < 0 || count <= 0 || elementBytes == 0 || location + count > MAX_MIRRORED_LOCATION) {
+        return;
+    }
+    
+    size_t end = static_cast<size_t>(location + count);
+    if (m_uniformMirror.size() < end) {
+        m_uniformMirror.resize(end);
+    }
+    
+    uint32_t offset = static_cast<uint32_t>(m_uniformValues.size());
+    m_uniformValues.resize(m_uniformValues.size() + elementBytes * count);
+    for (int i = 0; i < count; ++i) {
+        UniformMirrorEntry& entry = m_uniformMirror[location + i];
+        entry.offset = offset + static_cast<uint32_t>(elementBytes * i);
+        entry.elementBytes = static_cast<uint16_t>(elementBytes);
+        entry.remaining = static_cast<uint16_t>(count - i);
+        entry.known = false;
+    }
+}
+
 void Shader::introspectProgram() {
     // Get active uniforms
     int uniformCount;
@@ -311,6 +616,29 @@ void Shader::introspectProgram() {
         
         int location = glGetUniformLocation(m_programID, name);
         m_uniformCache[name] = location;
+        
+        // Arrays are reported as "name[0]"; handles use the bare name
+        std::string handleName(name, length);
+        if (size > 1 && handleName.size() > 3 && handleName.compare(handleName.size() - 3, 3, "[0]") == 0) {
+            handleName.resize(handleName.size() - 3);
+            m_uniformCache[handleName] = location;
+            
+            // Element locations are consecutive on every driver in practice,
+            // but the spec doesn't promise it; leave odd arrays unmirrored
+            std::string last = handleName + "[" + std::to_string(size - 1) + "]";
+            if (glGetUniformLocation(m_programID, last.c_str()) == location + size - 1) {
+                addMirrorEntries(location, size, type);
+            }
+        } else {
+            addMirrorEntries(location, size, type);
+        }
+        UniformHandle handle(handleName);
+        if (handle.isValid()) {
+            if (handle.getIndex() >= m_handleLocations.size()) {
+                m_handleLocations.resize(handle.getIndex() + 1, UNRESOLVED_LOCATION);
+            }
+            m_handleLocations[handle.getIndex()] = location;
+        }
     }
     
     // Get active attributes
@@ -328,34 +656,326 @@ void Shader::introspectProgram() {
     }
 }
 
+void Shader::introspectUniformBlocks() {
+    m_uniformBlocks = 0;
+    
+    int blockCount = 0;
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+    
+    for (int i = 0; i < blockCount; ++i) {
+        char name[256];
+        int length = 0;
+        glGetActiveUniformBlockName(m_programID, i, sizeof(name), &length, name);
+        
+        // Blocks private to the shader keep whatever binding it assigns
+        const UniformBlockLayout* layout = UniformBlockLayout::find(std::string(name, length));
+        if (!layout || !validateUniformBlock(i, *layout)) {
+            continue;
+        }
+        
+        glUniformBlockBinding(m_programID, i, static_cast<GLuint>(layout->binding));
+        m_uniformBlocks |= 1u << static_cast<unsigned int>(layout->binding);
+    }
+}
+
+bool Shader::validateUniformBlock(unsigned int blockIndex, const UniformBlockLayout& layout) const {
+    int dataSize = 0;
+    glGetActiveUniformBlockiv(m_programID, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+    if (static_cast<size_t>(dataSize) != layout.size) {
+        LOG_ERROR_FMT("Uniform block '{}' is {} bytes, expected {}; is it declared std140?",
+                      layout.name, dataSize, layout.size);
+        return false;
+    }
+    
+    int memberCount = 0;
+    glGetActiveUniformBlockiv(m_programID, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &memberCount);
+    std::vector<int> indices(static_cast<size_t>(memberCount));
+    if (memberCount > 0) {
+        glGetActiveUniformBlockiv(m_programID, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data());
+    }
+    
+    for (int index : indices) {
+        GLuint uniformIndex = static_cast<GLuint>(index);
+        char name[256];
+        int length = 0;
+        int offset = -1;
+        glGetActiveUniformName(m_programID, uniformIndex, sizeof(name), &length, name);
+        glGetActiveUniformsiv(m_programID, 1, &uniformIndex, GL_UNIFORM_OFFSET, &offset);
+        
+        std::string memberName(name, length);
+        const UniformBlockMember* member = nullptr;
+        for (const auto& candidate : layout.members) {
+            if (memberName == candidate.name) {
+                member = &candidate;
+                break;
+            }
+        }
+        
+        if (!member) {
+            LOG_ERROR_FMT("Uniform block '{}' has unexpected member '{}'", layout.name, memberName);
+            return false;
+        }
+        if (static_cast<size_t>(offset) != member->offset) {
+            LOG_ERROR_FMT("Uniform block '{}' member '{}' is at offset {}, expected {}",
+                          layout.name, memberName, offset, member->offset);
+            return false;
+        }
+    }
+    
+    return true;
+}
+
 // ShaderManager implementation
 ShaderManager& ShaderManager::getInstance() {
     static ShaderManager instance;
     return instance;
 }
 
-std::shared_ptr<Shader> ShaderManager::loadShader(const std::string& name, 
-                                                  const std::string& vertexPath, 
-                                                  const std::string& fragmentPath) {
+ShaderManager::ShaderManager() : m_parallelCompileConfigured(false), m_builtinFamiliesRegistered(false) {
+    m_preprocessor.addInclude(SHARED_BLOCKS_INCLUDE, UniformBlockLayout::getSource());
+}
+
+ShaderFuture ShaderManager::loadShader(const std::string& name,
+                                       const std::string& vertexPath,
+                                       const std::string& fragmentPath) {
     auto it = m_shaders.find(name);
     if (it != m_shaders.end()) {
-        return it->second;
+        if (it->second->getStatus() != ShaderStatus::FAILED) {
+            return ShaderFuture(it->second);
+        }
+        m_shaders.erase(it);
     }
     
-    auto shader = std::make_shared<Shader>();
-    if (shader->loadFromFile(vertexPath, fragmentPath)) {
+    std::string vertexSource = FileUtils::readTextFile(vertexPath);
+    std::string fragmentSource = FileUtils::readTextFile(fragmentPath);
+    if (vertexSource.empty() || fragmentSource.empty()) {
+        LOG_ERROR_FMT("Failed to load shader files: {} or {}", vertexPath, fragmentPath);
+        return ShaderFuture();
+    }
+    
+    // Includes in shader files resolve next to the files themselves first
+    auto shader = createFromSource(name, vertexSource, fragmentSource,
+                                   FileUtils::getDirectory(vertexPath), FileUtils::getDirectory(fragmentPath));
+    if (!shader) {
+        LOG_ERROR_FMT("Failed to load shader: {}", name);
+        return ShaderFuture();
+    }
+    
+    LOG_INFO_FMT("Loading shader: {}", name);
+    return ShaderFuture(shader);
+}
+
+std::shared_ptr<Shader> ShaderManager::createFromSource(const std::string& name, const std::string& vertexSource,
+                                                        const std::string& fragmentSource,
+                                                        const std::string& vertexDirectory,
+                                                        const std::string& fragmentDirectory) {
+    auto shader = compileProgram(name, vertexSource, fragmentSource, {}, vertexDirectory, fragmentDirectory);
+    if (shader) {
         m_shaders[name] = shader;
-        LOG_INFO_FMT("Loaded shader: {}", name);
-        return shader;
+    }
+    return shader;
+}
+
+std::shared_ptr<Shader> ShaderManager::compileProgram(const std::string& label, const std::string& vertexSource,
+                                                      const std::string& fragmentSource,
+                                                      const std::vector<std::string>& defines,
+                                                      const std::string& vertexDirectory,
+                                                      const std::string& fragmentDirectory) {
+    std::string vertex;
+    std::string fragment;
+    std::string error;
+    if (!m_preprocessor.process(vertexSource, defines, vertex, error, vertexDirectory) ||
+        !m_preprocessor.process(fragmentSource, defines, fragment, error, fragmentDirectory)) {
+        LOG_ERROR_FMT("Shader preprocessing failed for {}: {}", label, error);
+        return nullptr;
+    }
+    
+    // Let the driver use as many compiler threads as it likes
+    if (!m_parallelCompileConfigured) {
+        m_parallelCompileConfigured = true;
+        if (GLEW_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xffffffffu);
+            LOG_INFO("Parallel shader compilation enabled");
+        }
     }
     
-    LOG_ERROR_FMT("Failed to load shader: {}", name);
-    return nullptr;
+    auto shader = std::make_shared<Shader>();
+    if (!shader->compileAsync(vertex, fragment)) {
+        return nullptr;
+    }
+    return shader;
+}
+
+bool ShaderManager::registerShaderSource(const std::string& family, const std::string& vertexSource,
+                                         const std::string& fragmentSource,
+                                         const std::vector<std::string>& defines) {
+    if (defines.size() > MAX_FAMILY_DEFINES) {
+        LOG_ERROR_FMT("Shader family {} has more than {} defines", family, MAX_FAMILY_DEFINES);
+        return false;
+    }
+    
+    // Define names are part of the key: the same bit means a different
+    // specialization when the list changes
+    uint64_t hash = HashUtils::fnv1a(vertexSource);
+    hash = HashUtils::fnv1a(fragmentSource, hash);
+    for (const auto& define : defines) {
+        hash = HashUtils::fnv1a(define.c_str(), define.size() + 1, hash);
+    }
+    
+    ShaderFamily& entry = m_families[family];
+    entry.vertexSource = vertexSource;
+    entry.fragmentSource = fragmentSource;
+    entry.defines = defines;
+    entry.sourceHash = hash;
+    return true;
+}
+
+std::shared_ptr<Shader> ShaderManager::getVariant(const std::string& family, uint32_t defineMask) {
+    auto familyIt = m_families.find(family);
+    if (familyIt == m_families.end()) {
+        LOG_ERROR_FMT("Unknown shader family: {}", family);
+        return nullptr;
+    }
+    const ShaderFamily& entry = familyIt->second;
+    
+    size_t defineCount = entry.defines.size();
+    uint32_t validBits = defineCount >= MAX_FAMILY_DEFINES ? ~0u : (1u << defineCount) - 1u;
+    defineMask &= validBits;
+    
+    uint64_t key = HashUtils::fnv1a(&defineMask, sizeof(defineMask), entry.sourceHash);
+    auto variantIt = m_variants.find(key);
+    if (variantIt != m_variants.end()) {
+        if (variantIt->second->getStatus() != ShaderStatus::FAILED) {
+            return variantIt->second;
+        }
+        m_variants.erase(variantIt);
+    }
+    
+    std::vector<std::string> defines;
+    for (size_t i = 0; i < defineCount; ++i) {
+        if (defineMask & (1u << i)) {
+            defines.push_back(entry.defines[i]);
+        }
+    }
+    
+    std::string label = family + "#" + std::to_string(defineMask);
+    auto shader = compileProgram(label, entry.vertexSource, entry.fragmentSource, defines);
+    if (!shader) {
+        return nullptr;
+    }
+    shader->m_variantFamily = family;
+    shader->m_defineMask = defineMask;
+    m_variants.emplace(key, shader);
+    LOG_DEBUG_FMT("Compiling shader variant: {}", label);
+    return shader;
+}
+
+uint32_t ShaderManager::getDefineBit(const std::string& family, const std::string& define) const {
+    auto it = m_families.find(family);
+    if (it == m_families.end()) {
+        return 0;
+    }
+    
+    const auto& defines = it->second.defines;
+    for (size_t i = 0; i < defines.size(); ++i) {
+        if (defines[i] == define) {
+            return 1u << i;
+        }
+    }
+    return 0;
+}
+
+std::shared_ptr<Shader> ShaderManager::getRelatedVariant(const Shader& shader, const std::string& define,
+                                                         bool enabled) {
+    if (shader.m_variantFamily.empty()) {
+        return nullptr;
+    }
+    uint32_t bit = getDefineBit(shader.m_variantFamily, define);
+    if (bit == 0) {
+        return nullptr;
+    }
+    
+    uint32_t mask = enabled ? (shader.m_defineMask | bit) : (shader.m_defineMask & ~bit);
+    return getVariant(shader.m_variantFamily, mask);
+}
+
+// Failed programs are dropped from the cache as soon as their result is
+// collected, so the next request for them compiles again
+size_t ShaderManager::pollPendingShaders() {
+    size_t pending = 0;
+    for (auto it = m_shaders.begin(); it != m_shaders.end();) {
+        Shader& shader = *it->second;
+        if (shader.isPending()) {
+            shader.pollCompile();
+            pending += shader.isPending() ? 1 : 0;
+        }
+        if (shader.getStatus() == ShaderStatus::FAILED) {
+            LOG_ERROR_FMT("Shader failed to build: {}", it->first);
+            it = m_shaders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = m_variants.begin(); it != m_variants.end();) {
+        Shader& shader = *it->second;
+        if (shader.isPending()) {
+            shader.pollCompile();
+            pending += shader.isPending() ? 1 : 0;
+        }
+        if (shader.getStatus() == ShaderStatus::FAILED) {
+            LOG_ERROR_FMT("Shader variant failed to build: {}#{}", shader.m_variantFamily, shader.m_defineMask);
+            it = m_variants.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return pending;
+}
+
+void ShaderManager::finishPendingShaders() {
+    for (auto it = m_shaders.begin(); it != m_shaders.end();) {
+        if (!it->second->finishCompile()) {
+            LOG_ERROR_FMT("Shader failed to build: {}", it->first);
+            it = m_shaders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = m_variants.begin(); it != m_variants.end();) {
+        Shader& shader = *it->second;
+        if (!shader.finishCompile()) {
+            LOG_ERROR_FMT("Shader variant failed to build: {}#{}", shader.m_variantFamily, shader.m_defineMask);
+            it = m_variants.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 std::shared_ptr<Shader> ShaderManager::getShader(const std::string& name) {
     auto it = m_shaders.find(name);
-    return (it != m_shaders.end()) ? it->second : nullptr;
+    if (it == m_shaders.end()) {
+        return nullptr;
+    }
+    if (it->second->getStatus() == ShaderStatus::FAILED) {
+        m_shaders.erase(it);
+        return nullptr;
+    }
+    return it->second;
+}
+
+ShaderStatus ShaderManager::getShaderStatus(const std::string& name) {
+    auto it = m_shaders.find(name);
+    if (it == m_shaders.end()) {
+        return ShaderStatus::EMPTY;
+    }
+    
+    it->second->pollCompile();
+    ShaderStatus status = it->second->getStatus();
+    if (status == ShaderStatus::FAILED) {
+        m_shaders.erase(it);
+    }
+    return status;
 }
 
 bool ShaderManager::unloadShader(const std::string& name) {
@@ -370,77 +990,49 @@ bool ShaderManager::unloadShader(const std::string& name) {
 
 void ShaderManager::unloadAll() {
     m_shaders.clear();
+    m_variants.clear();
     LOG_INFO("All shaders unloaded");
 }
 
-std::shared_ptr<Shader> ShaderManager::createBasicShader() {
-    const std::string vertexSource = R"(
-        #version 330 core
-        layout (location = 0) in vec3 aPosition;
-        layout (location = 1) in vec2 aTexCoord;
-        layout (location = 2) in vec4 aColor;
-        
-        uniform mat4 uModel;
-        uniform mat4 uView;
-        uniform mat4 uProjection;
-        
-        out vec2 TexCoord;
-        out vec4 Color;
-        
-        void main() {
-            gl_Position = uProjection * uView * uModel * vec4(aPosition, 1.0);
-            TexCoord = aTexCoord;
-            Color = aColor;
-        }
-    )";
-    
-    const std::string fragmentSource = R"(
-        #version 330 core
-        in vec2 TexCoord;
-        in vec4 Color;
-        
-        uniform sampler2D uTexture;
-        uniform bool uUseTexture;
-        
-        out vec4 FragColor;
-        
-        void main() {
-            if (uUseTexture) {
-                FragColor = texture(uTexture, TexCoord) * Color;
-            } else {
-                FragColor = Color;
-            }
-        }
-    )";
+void ShaderManager::registerBuiltinFamilies() {
+    if (m_builtinFamiliesRegistered) {
+        return;
+    }
+    m_builtinFamiliesRegistered = true;
     
-    auto shader = std::make_shared<Shader>();
-    if (shader->loadFromSource(vertexSource, fragmentSource)) {
+    registerShaderSource("sprite", SPRITE_VERTEX_SOURCE, SPRITE_FRAGMENT_SOURCE, { "USE_TEXTURE" });
+    registerShaderSource("packed", PACKED_VERTEX_SOURCE, SPRITE_FRAGMENT_SOURCE, { "USE_TEXTURE" });
+}
+
+std::shared_ptr<Shader> ShaderManager::createBasicShader() {
+    // Still registered as "basic" for getShader; the textured sprite variant
+    // is the same program under the family cache
+    auto shader = createTextureShader();
+    if (shader) {
         m_shaders["basic"] = shader;
-        return shader;
     }
-    
-    return nullptr;
+    return shader;
 }
 
 std::shared_ptr<Shader> ShaderManager::createTextureShader() {
-    return createBasicShader(); // Same as basic for now
+    registerBuiltinFamilies();
+    return getVariant("sprite", getDefineBit("sprite", "USE_TEXTURE"));
 }
 
 std::shared_ptr<Shader> ShaderManager::createColorShader() {
-    return createBasicShader(); // Same as basic for now
+    registerBuiltinFamilies();
+    return getVariant("sprite", 0);
 }
 
 std::shared_ptr<Shader> ShaderManager::createParticleShader() {
     const std::string vertexSource = R"(
         #version 330 core
+        #include "engine/shared_blocks.glsl"
         layout (location = 0) in vec3 aPosition;
         layout (location = 1) in vec2 aTexCoord;
         layout (location = 2) in vec4 aColor;
         layout (location = 3) in float aSize;
         
-        uniform mat4 uView;
-        uniform mat4 uProjection;
-        
         out vec2 TexCoord;
         out vec4 Color;
         out float Size;
@@ -473,25 +1065,18 @@ std::shared_ptr<Shader> ShaderManager::createParticleShader() {
         }
     )";
     
-    auto shader = std::make_shared<Shader>();
-    if (shader->loadFromSource(vertexSource, fragmentSource)) {
-        m_shaders["particle"] = shader;
-        return shader;
-    }
-    
-    return nullptr;
+    return createFromSource("particle", vertexSource, fragmentSource);
 }
 
 std::shared_ptr<Shader> ShaderManager::createLightingShader() {
     const std::string vertexSource = R"(
         #version 330 core
+        #include "engine/shared_blocks.glsl"
         layout (location = 0) in vec3 aPosition;
         layout (location = 1) in vec2 aTexCoord;
         layout (location = 2) in vec3 aNormal;
         
         uniform mat4 uModel;
-        uniform mat4 uView;
-        uniform mat4 uProjection;
         uniform mat3 uNormalMatrix;
         
         out vec2 TexCoord;
@@ -537,13 +1122,72 @@ std::shared_ptr<Shader> ShaderManager::createLightingShader() {
         }
     )";
     
-    auto shader = std::make_shared<Shader>();
-    if (shader->loadFromSource(vertexSource, fragmentSource)) {
-        m_shaders["lighting"] = shader;
-        return shader;
-    }
+    return createFromSource("lighting", vertexSource, fragmentSource);
+}
+
+std::shared_ptr<Shader> ShaderManager::createTextShader() {
+    // Text is drawn through the sprite batch, so it shares the packed vertex
+    // stage. Signed distance field glyphs: 0.5 marks the outline, and the
+    // screen-space derivative keeps edges one pixel wide at any scale
+    const std::string fragmentSource = R"(
+        #version 330 core
+        in vec2 TexCoord;
+        in vec4 Color;
+        
+        uniform sampler2D uTexture;
+        
+        out vec4 FragColor;
+        
+        void main() {
+            float distance = texture(uTexture, TexCoord).r;
+            float width = max(fwidth(distance), 0.0001);
+            float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+            if (alpha <= 0.0) discard;
+            
+            FragColor = vec4(Color.rgb, Color.a * alpha);
+        }
+    )";
+    
+    return createFromSource("text", PACKED_VERTEX_SOURCE, fragmentSource);
+}
+
+std::shared_ptr<Shader> ShaderManager::createPackedShader() {
+    registerBuiltinFamilies();
+    return getVariant("packed", getDefineBit("packed", "USE_TEXTURE"));
+}
+
+std::shared_ptr<Shader> ShaderManager::createBlitShader() {
+    // Fullscreen triangle generated from gl_VertexID; no vertex buffer needed
+    const std::string vertexSource = R"(
+        #version 330 core
+        uniform vec2 uUVScale;
+        
+        out vec2 TexCoord;
+        
+        void main() {
+            vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            TexCoord = position * uUVScale;
+            gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+    
+    // Clamp to the last rendered texel so bilinear filtering never reads
+    // outside the scaled region of the offscreen target
+    const std::string fragmentSource = R"(
+        #version 330 core
+        in vec2 TexCoord;
+        
+        uniform sampler2D uTexture;
+        uniform vec2 uUVMax;
+        
+        out vec4 FragColor;
+        
+        void main() {
+            FragColor = texture(uTexture, min(TexCoord, uUVMax));
+        }
+    )";
     
-    return nullptr;
+    return createFromSource("blit", vertexSource, fragmentSource);
 }
 
 std::vector<std::string> ShaderManager::getShaderNames() const {
@@ -551,6 +1195,9 @@ std::vector<std::string> ShaderManager::getShaderNames() const {
     for (const auto& pair : m_shaders) {
         names.push_back(pair.first);
     }
+    for (const auto& pair : m_variants) {
+        names.push_back(pair.second->m_variantFamily + "#" + std::to_string(pair.second->m_defineMask));
+    }
     return names;
 }
 
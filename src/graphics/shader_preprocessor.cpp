@@ -0,0 +1,200 @@
+#include "graphics/shader_preprocessor.h"
+#include "utils/file_utils.h"
+#include <filesystem>
+#include <sstream>
+
+namespace GameEngine2D {
+
+namespace {
+
+// Position after the leading whitespace of a line and the directive name,
+// or npos when the line is not that directive
+size_t matchDirective(const std::string& line, const char* directive) {
+    size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line[start] != '#') {
+        return std::string::npos;
+    }
+    start = line.find_first_not_of(" \t", start + 1);
+    std::string name(directive);
+    if (start == std::string::npos || line.compare(start, name.size(), name) != 0) {
+        return std::string::npos;
+    }
+    return start + name.size();
+}
+
+bool isPragmaOnce(const std::string& line, size_t position) {
+    size_t start = line.find_first_not_of(" \t", position);
+    if (start == std::string::npos || line.compare(start, 4, "once") != 0) {
+        return false;
+    }
+    size_t end = line.find_first_not_of(" \t\r", start + 4);
+    return end == std::string::npos || line.compare(end, 2, "//") == 0;
+}
+
+// Reads directory/name if it exists. The path is normalized so a file reached
+// through different relative paths is recognized as the same include.
+bool readIncludeFile(const std::string& directory, const std::string& name, std::string& path, std::string& source) {
+    path = std::filesystem::path(FileUtils::combinePath(directory, name)).lexically_normal().string();
+    if (!FileUtils::fileExists(path)) {
+        return false;
+    }
+    source = FileUtils::readTextFile(path);
+    return true;
+}
+
+} // namespace
+
+ShaderPreprocessor::ShaderPreprocessor() {
+}
+
+void ShaderPreprocessor::addInclude(const std::string& name, const std::string& source) {
+    m_includes[name] = source;
+}
+
+void ShaderPreprocessor::addIncludeDirectory(const std::string& directory) {
+    for (const auto& existing : m_includeDirectories) {
+        if (existing == directory) {
+            return;
+        }
+    }
+    m_includeDirectories.push_back(directory);
+}
+
+bool ShaderPreprocessor::hasInclude(const std::string& name) const {
+    return m_includes.find(name) != m_includes.end();
+}
+
+bool ShaderPreprocessor::process(const std::string& source, const std::vector<std::string>& defines,
+                                 std::string& output, std::string& error,
+                                 const std::string& sourceDirectory) const {
+    ExpandState state;
+    std::string expanded;
+    if (!expand(source, "<source>", sourceDirectory, state, expanded, error)) {
+        return false;
+    }
+    
+    // Defines must follow #version, which has to stay the first directive
+    std::string defineBlock;
+    for (const auto& define : defines) {
+        size_t space = define.find(' ');
+        defineBlock += "#define " + (space == std::string::npos ? define + " 1" : define) + "\n";
+    }
+    
+    output.clear();
+    std::istringstream lines(expanded);
+    std::string line;
+    bool inserted = false;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        output += line;
+        output += '\n';
+        if (!inserted && matchDirective(line, "version") != std::string::npos) {
+            output += defineBlock;
+            output += "#line " + std::to_string(lineNumber + 1) + "\n";
+            inserted = true;
+        }
+    }
+    if (!inserted) {
+        output = defineBlock + output;
+    }
+    return true;
+}
+
+bool ShaderPreprocessor::expand(const std::string& source, const std::string& sourceName,
+                                const std::string& directory, ExpandState& state, std::string& output,
+                                std::string& error) const {
+    if (state.stack.size() > MAX_INCLUDE_DEPTH) {
+        error = "include depth exceeded in " + sourceName;
+        return false;
+    }
+    state.stack.push_back(sourceName);
+    
+    std::istringstream lines(source);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        size_t pragma = matchDirective(line, "pragma");
+        if (pragma != std::string::npos && isPragmaOnce(line, pragma)) {
+            // GLSL has no #pragma once; blank the line to keep line numbers
+            state.onceFiles.insert(sourceName);
+            output += '\n';
+            continue;
+        }
+        
+        size_t position = matchDirective(line, "include");
+        if (position == std::string::npos) {
+            output += line;
+            output += '\n';
+            continue;
+        }
+        
+        size_t open = line.find_first_of("\"<", position);
+        size_t close = open == std::string::npos ? std::string::npos
+                                                 : line.find(line[open] == '<' ? '>' : '"', open + 1);
+        if (close == std::string::npos) {
+            error = sourceName + ":" + std::to_string(lineNumber) + ": malformed #include";
+            return false;
+        }
+        
+        std::string name = line.substr(open + 1, close - open - 1);
+        std::string path;
+        std::string includeSource;
+        if (!resolveInclude(name, directory, path, includeSource)) {
+            error = sourceName + ":" + std::to_string(lineNumber) + ": cannot find include '" + name + "'";
+            return false;
+        }
+        
+        // A once-guarded file is skipped even while it is still being
+        // expanded; only unguarded files can form a cycle
+        if (state.onceFiles.count(path)) {
+            output += '\n';
+            continue;
+        }
+        for (const auto& active : state.stack) {
+            if (active == path) {
+                error = sourceName + ":" + std::to_string(lineNumber) + ": include cycle: ";
+                for (const auto& file : state.stack) {
+                    error += file + " -> ";
+                }
+                error += path;
+                return false;
+            }
+        }
+        
+        std::string includeDirectory = hasInclude(path) ? std::string() : FileUtils::getDirectory(path);
+        if (!expand(includeSource, path, includeDirectory, state, output, error)) {
+            return false;
+        }
+        
+        // Keep compiler messages pointing at the including file's lines
+        output += "#line " + std::to_string(lineNumber + 1) + "\n";
+    }
+    
+    state.stack.pop_back();
+    return true;
+}
+
+bool ShaderPreprocessor::resolveInclude(const std::string& name, const std::string& directory,
+                                        std::string& path, std::string& source) const {
+    auto it = m_includes.find(name);
+    if (it != m_includes.end()) {
+        path = name;
+        source = it->second;
+        return true;
+    }
+    
+    // The including file's own directory comes before the search path
+    if (!directory.empty() && readIncludeFile(directory, name, path, source)) {
+        return true;
+    }
+    for (const auto& searchDirectory : m_includeDirectories) {
+        if (readIncludeFile(searchDirectory, name, path, source)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,214 @@
+#include "graphics/sprite_queue.h"
+#include "graphics/renderer.h"
+#include "graphics/batch_renderer.h"
+#include "graphics/texture.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace GameEngine2D {
+
+namespace {
+
+constexpr float NO_OCCLUDER = -std::numeric_limits<float>::infinity();
+
+struct PixelRect {
+    float x0, y0, x1, y1;
+};
+
+} // namespace
+
+SpriteQueue::SpriteQueue() : m_nextOrder(0), m_estimateOverdraw(false), m_cellSize(8) {
+}
+
+void SpriteQueue::submit(const Vector2& position, const Vector2& size, const Texture& texture,
+                         const Vector4& uvRect, const Color& color, float depth) {
+    submit(position, size, texture.getID(), texture.isOpaque(), uvRect, color, depth);
+}
+
+void SpriteQueue::submit(const Vector2& position, const Vector2& size, TextureID texture, bool opaqueTexture,
+                         const Vector4& uvRect, const Color& color, float depth) {
+    Entry entry;
+    entry.position = position;
+    entry.size = size;
+    entry.texture = texture;
+    entry.uvRect = uvRect;
+    entry.color = color;
+    entry.depth = depth;
+    entry.order = m_nextOrder++;
+    
+    // Untextured quads are as opaque as their color
+    bool opaque = (opaqueTexture || texture == 0) && color.a >= 1.0f;
+    if (opaque) {
+        m_opaque.push_back(entry);
+    } else {
+        m_translucent.push_back(entry);
+    }
+}
+
+void SpriteQueue::clear() {
+    m_opaque.clear();
+    m_translucent.clear();
+    m_nextOrder = 0;
+}
+
+void SpriteQueue::flush(Renderer& renderer, BatchRenderer& batch, std::shared_ptr<Shader> shader,
+                        const Matrix4& view, const Matrix4& projection) {
+    if (batch.isDrawing()) {
+        LOG_WARNING("SpriteQueue::flush called while the batch is drawing");
+        return;
+    }
+    
+    // Opaque: nearest first, and the later of two equal-depth sprites first
+    // so it wins the depth test. Translucent: painter's order.
+    std::sort(m_opaque.begin(), m_opaque.end(), [](const Entry& a, const Entry& b) {
+        return a.depth != b.depth ? a.depth > b.depth : a.order > b.order;
+    });
+    std::sort(m_translucent.begin(), m_translucent.end(), [](const Entry& a, const Entry& b) {
+        return a.depth != b.depth ? a.depth < b.depth : a.order < b.order;
+    });
+    
+    m_stats = SpriteQueueStats{};
+    m_stats.opaqueSprites = static_cast<uint32_t>(m_opaque.size());
+    m_stats.translucentSprites = static_cast<uint32_t>(m_translucent.size());
+    if (m_estimateOverdraw) {
+        estimateOverdraw(renderer, projection * view);
+    }
+    
+    bool depthTest = renderer.isDepthTestEnabled();
+    bool depthWrite = renderer.isDepthWriteEnabled();
+    DepthFunc depthFunc = renderer.getDepthFunc();
+    bool blending = renderer.isBlendingEnabled();
+    
+    renderer.enableDepthTest(true);
+    
+    if (!m_opaque.empty()) {
+        renderer.enableDepthWrite(true);
+        renderer.setDepthFunc(DepthFunc::LESS);
+        renderer.enableBlending(false);
+        
+        batch.begin(renderer, shader, view, projection);
+        drawEntries(batch, m_opaque);
+        batch.end();
+    }
+    
+    if (!m_translucent.empty()) {
+        renderer.enableDepthWrite(false);
+        renderer.setDepthFunc(DepthFunc::LESS_EQUAL);
+        renderer.enableBlending(true);
+        
+        batch.begin(renderer, shader, view, projection);
+        drawEntries(batch, m_translucent);
+        batch.end();
+    }
+    
+    renderer.enableDepthTest(depthTest);
+    renderer.enableDepthWrite(depthWrite);
+    renderer.setDepthFunc(depthFunc);
+    renderer.enableBlending(blending);
+    
+    clear();
+}
+
+void SpriteQueue::setOverdrawEstimation(bool enable, int cellSize) {
+    m_estimateOverdraw = enable;
+    m_cellSize = std::max(1, cellSize);
+    if (!enable) {
+        m_cellDepth.clear();
+        m_cellDepth.shrink_to_fit();
+    }
+}
+
+void SpriteQueue::drawEntries(BatchRenderer& batch, const std::vector<Entry>& entries) {
+    for (const auto& entry : entries) {
+        batch.drawQuad(entry.position, entry.size, entry.texture, entry.uvRect, entry.color, entry.depth);
+    }
+}
+
+void SpriteQueue::estimateOverdraw(Renderer& renderer, const Matrix4& viewProjection) {
+    float width = static_cast<float>(renderer.getRenderWidth());
+    float height = static_cast<float>(renderer.getRenderHeight());
+    float cellSize = static_cast<float>(m_cellSize);
+    int gridWidth = static_cast<int>(std::ceil(width / cellSize));
+    int gridHeight = static_cast<int>(std::ceil(height / cellSize));
+    m_cellDepth.assign(static_cast<size_t>(gridWidth) * gridHeight, NO_OCCLUDER);
+    
+    auto toPixels = [&](const Entry& entry, PixelRect& rect) {
+        Vector4 a = viewProjection * Vector4(entry.position.x, entry.position.y, entry.depth, 1.0f);
+        Vector4 b = viewProjection * Vector4(entry.position.x + entry.size.x, entry.position.y + entry.size.y,
+                                             entry.depth, 1.0f);
+        float ax = (a.x / a.w * 0.5f + 0.5f) * width;
+        float ay = (a.y / a.w * 0.5f + 0.5f) * height;
+        float bx = (b.x / b.w * 0.5f + 0.5f) * width;
+        float by = (b.y / b.w * 0.5f + 0.5f) * height;
+        rect.x0 = std::clamp(std::min(ax, bx), 0.0f, width);
+        rect.y0 = std::clamp(std::min(ay, by), 0.0f, height);
+        rect.x1 = std::clamp(std::max(ax, bx), 0.0f, width);
+        rect.y1 = std::clamp(std::max(ay, by), 0.0f, height);
+        return rect.x1 > rect.x0 && rect.y1 > rect.y0;
+    };
+    
+    // Visits each grid cell under the rectangle with the covered area and
+    // whether the rectangle covers the whole (screen-clipped) cell
+    auto forEachCell = [&](const PixelRect& rect, auto&& visit) {
+        int cx0 = static_cast<int>(rect.x0 / cellSize);
+        int cy0 = static_cast<int>(rect.y0 / cellSize);
+        int cx1 = std::min(gridWidth - 1, static_cast<int>((rect.x1 - 0.001f) / cellSize));
+        int cy1 = std::min(gridHeight - 1, static_cast<int>((rect.y1 - 0.001f) / cellSize));
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            float top = cy * cellSize;
+            float bottom = std::min(top + cellSize, height);
+            float coveredY = std::min(rect.y1, bottom) - std::max(rect.y0, top);
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                float left = cx * cellSize;
+                float right = std::min(left + cellSize, width);
+                float coveredX = std::min(rect.x1, right) - std::max(rect.x0, left);
+                bool full = rect.x0 <= left && rect.x1 >= right && rect.y0 <= top && rect.y1 >= bottom;
+                visit(m_cellDepth[static_cast<size_t>(cy) * gridWidth + cx], coveredX * coveredY, full);
+            }
+        }
+    };
+    
+    double painterFragments = 0.0;
+    double sortedFragments = 0.0;
+    PixelRect rect;
+    
+    // Opaque sprites arrive nearest first, so any occluder already in a cell
+    // hides the sprite there; partially covered cells never occlude
+    for (const auto& entry : m_opaque) {
+        if (!toPixels(entry, rect)) {
+            continue;
+        }
+        forEachCell(rect, [&](float& occluder, float area, bool full) {
+            painterFragments += area;
+            if (occluder == NO_OCCLUDER) {
+                sortedFragments += area;
+                if (full) {
+                    occluder = entry.depth;
+                }
+            }
+        });
+    }
+    
+    // Translucent sprites only fail against occluders strictly in front
+    for (const auto& entry : m_translucent) {
+        if (!toPixels(entry, rect)) {
+            continue;
+        }
+        forEachCell(rect, [&](float& occluder, float area, bool) {
+            painterFragments += area;
+            if (!(occluder > entry.depth)) {
+                sortedFragments += area;
+            }
+        });
+    }
+    
+    double pixels = static_cast<double>(width) * height;
+    m_stats.overdrawPainter = static_cast<float>(painterFragments / pixels);
+    m_stats.overdrawSorted = static_cast<float>(sortedFragments / pixels);
+    m_stats.overdrawReduction = painterFragments > 0.0 ? static_cast<float>(1.0 - sortedFragments / painterFragments)
+                                                       : 0.0f;
+}
+
+} // namespace GameEngine2D
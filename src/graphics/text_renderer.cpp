@@ -0,0 +1,287 @@
+#include "graphics/text_renderer.h"
+#include "graphics/batch_renderer.h"
+#include "graphics/font.h"
+#include "graphics/shader.h"
+#include "utils/logger.h"
+#include "utils/string_utils.h"
+#include <algorithm>
+#include <functional>
+
+namespace GameEngine2D {
+
+namespace {
+constexpr uint64_t LAYOUT_EVICTION_INTERVAL = 60;
+}
+
+size_t TextRenderer::LayoutKeyHash::operator()(const LayoutKey& key) const {
+    size_t hash = std::hash<std::string>()(key.text);
+    hash ^= std::hash<uint32_t>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.wrapWidth) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+TextRenderer::TextRenderer(int atlasSize, int atlasCellSize)
+    : m_atlas(atlasSize, atlasCellSize), m_frame(0), m_retentionFrames(300) {
+}
+
+TextRenderer::~TextRenderer() {
+    shutdown();
+}
+
+bool TextRenderer::initialize() {
+    if (!m_atlas.initialize()) {
+        LOG_ERROR("Failed to initialize glyph atlas");
+        return false;
+    }
+    
+    m_shader = ShaderManager::getInstance().getShader("text");
+    if (!m_shader) {
+        m_shader = ShaderManager::getInstance().createTextShader();
+    }
+    
+    if (!m_shader) {
+        LOG_ERROR("Failed to create text shader");
+        return false;
+    }
+    
+    LOG_INFO("TextRenderer initialized");
+    return true;
+}
+
+void TextRenderer::shutdown() {
+    m_layouts.clear();
+    m_shader.reset();
+    m_atlas.shutdown();
+}
+
+void TextRenderer::beginFrame() {
+    m_frame++;
+    m_atlas.beginFrame();
+    
+    m_stats.layoutHits = 0;
+    m_stats.layoutsBuilt = 0;
+    m_stats.glyphsDrawn = 0;
+    
+    if (m_frame % LAYOUT_EVICTION_INTERVAL == 0) {
+        evictUnusedLayouts();
+    }
+    m_stats.cachedLayouts = static_cast<uint32_t>(m_layouts.size());
+}
+
+std::shared_ptr<TextLayout> TextRenderer::layout(const std::string& text, Font& font, float size, float wrapWidth) {
+    LayoutKey key{text, font.getID(), size, wrapWidth};
+    
+    auto it = m_layouts.find(key);
+    if (it != m_layouts.end()) {
+        it->second->lastUsedFrame = m_frame;
+        m_stats.layoutHits++;
+        return it->second;
+    }
+    
+    auto result = buildLayout(text, font, size, wrapWidth);
+    m_layouts.emplace(std::move(key), result);
+    m_stats.layoutsBuilt++;
+    return result;
+}
+
+Vector2 TextRenderer::measure(const std::string& text, Font& font, float size, float wrapWidth) {
+    return layout(text, font, size, wrapWidth)->size;
+}
+
+void TextRenderer::drawText(BatchRenderer& batch, const std::string& text, Font& font, float size,
+                            const Vector2& position, const Color& color, float wrapWidth) {
+    auto textLayout = layout(text, font, size, wrapWidth);
+    drawLayout(batch, *textLayout, font, position, color);
+}
+
+void TextRenderer::drawLayout(BatchRenderer& batch, TextLayout& layout, Font& font,
+                              const Vector2& position, const Color& color, float depth) {
+    if (layout.font != font.getID()) {
+        LOG_WARNING("Text layout drawn with a different font than it was built for");
+        return;
+    }
+    
+    layout.lastUsedFrame = m_frame;
+    if (layout.glyphs.empty()) {
+        return;
+    }
+    
+    auto previousShader = batch.getShader();
+    batch.setShader(m_shader);
+    
+    TextureID atlasTexture = m_atlas.getTexture();
+    for (auto& glyph : layout.glyphs) {
+        // Cached atlas locations stay valid until their cell is recycled
+        if (!m_atlas.touch(glyph.atlas) && !m_atlas.acquire(font, glyph.codepoint, glyph.atlas)) {
+            continue;
+        }
+        
+        batch.drawQuad(position + glyph.position, glyph.size, atlasTexture, glyph.atlas.uvRect, color, depth);
+        m_stats.glyphsDrawn++;
+    }
+    
+    batch.setShader(previousShader);
+}
+
+void TextRenderer::clearLayoutCache() {
+    m_layouts.clear();
+    m_stats.cachedLayouts = 0;
+}
+
+std::shared_ptr<TextLayout> TextRenderer::buildLayout(const std::string& text, Font& font, float size, float wrapWidth) {
+    auto result = std::make_shared<TextLayout>();
+    result->font = font.getID();
+    result->lastUsedFrame = m_frame;
+    
+    float scale = size / font.getBaseSize();
+    float spread = static_cast<float>(font.getSpread());
+    float lineHeight = font.getLineHeight() * scale;
+    float baseline = font.getAscent() * scale;
+    
+    std::vector<uint32_t> codepoints = StringUtils::decodeUTF8(text);
+    result->glyphs.reserve(codepoints.size());
+    
+    float penX = 0.0f;
+    float maxWidth = 0.0f;
+    int lineCount = 1;
+    size_t lineStart = 0;
+    
+    // Last word boundary on the current line
+    size_t breakGlyph = std::string::npos;
+    float breakLineWidth = 0.0f;
+    float wordStartX = 0.0f;
+    uint32_t previous = 0;
+    
+    for (uint32_t codepoint : codepoints) {
+        if (codepoint == '\n') {
+            maxWidth = std::max(maxWidth, penX);
+            penX = 0.0f;
+            baseline += lineHeight;
+            lineCount++;
+            lineStart = result->glyphs.size();
+            breakGlyph = std::string::npos;
+            previous = 0;
+            continue;
+        }
+        
+        const GlyphInfo& info = font.getGlyphInfo(codepoint);
+        if (previous != 0) {
+            penX += font.getKerning(previous, codepoint) * scale;
+        }
+        float advance = info.advance * scale;
+        
+        if (codepoint == ' ' || codepoint == '\t') {
+            breakLineWidth = penX;
+            penX += codepoint == '\t' ? advance * 4.0f : advance;
+            breakGlyph = result->glyphs.size();
+            wordStartX = penX;
+            previous = codepoint;
+            continue;
+        }
+        
+        // Move the current word down when it runs past the wrap width
+        if (wrapWidth > 0.0f && penX + advance > wrapWidth &&
+            breakGlyph != std::string::npos && breakGlyph > lineStart) {
+            maxWidth = std::max(maxWidth, breakLineWidth);
+            for (size_t i = breakGlyph; i < result->glyphs.size(); ++i) {
+                result->glyphs[i].position.x -= wordStartX;
+                result->glyphs[i].position.y += lineHeight;
+            }
+            penX -= wordStartX;
+            baseline += lineHeight;
+            lineCount++;
+            lineStart = breakGlyph;
+            breakGlyph = std::string::npos;
+        }
+        
+        if (info.width > 0 && info.height > 0) {
+            LayoutGlyph glyph;
+            glyph.codepoint = codepoint;
+            glyph.position = Vector2(penX + (info.bearingX - spread) * scale,
+                                     baseline - (info.bearingY + spread) * scale);
+            glyph.size = Vector2((info.width + spread * 2.0f) * scale,
+                                 (info.height + spread * 2.0f) * scale);
+            result->glyphs.push_back(glyph);
+        }
+        
+        penX += advance;
+        previous = codepoint;
+    }
+    
+    maxWidth = std::max(maxWidth, penX);
+    result->size = Vector2(maxWidth, lineCount * lineHeight);
+    return result;
+}
+
+void TextRenderer::evictUnusedLayouts() {
+    // Layouts still held by labels are kept regardless of age
+    for (auto it = m_layouts.begin(); it != m_layouts.end();) {
+        const auto& cached = it->second;
+        if (cached.use_count() == 1 && m_frame - cached->lastUsedFrame > m_retentionFrames) {
+            it = m_layouts.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// TextLabel implementation
+TextLabel::TextLabel(std::shared_ptr<Font> font, float size)
+    : m_font(font), m_size(size), m_wrapWidth(0.0f), m_position(0.0f, 0.0f),
+      m_color(COLOR_WHITE), m_depth(0.0f), m_dirty(true) {
+}
+
+void TextLabel::setText(const std::string& text) {
+    if (text != m_text) {
+        m_text = text;
+        m_dirty = true;
+    }
+}
+
+void TextLabel::setFont(std::shared_ptr<Font> font) {
+    if (font != m_font) {
+        m_font = font;
+        m_dirty = true;
+    }
+}
+
+void TextLabel::setSize(float size) {
+    if (size != m_size) {
+        m_size = size;
+        m_dirty = true;
+    }
+}
+
+void TextLabel::setWrapWidth(float wrapWidth) {
+    if (wrapWidth != m_wrapWidth) {
+        m_wrapWidth = wrapWidth;
+        m_dirty = true;
+    }
+}
+
+Vector2 TextLabel::getSize(TextRenderer& textRenderer) {
+    updateLayout(textRenderer);
+    return m_layout ? m_layout->size : Vector2(0.0f, 0.0f);
+}
+
+void TextLabel::draw(TextRenderer& textRenderer, BatchRenderer& batch) {
+    updateLayout(textRenderer);
+    if (m_layout) {
+        textRenderer.drawLayout(batch, *m_layout, *m_font, m_position, m_color, m_depth);
+    }
+}
+
+void TextLabel::updateLayout(TextRenderer& textRenderer) {
+    if (!m_font) {
+        m_layout.reset();
+        return;
+    }
+    
+    if (m_dirty || !m_layout) {
+        m_layout = textRenderer.layout(m_text, *m_font, m_size, m_wrapWidth);
+        m_dirty = false;
+    }
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,114 @@
+#include "graphics/texture.h"
+#include "utils/logger.h"
+#include <GL/glew.h>
+#include <vector>
+#include <cstring>
+
+namespace GameEngine2D {
+
+namespace {
+
+GLint toGLFilter(FilterMode filter, bool mipmaps) {
+    switch (filter) {
+        case FilterMode::NEAREST:
+            return GL_NEAREST;
+        case FilterMode::NEAREST_MIPMAP_NEAREST:
+            return mipmaps ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
+        case FilterMode::LINEAR_MIPMAP_NEAREST:
+            return mipmaps ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR;
+        case FilterMode::NEAREST_MIPMAP_LINEAR:
+            return mipmaps ? GL_NEAREST_MIPMAP_LINEAR : GL_NEAREST;
+        case FilterMode::LINEAR_MIPMAP_LINEAR:
+            return mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+        case FilterMode::LINEAR:
+        default:
+            return GL_LINEAR;
+    }
+}
+
+GLint toGLWrap(WrapMode wrap) {
+    switch (wrap) {
+        case WrapMode::MIRRORED_REPEAT: return GL_MIRRORED_REPEAT;
+        case WrapMode::CLAMP_TO_EDGE: return GL_CLAMP_TO_EDGE;
+        case WrapMode::CLAMP_TO_BORDER: return GL_CLAMP_TO_BORDER;
+        case WrapMode::REPEAT:
+        default: return GL_REPEAT;
+    }
+}
+
+} // namespace
+
+Texture::Texture() : m_id(0), m_width(0), m_height(0), m_alpha(TextureAlpha::TRANSLUCENT) {
+}
+
+Texture::~Texture() {
+    destroy();
+}
+
+bool Texture::create(int width, int height, const uint8_t* pixels, const TextureConfig& config) {
+    destroy();
+    
+    if (width <= 0 || height <= 0 || !pixels) {
+        LOG_ERROR_FMT("Invalid texture data: {}x{}", width, height);
+        return false;
+    }
+    
+    m_width = width;
+    m_height = height;
+    m_alpha = analyzeAlpha(pixels, width, height);
+    
+    // GL expects the bottom row first
+    std::vector<uint8_t> flipped;
+    const uint8_t* upload = pixels;
+    if (config.flipVertically) {
+        size_t rowBytes = static_cast<size_t>(width) * 4;
+        flipped.resize(rowBytes * height);
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(&flipped[rowBytes * (height - 1 - y)], pixels + rowBytes * y, rowBytes);
+        }
+        upload = flipped.data();
+    }
+    
+    glGenTextures(1, &m_id);
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, upload);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, toGLFilter(config.minFilter, config.generateMipmaps));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+                    config.magFilter == FilterMode::NEAREST ? GL_NEAREST : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, toGLWrap(config.wrapS));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, toGLWrap(config.wrapT));
+    if (config.generateMipmaps) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    return true;
+}
+
+void Texture::destroy() {
+    if (m_id != 0) {
+        glDeleteTextures(1, &m_id);
+        m_id = 0;
+    }
+    m_width = 0;
+    m_height = 0;
+    m_alpha = TextureAlpha::TRANSLUCENT;
+}
+
+void Texture::bind(unsigned int unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, m_id);
+}
+
+TextureAlpha Texture::analyzeAlpha(const uint8_t* pixels, int width, int height) {
+    size_t count = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < count; ++i) {
+        if (pixels[i * 4 + 3] != 255) {
+            return TextureAlpha::TRANSLUCENT;
+        }
+    }
+    return TextureAlpha::FULLY_OPAQUE;
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,314 @@
+#include "graphics/tilemap.h"
+#include "graphics/renderer.h"
+#include "graphics/shader.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GameEngine2D {
+
+namespace {
+constexpr int MAX_CHUNK_SIZE = 64; // Keeps chunk vertex indices within 16 bits
+
+const UniformHandle U_MODEL("uModel");
+const UniformHandle U_VIEW("uView");
+const UniformHandle U_PROJECTION("uProjection");
+const UniformHandle U_TEXTURE("uTexture");
+}
+
+Tilemap::Tilemap(const TilemapConfig& config)
+    : m_config(config), m_chunksX(0), m_chunksY(0), m_backend(nullptr), m_tileset(0),
+      m_position(0.0f, 0.0f), m_color(COLOR_WHITE), m_indexBuffer(0), m_frame(0) {
+    
+    m_config.width = std::max(m_config.width, 1);
+    m_config.height = std::max(m_config.height, 1);
+    m_config.chunkSize = std::clamp(m_config.chunkSize, 1, MAX_CHUNK_SIZE);
+    m_config.tilesetColumns = std::max(m_config.tilesetColumns, 1);
+    m_config.tilesetRows = std::max(m_config.tilesetRows, 1);
+    
+    m_tiles.assign(static_cast<size_t>(m_config.width) * m_config.height, EMPTY_TILE);
+    
+    m_chunksX = (m_config.width + m_config.chunkSize - 1) / m_config.chunkSize;
+    m_chunksY = (m_config.height + m_config.chunkSize - 1) / m_config.chunkSize;
+    m_chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+}
+
+Tilemap::~Tilemap() {
+    releaseGPUResources();
+}
+
+void Tilemap::setTile(int x, int y, TileID tile) {
+    if (x < 0 || y < 0 || x >= m_config.width || y >= m_config.height) {
+        return;
+    }
+    
+    TileID& current = m_tiles[static_cast<size_t>(y) * m_config.width + x];
+    if (current != tile) {
+        current = tile;
+        markDirty(x, y);
+    }
+}
+
+TileID Tilemap::getTile(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_config.width || y >= m_config.height) {
+        return EMPTY_TILE;
+    }
+    return m_tiles[static_cast<size_t>(y) * m_config.width + x];
+}
+
+void Tilemap::fill(int x, int y, int width, int height, TileID tile) {
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + width, m_config.width);
+    int y1 = std::min(y + height, m_config.height);
+    
+    for (int ty = y0; ty < y1; ++ty) {
+        std::fill_n(m_tiles.begin() + static_cast<size_t>(ty) * m_config.width + x0, x1 - x0, tile);
+    }
+    
+    // Mark each touched chunk once instead of once per tile
+    int cs = m_config.chunkSize;
+    for (int cy = y0 / cs; y1 > y0 && cy <= (y1 - 1) / cs; ++cy) {
+        for (int cx = x0 / cs; x1 > x0 && cx <= (x1 - 1) / cs; ++cx) {
+            m_chunks[chunkIndex(cx, cy)].dirty = true;
+        }
+    }
+}
+
+void Tilemap::clear() {
+    std::fill(m_tiles.begin(), m_tiles.end(), EMPTY_TILE);
+    for (auto& chunk : m_chunks) {
+        chunk.dirty = true;
+    }
+}
+
+void Tilemap::setTileset(TextureID texture, int columns, int rows) {
+    m_tileset = texture;
+    
+    if (columns != m_config.tilesetColumns || rows != m_config.tilesetRows) {
+        m_config.tilesetColumns = std::max(columns, 1);
+        m_config.tilesetRows = std::max(rows, 1);
+        for (auto& chunk : m_chunks) {
+            chunk.dirty = true;
+        }
+    }
+}
+
+void Tilemap::setColor(const Color& color) {
+    if (color == m_color) {
+        return;
+    }
+    
+    // Tint is baked into the chunk vertices
+    m_color = color;
+    for (auto& chunk : m_chunks) {
+        chunk.dirty = true;
+    }
+}
+
+void Tilemap::render(Renderer& renderer, const Rectangle& viewBounds,
+                     const Matrix4& view, const Matrix4& projection) {
+    m_frame++;
+    m_stats = TilemapStats{};
+    
+    // Convert view bounds to an inclusive chunk range
+    float chunkWorldSize = m_config.tileSize * m_config.chunkSize;
+    int cx0 = static_cast<int>(std::floor((viewBounds.x - m_position.x) / chunkWorldSize));
+    int cy0 = static_cast<int>(std::floor((viewBounds.y - m_position.y) / chunkWorldSize));
+    int cx1 = static_cast<int>(std::floor((viewBounds.x + viewBounds.width - m_position.x) / chunkWorldSize));
+    int cy1 = static_cast<int>(std::floor((viewBounds.y + viewBounds.height - m_position.y) / chunkWorldSize));
+    
+    cx0 = std::max(cx0, 0);
+    cy0 = std::max(cy0, 0);
+    cx1 = std::min(cx1, m_chunksX - 1);
+    cy1 = std::min(cy1, m_chunksY - 1);
+    
+    // Resident chunks belong to the backend they were created on
+    RenderBackend& backend = renderer.getBackend();
+    if (m_backend != &backend) {
+        releaseGPUResources();
+        m_backend = &backend;
+    }
+    
+    // A tilemap without a tileset draws flat colors with the untextured variant
+    std::shared_ptr<Shader> program = m_shader;
+    if (m_shader && m_tileset == 0) {
+        if (auto color = ShaderManager::getInstance().getRelatedVariant(*m_shader, "USE_TEXTURE", false)) {
+            program = color;
+        }
+    }
+    
+    if (cx0 <= cx1 && cy0 <= cy1 && program && backend.bindShader(program.get())) {
+        ensureIndexBuffer(renderer);
+        
+        Shader& shader = *program;
+        backend.setUniform(shader, U_MODEL, glm::translate(Matrix4(1.0f), Vector3(m_position, 0.0f)));
+        if (shader.usesUniformBlock(UniformBlockBinding::CAMERA)) {
+            renderer.setCamera(view, projection);
+        } else {
+            backend.setUniform(shader, U_VIEW, view);
+            backend.setUniform(shader, U_PROJECTION, projection);
+        }
+        if (m_tileset != 0) {
+            backend.setUniform(shader, U_TEXTURE, 0);
+            backend.bindTexture(0, m_tileset);
+            renderer.recordTextureBind();
+        }
+        
+        std::vector<PackedVertex> scratch;
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                int index = chunkIndex(cx, cy);
+                Chunk& chunk = m_chunks[index];
+                chunk.lastVisibleFrame = m_frame;
+                m_stats.visibleChunks++;
+                
+                if (chunk.dirty || !chunk.resident) {
+                    rebuildChunk(renderer, index, scratch);
+                }
+                
+                if (chunk.quadCount == 0) {
+                    continue;
+                }
+                
+                backend.drawIndexed(chunk.vao, chunk.quadCount * 6, 0);
+                renderer.recordDrawCall(chunk.quadCount * 4);
+                m_stats.drawnChunks++;
+            }
+        }
+    }
+    
+    evictStaleChunks();
+    m_stats.residentChunks = static_cast<uint32_t>(m_residentChunks.size());
+}
+
+void Tilemap::releaseGPUResources() {
+    if (!m_backend) {
+        return;
+    }
+    
+    for (int index : m_residentChunks) {
+        releaseChunk(m_chunks[index]);
+    }
+    m_residentChunks.clear();
+    
+    if (m_indexBuffer != 0) {
+        m_backend->destroyBuffer(m_indexBuffer);
+        m_indexBuffer = 0;
+    }
+}
+
+Rectangle Tilemap::getBounds() const {
+    return Rectangle(m_position.x, m_position.y,
+                     m_config.width * m_config.tileSize,
+                     m_config.height * m_config.tileSize);
+}
+
+void Tilemap::markDirty(int x, int y) {
+    m_chunks[chunkIndex(x / m_config.chunkSize, y / m_config.chunkSize)].dirty = true;
+}
+
+void Tilemap::rebuildChunk(Renderer& renderer, int index, std::vector<PackedVertex>& scratch) {
+    Chunk& chunk = m_chunks[index];
+    int cs = m_config.chunkSize;
+    int tileX0 = (index % m_chunksX) * cs;
+    int tileY0 = (index / m_chunksX) * cs;
+    int tileX1 = std::min(tileX0 + cs, m_config.width);
+    int tileY1 = std::min(tileY0 + cs, m_config.height);
+    
+    float ts = m_config.tileSize;
+    float uStep = 1.0f / m_config.tilesetColumns;
+    float vStep = 1.0f / m_config.tilesetRows;
+    int tileCount = m_config.tilesetColumns * m_config.tilesetRows;
+    
+    scratch.clear();
+    for (int y = tileY0; y < tileY1; ++y) {
+        const TileID* row = &m_tiles[static_cast<size_t>(y) * m_config.width];
+        for (int x = tileX0; x < tileX1; ++x) {
+            TileID tile = row[x];
+            if (tile == EMPTY_TILE || tile > tileCount) {
+                continue;
+            }
+            
+            int atlasIndex = tile - 1;
+            float u0 = (atlasIndex % m_config.tilesetColumns) * uStep;
+            float v0 = (atlasIndex / m_config.tilesetColumns) * vStep;
+            float px = x * ts;
+            float py = y * ts;
+            
+            scratch.push_back(VertexPacking::pack(Vector3(px, py, 0.0f), Vector2(u0, v0), m_color));
+            scratch.push_back(VertexPacking::pack(Vector3(px + ts, py, 0.0f), Vector2(u0 + uStep, v0), m_color));
+            scratch.push_back(VertexPacking::pack(Vector3(px + ts, py + ts, 0.0f), Vector2(u0 + uStep, v0 + vStep), m_color));
+            scratch.push_back(VertexPacking::pack(Vector3(px, py + ts, 0.0f), Vector2(u0, v0 + vStep), m_color));
+        }
+    }
+    
+    if (!chunk.resident) {
+        chunk.vbo = m_backend->createBuffer();
+        chunk.vao = m_backend->createVertexArray(PackedVertex::getLayout(), chunk.vbo, m_indexBuffer);
+        chunk.resident = true;
+        m_residentChunks.push_back(index);
+    }
+    
+    size_t bytes = scratch.size() * sizeof(PackedVertex);
+    m_backend->uploadBuffer(chunk.vbo, scratch.data(), bytes, false);
+    renderer.recordBufferUpload(bytes);
+    
+    chunk.quadCount = static_cast<uint32_t>(scratch.size() / 4);
+    chunk.dirty = false;
+    m_stats.rebuiltChunks++;
+}
+
+void Tilemap::releaseChunk(Chunk& chunk) {
+    if (chunk.vao != 0) {
+        m_backend->destroyVertexArray(chunk.vao);
+        chunk.vao = 0;
+    }
+    if (chunk.vbo != 0) {
+        m_backend->destroyBuffer(chunk.vbo);
+        chunk.vbo = 0;
+    }
+    chunk.quadCount = 0;
+    chunk.resident = false;
+}
+
+void Tilemap::evictStaleChunks() {
+    // Only resident chunks are scanned, which stays proportional to the view
+    uint64_t evictAfter = static_cast<uint64_t>(std::max(m_config.evictAfterFrames, 0));
+    for (size_t i = 0; i < m_residentChunks.size();) {
+        Chunk& chunk = m_chunks[m_residentChunks[i]];
+        if (m_frame - chunk.lastVisibleFrame > evictAfter) {
+            releaseChunk(chunk);
+            m_residentChunks[i] = m_residentChunks.back();
+            m_residentChunks.pop_back();
+            m_stats.evictedChunks++;
+        } else {
+            ++i;
+        }
+    }
+}
+
+void Tilemap::ensureIndexBuffer(Renderer& renderer) {
+    if (m_indexBuffer != 0) {
+        return;
+    }
+    
+    // Every chunk shares one quad index pattern sized for a full chunk
+    size_t quadCount = static_cast<size_t>(m_config.chunkSize) * m_config.chunkSize;
+    std::vector<uint16_t> indices(quadCount * 6);
+    for (size_t i = 0; i < quadCount; ++i) {
+        uint16_t base = static_cast<uint16_t>(i * 4);
+        indices[i * 6 + 0] = base;
+        indices[i * 6 + 1] = base + 1;
+        indices[i * 6 + 2] = base + 2;
+        indices[i * 6 + 3] = base + 2;
+        indices[i * 6 + 4] = base + 3;
+        indices[i * 6 + 5] = base;
+    }
+    
+    m_indexBuffer = m_backend->createBuffer();
+    m_backend->uploadBuffer(m_indexBuffer, indices.data(), indices.size() * sizeof(uint16_t), false);
+    renderer.recordBufferUpload(indices.size() * sizeof(uint16_t));
+}
+
+} // namespace GameEngine2D
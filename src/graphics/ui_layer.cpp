@@ -0,0 +1,351 @@
+#include "graphics/ui_layer.h"
+#include "graphics/renderer.h"
+#include "graphics/batch_renderer.h"
+#include "utils/logger.h"
+#include <algorithm>
+
+namespace GameEngine2D {
+
+namespace {
+
+constexpr size_t NOT_IN_STREAM = static_cast<size_t>(-1);
+
+} // namespace
+
+// UIWidget
+
+UIWidget::UIWidget()
+    : m_owner(nullptr), m_creationIndex(0), m_position(0.0f), m_size(0.0f), m_color(COLOR_WHITE),
+      m_texture(0), m_uvRect(0.0f, 0.0f, 1.0f, 1.0f), m_visible(true), m_layer(0),
+      m_dirty(false), m_streamOffset(NOT_IN_STREAM) {
+}
+
+void UIWidget::setPosition(const Vector2& position) {
+    if (position != m_position) {
+        m_position = position;
+        markDirty();
+    }
+}
+
+void UIWidget::setSize(const Vector2& size) {
+    if (size != m_size) {
+        m_size = size;
+        markDirty();
+    }
+}
+
+void UIWidget::setColor(const Color& color) {
+    if (color != m_color) {
+        m_color = color;
+        markDirty();
+    }
+}
+
+void UIWidget::setTexture(TextureID texture, const Vector4& uvRect) {
+    if (texture != m_texture) {
+        m_texture = texture;
+        m_uvRect = uvRect;
+        markDirty();
+        if (m_owner) {
+            m_owner->onWidgetDirty(this, true);
+        }
+    } else if (uvRect != m_uvRect) {
+        m_uvRect = uvRect;
+        markDirty();
+    }
+}
+
+void UIWidget::setVisible(bool visible) {
+    if (visible != m_visible) {
+        m_visible = visible;
+        if (m_owner) {
+            m_owner->onWidgetDirty(this, true);
+        }
+    }
+}
+
+void UIWidget::setLayer(int layer) {
+    if (layer != m_layer) {
+        m_layer = layer;
+        if (m_owner) {
+            m_owner->onWidgetDirty(this, true);
+        }
+    }
+}
+
+void UIWidget::markDirty() {
+    if (m_dirty) {
+        return;
+    }
+    m_dirty = true;
+    if (m_owner) {
+        m_owner->onWidgetDirty(this, false);
+    }
+}
+
+void UIWidget::appendQuad(std::vector<PackedVertex>& vertices, float x0, float y0, float x1, float y1,
+                          float u0, float v0, float u1, float v1, uint32_t color) {
+    PackedVertex vertex;
+    vertex.position = Vector2(x0, y0);
+    vertex.texCoord[0] = VertexPacking::packUnorm16(u0);
+    vertex.texCoord[1] = VertexPacking::packUnorm16(v0);
+    vertex.color = color;
+    vertex.depth = 0;
+    vertex.textureIndex = 0;
+    
+    // Same corner order as BatchRenderer::drawQuad
+    vertices.push_back(vertex);
+    vertex.position.x = x1;
+    vertex.texCoord[0] = VertexPacking::packUnorm16(u1);
+    vertices.push_back(vertex);
+    vertex.position.y = y1;
+    vertex.texCoord[1] = VertexPacking::packUnorm16(v1);
+    vertices.push_back(vertex);
+    vertex.position.x = x0;
+    vertex.texCoord[0] = VertexPacking::packUnorm16(u0);
+    vertices.push_back(vertex);
+}
+
+// UIImage
+
+void UIImage::buildGeometry(std::vector<PackedVertex>& vertices) const {
+    const Vector2& position = getPosition();
+    const Vector2& size = getSize();
+    const Vector4& uv = getUVRect();
+    if (size.x <= 0.0f || size.y <= 0.0f) {
+        return;
+    }
+    appendQuad(vertices, position.x, position.y, position.x + size.x, position.y + size.y,
+               uv.x, uv.y, uv.z, uv.w, VertexPacking::packColor(getColor()));
+}
+
+// UIPanel
+
+void UIPanel::setBorder(const UIBorder& border, const Vector2& sourceSize) {
+    m_border = border;
+    m_sourceSize = Vector2(std::max(sourceSize.x, 1.0f), std::max(sourceSize.y, 1.0f));
+    markDirty();
+}
+
+void UIPanel::buildGeometry(std::vector<PackedVertex>& vertices) const {
+    const Vector2& position = getPosition();
+    const Vector2& size = getSize();
+    const Vector4& uv = getUVRect();
+    if (size.x <= 0.0f || size.y <= 0.0f) {
+        return;
+    }
+    
+    // Insets are drawn at one unit per texel unless the panel is too small
+    float horizontal = m_border.left + m_border.right;
+    float vertical = m_border.top + m_border.bottom;
+    float scaleX = horizontal > size.x ? size.x / horizontal : 1.0f;
+    float scaleY = vertical > size.y ? size.y / vertical : 1.0f;
+    
+    float x[4] = { position.x, position.x + m_border.left * scaleX,
+                   position.x + size.x - m_border.right * scaleX, position.x + size.x };
+    float y[4] = { position.y, position.y + m_border.top * scaleY,
+                   position.y + size.y - m_border.bottom * scaleY, position.y + size.y };
+    
+    float texelU = (uv.z - uv.x) / m_sourceSize.x;
+    float texelV = (uv.w - uv.y) / m_sourceSize.y;
+    float u[4] = { uv.x, uv.x + m_border.left * texelU, uv.z - m_border.right * texelU, uv.z };
+    float v[4] = { uv.y, uv.y + m_border.top * texelV, uv.w - m_border.bottom * texelV, uv.w };
+    
+    uint32_t color = VertexPacking::packColor(getColor());
+    for (int row = 0; row < 3; ++row) {
+        if (y[row + 1] <= y[row]) {
+            continue;
+        }
+        for (int column = 0; column < 3; ++column) {
+            if (x[column + 1] <= x[column]) {
+                continue;
+            }
+            appendQuad(vertices, x[column], y[row], x[column + 1], y[row + 1],
+                       u[column], v[row], u[column + 1], v[row + 1], color);
+        }
+    }
+}
+
+// UIProgressBar
+
+void UIProgressBar::setValue(float value) {
+    value = std::clamp(value, 0.0f, 1.0f);
+    if (value != m_value) {
+        m_value = value;
+        markDirty();
+    }
+}
+
+void UIProgressBar::setFillColor(const Color& color) {
+    if (color != m_fillColor) {
+        m_fillColor = color;
+        markDirty();
+    }
+}
+
+void UIProgressBar::buildGeometry(std::vector<PackedVertex>& vertices) const {
+    const Vector2& position = getPosition();
+    const Vector2& size = getSize();
+    const Vector4& uv = getUVRect();
+    if (size.x <= 0.0f || size.y <= 0.0f) {
+        return;
+    }
+    
+    float x1 = position.x + size.x;
+    float y1 = position.y + size.y;
+    appendQuad(vertices, position.x, position.y, x1, y1, uv.x, uv.y, uv.z, uv.w,
+               VertexPacking::packColor(getColor()));
+    
+    // The fill quad is always emitted so value changes never alter the
+    // quad count and stay in-place patches
+    float fillX = position.x + size.x * m_value;
+    float fillU = uv.x + (uv.z - uv.x) * m_value;
+    appendQuad(vertices, position.x, position.y, fillX, y1, uv.x, uv.y, fillU, uv.w,
+               VertexPacking::packColor(m_fillColor));
+}
+
+// UILayer
+
+UILayer::UILayer() : m_nextCreationIndex(0), m_streamDirty(false) {
+}
+
+UILayer::~UILayer() {
+    clear();
+}
+
+void UILayer::attach(std::unique_ptr<UIWidget> widget) {
+    widget->m_owner = this;
+    widget->m_creationIndex = m_nextCreationIndex++;
+    widget->m_dirty = true;
+    m_dirtyWidgets.push_back(widget.get());
+    m_widgets.push_back(std::move(widget));
+    m_streamDirty = true;
+}
+
+void UILayer::destroy(UIWidget* widget) {
+    auto it = std::find_if(m_widgets.begin(), m_widgets.end(),
+                           [widget](const std::unique_ptr<UIWidget>& owned) { return owned.get() == widget; });
+    if (it == m_widgets.end()) {
+        LOG_WARNING("UILayer::destroy called with a widget it does not own");
+        return;
+    }
+    
+    m_dirtyWidgets.erase(std::remove(m_dirtyWidgets.begin(), m_dirtyWidgets.end(), widget), m_dirtyWidgets.end());
+    m_widgets.erase(it);
+    m_drawOrder.clear();
+    m_streamDirty = true;
+}
+
+void UILayer::clear() {
+    m_widgets.clear();
+    m_dirtyWidgets.clear();
+    m_drawOrder.clear();
+    m_stream.clear();
+    m_runs.clear();
+    m_streamDirty = false;
+}
+
+void UILayer::onWidgetDirty(UIWidget* widget, bool structural) {
+    if (structural) {
+        m_streamDirty = true;
+    } else {
+        m_dirtyWidgets.push_back(widget);
+    }
+}
+
+void UILayer::render(Renderer& renderer, BatchRenderer& batch, std::shared_ptr<Shader> shader,
+                     const Matrix4& projection) {
+    if (batch.isDrawing()) {
+        LOG_WARNING("UILayer::render called while the batch is drawing");
+        return;
+    }
+    
+    m_stats = UILayerStats{};
+    m_stats.widgets = static_cast<uint32_t>(m_widgets.size());
+    
+    // Regenerate only what changed; same-sized geometry is patched in place
+    for (UIWidget* widget : m_dirtyWidgets) {
+        size_t previousCount = widget->m_vertices.size();
+        widget->m_vertices.clear();
+        widget->buildGeometry(widget->m_vertices);
+        widget->m_dirty = false;
+        m_stats.rebuiltWidgets++;
+        
+        if (m_streamDirty || !widget->m_visible) {
+            continue;
+        }
+        if (widget->m_streamOffset == NOT_IN_STREAM || widget->m_vertices.size() != previousCount) {
+            m_streamDirty = true;
+        } else {
+            std::copy(widget->m_vertices.begin(), widget->m_vertices.end(),
+                      m_stream.begin() + widget->m_streamOffset);
+        }
+    }
+    m_dirtyWidgets.clear();
+    
+    if (m_streamDirty) {
+        rebuildStream();
+        m_stats.streamRebuilt = true;
+    }
+    
+    m_stats.quads = static_cast<uint32_t>(m_stream.size() / 4);
+    m_stats.runs = static_cast<uint32_t>(m_runs.size());
+    if (m_stream.empty()) {
+        return;
+    }
+    
+    // Overlay: drawn in submission order over whatever the scene left in depth
+    bool depthTest = renderer.isDepthTestEnabled();
+    bool blending = renderer.isBlendingEnabled();
+    renderer.enableDepthTest(false);
+    renderer.enableBlending(true);
+    
+    batch.begin(renderer, shader, Matrix4(1.0f), projection);
+    for (const Run& run : m_runs) {
+        batch.drawQuads(m_stream.data() + run.firstVertex, run.quadCount, run.texture);
+    }
+    batch.end();
+    
+    renderer.enableDepthTest(depthTest);
+    renderer.enableBlending(blending);
+}
+
+void UILayer::rebuildStream() {
+    for (const auto& widget : m_widgets) {
+        widget->m_streamOffset = NOT_IN_STREAM;
+    }
+    
+    m_drawOrder.clear();
+    for (const auto& widget : m_widgets) {
+        if (widget->m_visible && !widget->m_vertices.empty()) {
+            m_drawOrder.push_back(widget.get());
+        }
+    }
+    std::sort(m_drawOrder.begin(), m_drawOrder.end(), [](const UIWidget* a, const UIWidget* b) {
+        if (a->m_layer != b->m_layer) {
+            return a->m_layer < b->m_layer;
+        }
+        if (a->m_texture != b->m_texture) {
+            return a->m_texture < b->m_texture;
+        }
+        return a->m_creationIndex < b->m_creationIndex;
+    });
+    
+    // Adjacent widgets sharing a texture merge into one run, across layers too
+    m_stream.clear();
+    m_runs.clear();
+    for (UIWidget* widget : m_drawOrder) {
+        widget->m_streamOffset = m_stream.size();
+        m_stream.insert(m_stream.end(), widget->m_vertices.begin(), widget->m_vertices.end());
+        
+        size_t quads = widget->m_vertices.size() / 4;
+        if (!m_runs.empty() && m_runs.back().texture == widget->m_texture) {
+            m_runs.back().quadCount += quads;
+        } else {
+            m_runs.push_back(Run{ widget->m_texture, widget->m_streamOffset, quads });
+        }
+    }
+    m_streamDirty = false;
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,136 @@
+#include "graphics/uniform_buffer.h"
+#include "graphics/render_backend.h"
+#include "utils/logger.h"
+#include <cstring>
+#include <cstddef>
+
+namespace GameEngine2D {
+
+namespace {
+
+// Kept in sync with FrameUniforms, CameraUniforms and the layouts below
+const char* const SHARED_BLOCKS_SOURCE = R"(
+    #pragma once
+    layout (std140) uniform FrameData {
+        vec2 uScreenSize;
+        vec2 uRenderSize;
+        float uTime;
+        float uDeltaTime;
+    };
+    
+    layout (std140) uniform CameraData {
+        mat4 uView;
+        mat4 uProjection;
+        mat4 uViewProjection;
+        vec2 uCameraPosition;
+        float uCameraZoom;
+    };
+)";
+
+const std::vector<UniformBlockLayout>& getSharedLayouts() {
+    static const std::vector<UniformBlockLayout> layouts = {
+        { "FrameData", UniformBlockBinding::FRAME, sizeof(FrameUniforms), {
+            { "uScreenSize", offsetof(FrameUniforms, screenSize) },
+            { "uRenderSize", offsetof(FrameUniforms, renderSize) },
+            { "uTime", offsetof(FrameUniforms, time) },
+            { "uDeltaTime", offsetof(FrameUniforms, deltaTime) }
+        } },
+        { "CameraData", UniformBlockBinding::CAMERA, sizeof(CameraUniforms), {
+            { "uView", offsetof(CameraUniforms, view) },
+            { "uProjection", offsetof(CameraUniforms, projection) },
+            { "uViewProjection", offsetof(CameraUniforms, viewProjection) },
+            { "uCameraPosition", offsetof(CameraUniforms, position) },
+            { "uCameraZoom", offsetof(CameraUniforms, zoom) }
+        } }
+    };
+    return layouts;
+}
+
+} // namespace
+
+const UniformBlockLayout* UniformBlockLayout::find(const std::string& name) {
+    for (const auto& layout : getSharedLayouts()) {
+        if (name == layout.name) {
+            return &layout;
+        }
+    }
+    return nullptr;
+}
+
+const char* UniformBlockLayout::getSource() {
+    return SHARED_BLOCKS_SOURCE;
+}
+
+SharedUniformBuffers::SharedUniformBuffers()
+    : m_backend(nullptr), m_frameBuffer(0), m_cameraBuffer(0), m_cameraValid(false) {
+}
+
+SharedUniformBuffers::~SharedUniformBuffers() {
+    shutdown();
+}
+
+bool SharedUniformBuffers::initialize(RenderBackend& backend) {
+    if (m_backend) {
+        return true;
+    }
+    
+    m_frameBuffer = backend.createBuffer();
+    m_cameraBuffer = backend.createBuffer();
+    if (m_frameBuffer == 0 || m_cameraBuffer == 0) {
+        LOG_ERROR("Failed to create shared uniform buffers");
+        backend.destroyBuffer(m_frameBuffer);
+        backend.destroyBuffer(m_cameraBuffer);
+        m_frameBuffer = m_cameraBuffer = 0;
+        return false;
+    }
+    
+    m_backend = &backend;
+    m_frame = FrameUniforms{};
+    m_camera = CameraUniforms{};
+    m_backend->uploadBuffer(m_frameBuffer, &m_frame, sizeof(m_frame), true);
+    m_backend->uploadBuffer(m_cameraBuffer, &m_camera, sizeof(m_camera), true);
+    m_backend->bindUniformBuffer(static_cast<unsigned int>(UniformBlockBinding::FRAME), m_frameBuffer);
+    m_backend->bindUniformBuffer(static_cast<unsigned int>(UniformBlockBinding::CAMERA), m_cameraBuffer);
+    m_cameraValid = false;
+    return true;
+}
+
+void SharedUniformBuffers::shutdown() {
+    if (!m_backend) {
+        return;
+    }
+    
+    m_backend->destroyBuffer(m_frameBuffer);
+    m_backend->destroyBuffer(m_cameraBuffer);
+    m_frameBuffer = m_cameraBuffer = 0;
+    m_backend = nullptr;
+}
+
+size_t SharedUniformBuffers::updateFrame(const FrameUniforms& frame) {
+    if (!m_backend) {
+        return 0;
+    }
+    
+    m_frame = frame;
+    m_backend->updateBuffer(m_frameBuffer, 0, &m_frame, sizeof(m_frame));
+    return sizeof(m_frame);
+}
+
+size_t SharedUniformBuffers::updateCamera(const CameraUniforms& camera) {
+    if (!m_backend) {
+        return 0;
+    }
+    
+    // Several systems draw with the same camera each frame; only the first
+    // one pays for the upload
+    if (m_cameraValid && std::memcmp(&camera, &m_camera, sizeof(camera)) == 0) {
+        return 0;
+    }
+    
+    m_camera = camera;
+    m_cameraValid = true;
+    m_backend->updateBuffer(m_cameraBuffer, 0, &m_camera, sizeof(m_camera));
+    return sizeof(m_camera);
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,71 @@
+#include "graphics/uniform_handle.h"
+#include "utils/logger.h"
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <cstring>
+
+namespace GameEngine2D {
+
+namespace {
+
+// Names live in a deque so references handed out by getName stay valid
+struct UniformRegistry {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, uint32_t> indices;
+    std::deque<std::string> names;
+};
+
+UniformRegistry& getRegistry() {
+    static UniformRegistry registry;
+    return registry;
+}
+
+} // namespace
+
+UniformHandle::UniformHandle(const char* name)
+    : m_index(registerName(hash(name), name, std::strlen(name))) {
+}
+
+UniformHandle::UniformHandle(const std::string& name)
+    : m_index(registerName(HashUtils::fnv1a(name), name.data(), name.size())) {
+}
+
+const std::string& UniformHandle::getName() const {
+    static const std::string empty;
+    if (!isValid()) {
+        return empty;
+    }
+    
+    UniformRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.names[m_index];
+}
+
+uint32_t UniformHandle::getRegisteredCount() {
+    UniformRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return static_cast<uint32_t>(registry.names.size());
+}
+
+uint32_t UniformHandle::registerName(uint64_t hash, const char* name, size_t length) {
+    UniformRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    
+    auto it = registry.indices.find(hash);
+    if (it != registry.indices.end()) {
+        const std::string& existing = registry.names[it->second];
+        if (existing.size() != length || existing.compare(0, length, name, length) != 0) {
+            LOG_ERROR_FMT("Uniform name hash collision between '{}' and '{}'", existing, std::string(name, length));
+            return INVALID_INDEX;
+        }
+        return it->second;
+    }
+    
+    uint32_t index = static_cast<uint32_t>(registry.names.size());
+    registry.names.emplace_back(name, length);
+    registry.indices.emplace(hash, index);
+    return index;
+}
+
+} // namespace GameEngine2D
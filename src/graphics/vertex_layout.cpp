@@ -0,0 +1,165 @@
+#include "graphics/vertex_layout.h"
+#include "utils/logger.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace GameEngine2D {
+
+namespace {
+
+GLenum toGLType(VertexAttributeType type) {
+    switch (type) {
+        case VertexAttributeType::HALF_FLOAT: return GL_HALF_FLOAT;
+        case VertexAttributeType::BYTE: return GL_BYTE;
+        case VertexAttributeType::UNSIGNED_BYTE: return GL_UNSIGNED_BYTE;
+        case VertexAttributeType::SHORT: return GL_SHORT;
+        case VertexAttributeType::UNSIGNED_SHORT: return GL_UNSIGNED_SHORT;
+        case VertexAttributeType::INT: return GL_INT;
+        case VertexAttributeType::UNSIGNED_INT: return GL_UNSIGNED_INT;
+        case VertexAttributeType::FLOAT:
+        default: return GL_FLOAT;
+    }
+}
+
+} // namespace
+
+VertexLayout::VertexLayout(size_t stride) : m_stride(stride) {
+}
+
+VertexLayout& VertexLayout::add(unsigned int location, int components, VertexAttributeType type, size_t offset,
+                                VertexAttributeMode mode) {
+    VertexAttribute attribute;
+    attribute.location = location;
+    attribute.components = components;
+    attribute.type = type;
+    attribute.mode = mode;
+    attribute.offset = offset;
+    m_attributes.push_back(attribute);
+    
+    // Tightly packed layouts can omit the stride
+    size_t end = offset + getTypeSize(type) * components;
+    if (m_stride < end) {
+        m_stride = end;
+    }
+    return *this;
+}
+
+void VertexLayout::apply() const {
+    if (!isValid()) {
+        LOG_ERROR("Invalid vertex layout");
+        return;
+    }
+    
+    GLsizei stride = static_cast<GLsizei>(m_stride);
+    for (const auto& attribute : m_attributes) {
+        const void* offset = reinterpret_cast<const void*>(attribute.offset);
+        glEnableVertexAttribArray(attribute.location);
+        
+        if (attribute.mode == VertexAttributeMode::INTEGER) {
+            glVertexAttribIPointer(attribute.location, attribute.components, toGLType(attribute.type),
+                                   stride, offset);
+        } else {
+            GLboolean normalized = attribute.mode == VertexAttributeMode::NORMALIZED ? GL_TRUE : GL_FALSE;
+            glVertexAttribPointer(attribute.location, attribute.components, toGLType(attribute.type),
+                                  normalized, stride, offset);
+        }
+    }
+}
+
+bool VertexLayout::isValid() const {
+    if (m_attributes.empty()) {
+        return false;
+    }
+    
+    for (const auto& attribute : m_attributes) {
+        if (attribute.components < 1 || attribute.components > 4) {
+            return false;
+        }
+        if (attribute.mode == VertexAttributeMode::INTEGER &&
+            (attribute.type == VertexAttributeType::FLOAT || attribute.type == VertexAttributeType::HALF_FLOAT)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t VertexLayout::getTypeSize(VertexAttributeType type) {
+    switch (type) {
+        case VertexAttributeType::BYTE:
+        case VertexAttributeType::UNSIGNED_BYTE:
+            return 1;
+        case VertexAttributeType::HALF_FLOAT:
+        case VertexAttributeType::SHORT:
+        case VertexAttributeType::UNSIGNED_SHORT:
+            return 2;
+        case VertexAttributeType::FLOAT:
+        case VertexAttributeType::INT:
+        case VertexAttributeType::UNSIGNED_INT:
+        default:
+            return 4;
+    }
+}
+
+const VertexLayout& PackedVertex::getLayout() {
+    static const VertexLayout layout = VertexLayout(sizeof(PackedVertex))
+        .add(0, 2, VertexAttributeType::FLOAT, offsetof(PackedVertex, position))
+        .add(1, 2, VertexAttributeType::UNSIGNED_SHORT, offsetof(PackedVertex, texCoord), VertexAttributeMode::NORMALIZED)
+        .add(2, 4, VertexAttributeType::UNSIGNED_BYTE, offsetof(PackedVertex, color), VertexAttributeMode::NORMALIZED)
+        .add(3, 1, VertexAttributeType::HALF_FLOAT, offsetof(PackedVertex, depth))
+        .add(4, 1, VertexAttributeType::UNSIGNED_SHORT, offsetof(PackedVertex, textureIndex), VertexAttributeMode::INTEGER);
+    return layout;
+}
+
+// VertexPacking implementation
+uint16_t VertexPacking::packUnorm16(float value) {
+    // Repeating UVs outside [0, 1] need the float vertex format
+    return static_cast<uint16_t>(std::round(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+uint32_t VertexPacking::packColor(const Color& color) {
+    // Byte order matches an RGBA8 attribute read on little-endian hosts
+    auto channel = [](float value) {
+        return static_cast<uint32_t>(std::round(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    };
+    return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+}
+
+uint16_t VertexPacking::packHalf(float value) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    
+    uint32_t sign = (bits >> 16) & 0x8000;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+    
+    // Depth values never need subnormal precision, so flush them to zero;
+    // anything out of range (including NaN) saturates to infinity
+    if (exponent <= 0) {
+        return static_cast<uint16_t>(sign);
+    }
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7c00);
+    }
+    
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000) {
+        half++;
+    }
+    return static_cast<uint16_t>(half);
+}
+
+PackedVertex VertexPacking::pack(const Vector3& position, const Vector2& texCoord, const Color& color,
+                                 uint16_t textureIndex) {
+    PackedVertex vertex;
+    vertex.position = Vector2(position.x, position.y);
+    vertex.texCoord[0] = packUnorm16(texCoord.x);
+    vertex.texCoord[1] = packUnorm16(texCoord.y);
+    vertex.color = packColor(color);
+    vertex.depth = packHalf(position.z);
+    vertex.textureIndex = textureIndex;
+    return vertex;
+}
+
+} // namespace GameEngine2D
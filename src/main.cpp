@@ -76,6 +76,25 @@ public:
         std::cout << "Frame Time: " << (getFrameTime() * 1000.0f) << " ms" << std::endl;
         std::cout << "Delta Time: " << (getDeltaTime() * 1000.0f) << " ms" << std::endl;
         
+        const RenderStats& stats = getRenderStats();
+        std::cout << "Draw Calls: " << stats.drawCalls << std::endl;
+        std::cout << "Vertices: " << stats.vertices << " (" << stats.instances << " instances)" << std::endl;
+        std::cout << "State Changes: " << stats.stateChanges << std::endl;
+        std::cout << "Texture Binds: " << stats.textureBinds << std::endl;
+        std::cout << "Buffer Uploads: " << stats.bufferUploadBytes << " bytes" << std::endl;
+        std::cout << "Uniform Uploads: " << stats.uniformUploads << " (" << stats.uniformUploadsSkipped << " skipped)" << std::endl;
+        std::cout << "Render CPU Time: " << stats.cpuTimeMs << " ms" << std::endl;
+        std::cout << "Resolution Scale: " << static_cast<int>(stats.resolutionScale * 100.0f + 0.5f) << "%" << std::endl;
+        std::cout << "Render Targets: " << stats.renderTargets << " (" << (stats.renderTargetMemoryBytes / 1024) << " KB)" << std::endl;
+        if (stats.gpuTimeValid) {
+            std::cout << "Render GPU Time: " << stats.gpuTimeMs << " ms (frame " << stats.gpuFrameIndex << ")" << std::endl;
+            for (const auto& pass : stats.passes) {
+                std::cout << "  " << pass.name << ": " << pass.gpuTimeMs << " ms" << std::endl;
+            }
+        } else {
+            std::cout << "Render GPU Time: unavailable" << std::endl;
+        }
+        
         if (getWindow()) {
             std::cout << "Window Size: " << getWindow()->getWidth() << "x" << getWindow()->getHeight() << std::endl;
             std::cout << "VSync: " << (getWindow()->isVSyncEnabled() ? "Enabled" : "Disabled") << std::endl;
@@ -0,0 +1,164 @@
+#include "scene/archetype.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+namespace GameEngine2D {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+Archetype::Archetype(ComponentMask mask)
+    : m_mask(mask), m_chunkCapacity(0), m_entityCount(0) {
+    m_columnIndex.fill(-1);
+    m_addEdges.fill(nullptr);
+    m_removeEdges.fill(nullptr);
+    
+    ComponentRegistry& registry = ComponentRegistry::getInstance();
+    std::vector<ChunkColumnLayout> layout;
+    for (ComponentID id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+        if ((mask >> id) & 1) {
+            const ComponentInfo& info = registry.getInfo(id);
+            m_columnIndex[id] = static_cast<int>(m_columns.size());
+            m_components.push_back(id);
+            m_columns.push_back({ id, 0, static_cast<uint32_t>(info.size) });
+            layout.push_back({ info.size, info.alignment, 0 });
+        }
+    }
+    
+    m_chunkCapacity = computeChunkLayout(layout);
+    if (m_chunkCapacity == 0) {
+        LOG_ERROR("Component set does not fit a chunk");
+        std::abort();
+    }
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        m_columns[i].offset = layout[i].offset;
+    }
+}
+
+uint32_t Archetype::computeChunkLayout(std::vector<ChunkColumnLayout>& columns) {
+    size_t rowBytes = sizeof(Entity);
+    for (const auto& column : columns) {
+        rowBytes += column.size;
+    }
+    
+    // Start from the unpadded estimate and back off until the aligned columns fit
+    for (size_t capacity = ARCHETYPE_CHUNK_SIZE / rowBytes; capacity > 0; --capacity) {
+        size_t offset = sizeof(Entity) * capacity;
+        for (auto& column : columns) {
+            offset = alignUp(offset, column.alignment);
+            column.offset = static_cast<uint32_t>(offset);
+            offset += column.size * capacity;
+        }
+        if (offset <= ARCHETYPE_CHUNK_SIZE) {
+            return static_cast<uint32_t>(capacity);
+        }
+    }
+    return 0;
+}
+
+uint32_t Archetype::allocateRow(Entity entity) {
+    if (m_chunks.empty() || m_chunks.back()->count == m_chunkCapacity) {
+        addChunk();
+    }
+    
+    ArchetypeChunk& chunk = *m_chunks.back();
+    getEntities(chunk)[chunk.count] = entity;
+    chunk.count++;
+    return m_entityCount++;
+}
+
+uint32_t Archetype::allocateRows(uint32_t count) {
+    uint32_t firstRow = m_entityCount;
+    uint32_t remaining = count;
+    while (remaining > 0) {
+        if (m_chunks.empty() || m_chunks.back()->count == m_chunkCapacity) {
+            addChunk();
+        }
+        
+        ArchetypeChunk& chunk = *m_chunks.back();
+        uint32_t rows = std::min(remaining, m_chunkCapacity - chunk.count);
+        chunk.count += rows;
+        remaining -= rows;
+    }
+    m_entityCount += count;
+    return firstRow;
+}
+
+Entity Archetype::removeRow(uint32_t row) {
+    uint32_t last = m_entityCount - 1;
+    ArchetypeChunk& lastChunk = *m_chunks.back();
+    uint32_t lastIndex = lastChunk.count - 1;
+    
+    Entity moved;
+    if (row != last) {
+        ArchetypeChunk& chunk = *m_chunks[row / m_chunkCapacity];
+        uint32_t index = row % m_chunkCapacity;
+        for (const auto& column : m_columns) {
+            std::memcpy(chunk.data + column.offset + index * column.size,
+                        lastChunk.data + column.offset + lastIndex * column.size, column.size);
+        }
+        moved = getEntities(lastChunk)[lastIndex];
+        getEntities(chunk)[index] = moved;
+    }
+    
+    lastChunk.count--;
+    m_entityCount--;
+    if (lastChunk.count == 0) {
+        releaseChunk(std::move(m_chunks.back()));
+        m_chunks.pop_back();
+    }
+    return moved;
+}
+
+uint32_t Archetype::appendChunk(ArchetypeChunk* chunk, bool owned) {
+    uint32_t firstRow = m_entityCount;
+    m_chunks.push_back(ArchetypeChunkPtr(chunk, ArchetypeChunkDeleter{ owned }));
+    growChangeVersions();
+    m_entityCount += chunk->count;
+    return firstRow;
+}
+
+void Archetype::clear() {
+    for (auto& chunk : m_chunks) {
+        releaseChunk(std::move(chunk));
+    }
+    m_chunks.clear();
+    m_entityCount = 0;
+}
+
+void Archetype::addChunk() {
+    if (m_spareChunk) {
+        m_chunks.push_back(std::move(m_spareChunk));
+    } else {
+        m_chunks.push_back(ArchetypeChunkPtr(new ArchetypeChunk()));
+    }
+    m_chunks.back()->count = 0;
+    growChangeVersions();
+}
+
+void Archetype::growChangeVersions() {
+    // Kept at its high-water mark so chunks flipping in and out at a
+    // boundary don't resize it. Reused slots keep stale versions; every
+    // path that adds rows marks their chunk straight after.
+    size_t needed = m_chunks.size() * m_columns.size();
+    if (needed > m_changeVersions.size()) {
+        m_changeVersions.resize(std::max(needed, m_changeVersions.size() * 2));
+    }
+}
+
+void Archetype::releaseChunk(ArchetypeChunkPtr chunk) {
+    // Adopted chunks are never kept, so clearing drops every reference into
+    // memory the archetype doesn't own
+    if (!m_spareChunk && chunk.get_deleter().owned) {
+        m_spareChunk = std::move(chunk);
+    }
+}
+
+} // namespace GameEngine2D
@@ -0,0 +1,199 @@
+#include "scene/command_buffer.h"
+#include "core/job_system.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace GameEngine2D {
+
+CommandBuffer::CommandBuffer(World& world) : m_world(&world) {
+}
+
+CommandBuffer::~CommandBuffer() {
+}
+
+Entity CommandBuffer::createEntity(uint64_t sortKey) {
+    Entity entity = m_world->reserveEntity();
+    m_commands.push_back({ sortKey, entity, INVALID_COMPONENT, 0, 0, CommandType::CREATE });
+    return entity;
+}
+
+void CommandBuffer::destroyEntity(uint64_t sortKey, Entity entity) {
+    m_commands.push_back({ sortKey, entity, INVALID_COMPONENT, 0, 0, CommandType::DESTROY });
+}
+
+void CommandBuffer::addComponent(uint64_t sortKey, Entity entity, ComponentID id, const void* value) {
+    recordAdd(sortKey, entity, id, value, ComponentRegistry::getInstance().getInfo(id).size);
+}
+
+void CommandBuffer::removeComponent(uint64_t sortKey, Entity entity, ComponentID id) {
+    m_commands.push_back({ sortKey, entity, id, 0, 0, CommandType::REMOVE });
+}
+
+void CommandBuffer::recordAdd(uint64_t sortKey, Entity entity, ComponentID id, const void* value, size_t size) {
+    // Values are packed back to back; playback copies them bytewise, so
+    // they need no alignment here
+    uint32_t offset = static_cast<uint32_t>(m_data.size());
+    m_data.resize(m_data.size() + size);
+    std::memcpy(m_data.data() + offset, value, size);
+    m_commands.push_back({ sortKey, entity, id, offset, static_cast<uint32_t>(size), CommandType::ADD });
+}
+
+CommandPlaybackStats CommandBuffer::playback() {
+    CommandBuffer* self = this;
+    return execute(*m_world, &self, 1);
+}
+
+void CommandBuffer::clear() {
+    for (const auto& command : m_commands) {
+        if (command.type == CommandType::CREATE) {
+            m_world->releaseReservedEntity(command.entity);
+        }
+    }
+    m_commands.clear();
+    m_data.clear();
+}
+
+CommandPlaybackStats CommandBuffer::execute(World& world, CommandBuffer* const* buffers, size_t bufferCount) {
+    CommandPlaybackStats stats;
+    std::vector<CommandRef> order;
+    for (size_t buffer = 0; buffer < bufferCount; ++buffer) {
+        const auto& commands = buffers[buffer]->m_commands;
+        for (size_t index = 0; index < commands.size(); ++index) {
+            order.push_back({ commands[index].sortKey, static_cast<uint32_t>(buffer), static_cast<uint32_t>(index) });
+        }
+    }
+    std::sort(order.begin(), order.end(), [](const CommandRef& a, const CommandRef& b) {
+        if (a.sortKey != b.sortKey) {
+            return a.sortKey < b.sortKey;
+        }
+        return a.buffer != b.buffer ? a.buffer < b.buffer : a.index < b.index;
+    });
+    
+    auto commandAt = [buffers, &order](size_t position) -> const Command& {
+        return buffers[order[position].buffer]->m_commands[order[position].index];
+    };
+    auto valueOf = [buffers, &order](size_t position, const Command& command) -> const void* {
+        return buffers[order[position].buffer]->m_data.data() + command.dataOffset;
+    };
+    
+    for (size_t position = 0; position < order.size();) {
+        const Command& command = commandAt(position);
+        switch (command.type) {
+        case CommandType::CREATE: {
+            // Fold the adds that follow into the archetype the entity starts in
+            size_t end = position + 1;
+            ComponentMask mask = 0;
+            for (; end < order.size(); ++end) {
+                const Command& next = commandAt(end);
+                if (next.type != CommandType::ADD || next.entity != command.entity) {
+                    break;
+                }
+                mask |= ComponentMask(1) << next.component;
+            }
+            
+            if (world.createReservedEntity(command.entity, world.findOrCreateArchetype(mask))) {
+                for (size_t add = position + 1; add < end; ++add) {
+                    const Command& next = commandAt(add);
+                    std::memcpy(world.getComponent(command.entity, next.component), valueOf(add, next), next.dataSize);
+                }
+                stats.created++;
+                stats.added += static_cast<uint32_t>(end - position - 1);
+            } else {
+                stats.skipped += static_cast<uint32_t>(end - position);
+            }
+            position = end;
+            continue;
+        }
+        case CommandType::DESTROY:
+            if (world.destroyEntity(command.entity)) {
+                stats.destroyed++;
+            } else {
+                stats.skipped++;
+            }
+            break;
+        case CommandType::ADD:
+            if (world.isAlive(command.entity)) {
+                world.addComponent(command.entity, command.component, valueOf(position, command));
+                stats.added++;
+            } else {
+                stats.skipped++;
+            }
+            break;
+        case CommandType::REMOVE:
+            if (world.removeComponent(command.entity, command.component)) {
+                stats.removed++;
+            } else {
+                stats.skipped++;
+            }
+            break;
+        }
+        ++position;
+    }
+    
+    for (size_t buffer = 0; buffer < bufferCount; ++buffer) {
+        buffers[buffer]->m_commands.clear();
+        buffers[buffer]->m_data.clear();
+    }
+    return stats;
+}
+
+ThreadCommandBuffers::ThreadCommandBuffers() : m_world(nullptr) {
+}
+
+ThreadCommandBuffers::~ThreadCommandBuffers() {
+}
+
+void ThreadCommandBuffers::initialize(World& world) {
+    m_world = &world;
+    m_buffers.clear();
+    resize();
+}
+
+void ThreadCommandBuffers::resize() {
+    size_t threads = JobSystem::getInstance().getWorkerCount() + 1;
+    while (m_buffers.size() < threads) {
+        m_buffers.push_back(std::make_unique<CommandBuffer>(*m_world));
+    }
+}
+
+CommandBuffer& ThreadCommandBuffers::local() {
+    unsigned int index = JobSystem::getThreadIndex();
+    if (index >= m_buffers.size()) {
+        // Growing here would race with other threads recording
+        LOG_ERROR("Command buffers used before initialize or after the job system grew");
+        std::abort();
+    }
+    return *m_buffers[index];
+}
+
+CommandPlaybackStats ThreadCommandBuffers::playback() {
+    if (!m_world) {
+        return CommandPlaybackStats();
+    }
+    
+    std::vector<CommandBuffer*> buffers;
+    for (auto& buffer : m_buffers) {
+        buffers.push_back(buffer.get());
+    }
+    CommandPlaybackStats stats = CommandBuffer::execute(*m_world, buffers.data(), buffers.size());
+    resize();
+    return stats;
+}
+
+void ThreadCommandBuffers::clear() {
+    for (auto& buffer : m_buffers) {
+        buffer->clear();
+    }
+}
+
+size_t ThreadCommandBuffers::getCommandCount() const {
+    size_t count = 0;
+    for (const auto& buffer : m_buffers) {
+        count += buffer->getCommandCount();
+    }
+    return count;
+}
+
+} // namespace GameEngine2D
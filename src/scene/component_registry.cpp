@@ -0,0 +1,60 @@
+#include "scene/component_registry.h"
+#include "utils/logger.h"
+#include <cstdlib>
+
+namespace GameEngine2D {
+
+ComponentRegistry& ComponentRegistry::getInstance() {
+    static ComponentRegistry instance;
+    return instance;
+}
+
+ComponentID ComponentRegistry::registerType(const char* name, size_t size, size_t alignment) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_components.size() >= MAX_COMPONENT_TYPES) {
+        // Masks can't represent the type; nothing sensible to fall back to
+        LOG_ERROR_FMT("Too many component types, {} cannot be registered", name);
+        std::abort();
+    }
+    
+    ComponentInfo info;
+    info.id = static_cast<ComponentID>(m_components.size());
+    info.name = name;
+    info.size = size;
+    info.alignment = alignment;
+    m_components.push_back(info);
+    return info.id;
+}
+
+void ComponentRegistry::setName(ComponentID id, const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& info : m_components) {
+        if (info.id != id && info.name == name) {
+            LOG_WARNING_FMT("Component name '{}' is already registered", name);
+            return;
+        }
+    }
+    m_components[id].name = name;
+}
+
+const ComponentInfo& ComponentRegistry::getInfo(ComponentID id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_components[id];
+}
+
+ComponentID ComponentRegistry::findByName(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& info : m_components) {
+        if (info.name == name) {
+            return info.id;
+        }
+    }
+    return INVALID_COMPONENT;
+}
+
+size_t ComponentRegistry::getCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_components.size();
+}
+
+} // namespace GameEngine2D
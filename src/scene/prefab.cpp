@@ -0,0 +1,102 @@
+#include "scene/prefab.h"
+#include <algorithm>
+#include <cstring>
+
+namespace GameEngine2D {
+
+Prefab::Prefab() : m_mask(0) {
+}
+
+Prefab::~Prefab() {
+}
+
+void Prefab::set(ComponentID id, const void* value) {
+    const ComponentInfo& info = ComponentRegistry::getInstance().getInfo(id);
+    auto it = std::find_if(m_values.begin(), m_values.end(), [id](const Value& entry) { return entry.id == id; });
+    if (it == m_values.end()) {
+        m_values.push_back({ id, std::vector<ValueBlock>((info.size + sizeof(ValueBlock) - 1) / sizeof(ValueBlock)) });
+        it = m_values.end() - 1;
+    }
+    std::memcpy(it->data.data(), value, info.size);
+    m_mask |= ComponentMask(1) << id;
+    m_stamp.reset();
+}
+
+bool Prefab::remove(ComponentID id) {
+    auto it = std::find_if(m_values.begin(), m_values.end(), [id](const Value& entry) { return entry.id == id; });
+    if (it == m_values.end()) {
+        return false;
+    }
+    m_values.erase(it);
+    m_mask &= ~(ComponentMask(1) << id);
+    m_stamp.reset();
+    return true;
+}
+
+const void* Prefab::get(ComponentID id) const {
+    for (const auto& entry : m_values) {
+        if (entry.id == id) {
+            return entry.data.data();
+        }
+    }
+    return nullptr;
+}
+
+const ArchetypeChunk& Prefab::getStamp(const Archetype& archetype) const {
+    // The layout depends only on the component set, so one stamp serves
+    // every world
+    if (m_stamp) {
+        return *m_stamp;
+    }
+    
+    m_stamp.reset(new ArchetypeChunk());
+    uint32_t capacity = archetype.getChunkCapacity();
+    for (size_t column = 0; column < archetype.getColumnCount(); ++column) {
+        int index = static_cast<int>(column);
+        size_t size = archetype.getColumnElementSize(index);
+        unsigned char* data = static_cast<unsigned char*>(archetype.getColumnData(*m_stamp, index));
+        
+        // Seed one row, then double the filled prefix until the column is full
+        std::memcpy(data, get(archetype.getColumnComponent(index)), size);
+        for (uint32_t filled = 1; filled < capacity;) {
+            uint32_t rows = std::min(filled, capacity - filled);
+            std::memcpy(data + filled * size, data, rows * size);
+            filled += rows;
+        }
+    }
+    m_stamp->count = capacity;
+    return *m_stamp;
+}
+
+uint32_t Prefab::instantiate(World& world, uint32_t count, const SpawnInitializer& initializer) const {
+    if (count == 0) {
+        return 0;
+    }
+    
+    Archetype& archetype = world.findOrCreateArchetype(m_mask);
+    const ArchetypeChunk& stamp = getStamp(archetype);
+    uint32_t row = world.createEntities(archetype, count, nullptr);
+    
+    // The stamp shares the archetype's layout, so each run is the same byte
+    // range of the stamp copied column by column
+    uint32_t capacity = archetype.getChunkCapacity();
+    for (uint32_t done = 0; done < count;) {
+        ArchetypeChunk& chunk = archetype.getChunk(row / capacity);
+        uint32_t first = row % capacity;
+        uint32_t rows = std::min(count - done, capacity - first);
+        for (size_t column = 0; column < archetype.getColumnCount(); ++column) {
+            int index = static_cast<int>(column);
+            size_t size = archetype.getColumnElementSize(index);
+            size_t offset = archetype.getColumnOffset(index) + first * size;
+            std::memcpy(chunk.data + offset, stamp.data + offset, rows * size);
+        }
+        if (initializer) {
+            initializer(SpawnRange(archetype, chunk, first, rows, done));
+        }
+        row += rows;
+        done += rows;
+    }
+    return count;
+}
+
+} // namespace GameEngine2D
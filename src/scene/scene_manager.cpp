@@ -1,9 +1,11 @@
 #include "scene/scene_manager.h"
+#include "scene/scene_serializer.h"
 #include "utils/logger.h"
+#include <chrono>
 
 namespace GameEngine2D {
 
-SceneManager::SceneManager() {
+SceneManager::SceneManager() : m_streamingFocus(0.0f, 0.0f) {
 }
 
 SceneManager::~SceneManager() {
@@ -11,16 +13,34 @@ SceneManager::~SceneManager() {
 }
 
 bool SceneManager::initialize() {
+    // After the job system, so there is a command buffer per worker
+    m_commands.initialize(m_world);
     LOG_INFO("SceneManager initialized");
     return true;
 }
 
 void SceneManager::shutdown() {
+    m_streamer.shutdown();
+    m_commands.clear();
+    m_world.clear();
+    m_transforms.clear();
     LOG_INFO("SceneManager shutdown");
 }
 
 void SceneManager::update(float deltaTime) {
     // Scene update logic
+    
+    // Component events from before last frame are no longer readable
+    m_world.retireComponentEvents();
+    
+    // Structural changes recorded by last frame's systems
+    m_commands.playback();
+    
+    // Cells merge at the frame boundary, before anything reads the world
+    m_streamer.update(m_streamingFocus);
+    
+    // World transforms for anything moved this frame, ready for rendering
+    m_transforms.updateParallel();
 }
 
 void SceneManager::fixedUpdate(float fixedDeltaTime) {
@@ -31,4 +51,34 @@ void SceneManager::render() {
     // Scene rendering logic
 }
 
+bool SceneManager::loadScene(const std::string& filepath) {
+    m_streamer.shutdown();
+    m_commands.clear();
+    m_world.clear();
+    m_transforms.clear();
+    SceneLoader loader(m_world);
+    return loader.load(filepath);
+}
+
+uint32_t SceneManager::spawnBatch(const Prefab& prefab, uint32_t count, const SpawnInitializer& initializer) {
+    auto start = std::chrono::high_resolution_clock::now();
+    uint32_t spawned = prefab.instantiate(m_world, count, initializer);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    
+    m_spawnStats.lastCount = spawned;
+    m_spawnStats.lastMs = elapsedMs;
+    m_spawnStats.lastNsPerEntity = spawned > 0 ? elapsedMs * 1.0e6 / spawned : 0.0;
+    m_spawnStats.totalCount += spawned;
+    m_spawnStats.totalMs += elapsedMs;
+    return spawned;
+}
+
+void SceneManager::startStreaming(const StreamingSettings& settings) {
+    m_streamer.initialize(m_world, settings);
+}
+
+void SceneManager::stopStreaming() {
+    m_streamer.shutdown();
+}
+
 } // namespace GameEngine2D
@@ -0,0 +1,712 @@
+#include "scene/scene_serializer.h"
+#include "utils/mapped_file.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace GameEngine2D {
+
+namespace {
+
+constexpr size_t SCENE_TABLE_ALIGNMENT = 8;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+bool isPowerOfTwo(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+// True when count elements of elementSize at offset lie inside the file
+bool tableFits(uint64_t offset, uint64_t count, size_t elementSize, size_t fileSize) {
+    return offset <= fileSize && count <= (fileSize - offset) / elementSize;
+}
+
+// Row counts follow from the archetype table (every chunk but the last is
+// full), so validation never has to fault in chunk pages to read them
+uint32_t getChunkRowCount(const SceneFileArchetype& archetype, uint32_t chunk) {
+    if (chunk + 1 < archetype.chunkCount) {
+        return archetype.chunkCapacity;
+    }
+    return static_cast<uint32_t>(archetype.entityCount - static_cast<uint64_t>(chunk) * archetype.chunkCapacity);
+}
+
+bool layoutMatches(const Archetype& archetype, const SceneFileArchetype& fileArchetype,
+                   const SceneFileColumn* columns, const std::vector<ComponentID>& componentIDs) {
+    if (archetype.getChunkCapacity() != fileArchetype.chunkCapacity ||
+        archetype.getColumnCount() != fileArchetype.columnCount) {
+        return false;
+    }
+    for (uint32_t i = 0; i < fileArchetype.columnCount; ++i) {
+        int column = static_cast<int>(i);
+        if (archetype.getColumnComponent(column) != componentIDs[columns[i].component] ||
+            archetype.getColumnOffset(column) != columns[i].offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Creates the chunk's entities and copies each column into them, in runs
+// that stay inside one world chunk
+void copyChunk(World& world, Archetype& archetype, const unsigned char* image, uint32_t count,
+               const SceneFileColumn* columns, uint32_t columnCount, const std::vector<ComponentID>& componentIDs,
+               Entity* entities) {
+    uint32_t firstRow = archetype.getEntityCount();
+    world.createEntities(archetype, count, entities);
+    
+    uint32_t capacity = archetype.getChunkCapacity();
+    for (uint32_t copied = 0; copied < count;) {
+        uint32_t row = firstRow + copied;
+        uint32_t run = std::min(count - copied, capacity - row % capacity);
+        for (uint32_t i = 0; i < columnCount; ++i) {
+            int column = archetype.getColumn(componentIDs[columns[i].component]);
+            size_t size = archetype.getColumnElementSize(column);
+            std::memcpy(archetype.getComponentData(row, column), image + columns[i].offset + copied * size, run * size);
+        }
+        copied += run;
+    }
+}
+
+enum class FieldType {
+    FLOAT,
+    INT,
+    UINT
+};
+
+bool parseFieldType(const std::string& name, FieldType& type) {
+    if (name == "float") {
+        type = FieldType::FLOAT;
+    } else if (name == "int") {
+        type = FieldType::INT;
+    } else if (name == "uint") {
+        type = FieldType::UINT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseField(const std::string& token, FieldType type, unsigned char* destination) {
+    const char* begin = token.c_str();
+    char* end = nullptr;
+    if (type == FieldType::FLOAT) {
+        float value = std::strtof(begin, &end);
+        std::memcpy(destination, &value, sizeof(value));
+    } else if (type == FieldType::INT) {
+        int32_t value = static_cast<int32_t>(std::strtol(begin, &end, 10));
+        std::memcpy(destination, &value, sizeof(value));
+    } else {
+        uint32_t value = static_cast<uint32_t>(std::strtoul(begin, &end, 10));
+        std::memcpy(destination, &value, sizeof(value));
+    }
+    return end != begin && *end == '\0';
+}
+
+} // namespace
+
+SceneWriter::SceneWriter() : m_entityCount(0) {
+}
+
+SceneWriter::~SceneWriter() {
+}
+
+uint32_t SceneWriter::addComponent(const std::string& name, uint32_t size, uint32_t alignment) {
+    for (uint32_t i = 0; i < m_components.size(); ++i) {
+        if (name == m_components[i].name) {
+            if (m_components[i].size != size) {
+                LOG_ERROR_FMT("Scene component '{}' added with sizes {} and {}", name, m_components[i].size, size);
+                return INVALID_COMPONENT;
+            }
+            return i;
+        }
+    }
+    
+    if (name.empty() || name.size() >= SCENE_COMPONENT_NAME_LENGTH) {
+        LOG_ERROR_FMT("Scene component name '{}' must be 1 to {} characters", name, SCENE_COMPONENT_NAME_LENGTH - 1);
+        return INVALID_COMPONENT;
+    }
+    if (m_components.size() >= MAX_COMPONENT_TYPES || size == 0 || !isPowerOfTwo(alignment) ||
+        alignment > MAX_COMPONENT_ALIGNMENT) {
+        LOG_ERROR_FMT("Scene component '{}' cannot be stored", name);
+        return INVALID_COMPONENT;
+    }
+    
+    SceneFileComponent component = {};
+    std::memcpy(component.name, name.c_str(), name.size());
+    component.size = size;
+    component.alignment = alignment;
+    m_components.push_back(component);
+    return static_cast<uint32_t>(m_components.size() - 1);
+}
+
+bool SceneWriter::addEntity(const std::vector<uint32_t>& components, const std::vector<const void*>& values) {
+    if (components.size() != values.size()) {
+        return false;
+    }
+    
+    std::vector<std::pair<uint32_t, const void*>> sorted;
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (components[i] >= m_components.size()) {
+            return false;
+        }
+        sorted.emplace_back(components[i], values[i]);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    
+    std::vector<uint32_t> key;
+    for (const auto& entry : sorted) {
+        if (!key.empty() && key.back() == entry.first) {
+            LOG_ERROR_FMT("Scene entity has component '{}' twice", m_components[entry.first].name);
+            return false;
+        }
+        key.push_back(entry.first);
+    }
+    
+    PendingArchetype* archetype = findOrCreateArchetype(key);
+    if (!archetype) {
+        return false;
+    }
+    
+    uint32_t index;
+    ArchetypeChunk& chunk = appendRow(*archetype, index);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const ChunkColumnLayout& column = archetype->layout[i];
+        std::memcpy(chunk.data + column.offset + index * column.size, sorted[i].second, column.size);
+    }
+    return true;
+}
+
+bool SceneWriter::addEntity(World& world, Entity entity) {
+    if (!world.isAlive(entity)) {
+        return false;
+    }
+    
+    ComponentRegistry& registry = ComponentRegistry::getInstance();
+    ComponentMask mask = world.getComponentMask(entity);
+    std::vector<uint32_t> components;
+    std::vector<const void*> values;
+    for (ComponentID id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+        if ((mask >> id) & 1) {
+            const ComponentInfo& info = registry.getInfo(id);
+            uint32_t index = addComponent(info.name, static_cast<uint32_t>(info.size),
+                                          static_cast<uint32_t>(info.alignment));
+            if (index == INVALID_COMPONENT) {
+                return false;
+            }
+            components.push_back(index);
+            values.push_back(world.readComponent(entity, id));
+        }
+    }
+    return addEntity(components, values);
+}
+
+void SceneWriter::addWorld(World& world) {
+    // Adding components in ID order keeps columns in the world's order, so
+    // the chunks can be copied whole and later adopted by a matching reader
+    ComponentRegistry& registry = ComponentRegistry::getInstance();
+    ComponentMask used = 0;
+    for (size_t i = 0; i < world.getArchetypeCount(); ++i) {
+        Archetype& archetype = world.getArchetype(i);
+        if (archetype.getEntityCount() > 0) {
+            used |= archetype.getMask();
+        }
+    }
+    
+    std::vector<uint32_t> fileIndices(MAX_COMPONENT_TYPES, INVALID_COMPONENT);
+    for (ComponentID id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+        if ((used >> id) & 1) {
+            const ComponentInfo& info = registry.getInfo(id);
+            fileIndices[id] = addComponent(info.name, static_cast<uint32_t>(info.size),
+                                           static_cast<uint32_t>(info.alignment));
+        }
+    }
+    
+    for (size_t i = 0; i < world.getArchetypeCount(); ++i) {
+        Archetype& source = world.getArchetype(i);
+        if (source.getEntityCount() == 0) {
+            continue;
+        }
+        
+        // Column c of the source goes to slot targetColumns[c] of the file archetype
+        std::vector<uint32_t> key;
+        for (ComponentID id : source.getComponents()) {
+            if (fileIndices[id] == INVALID_COMPONENT) {
+                LOG_ERROR_FMT("Skipping {} entities with an unserializable component", source.getEntityCount());
+                key.clear();
+                break;
+            }
+            key.push_back(fileIndices[id]);
+        }
+        if (key.size() != source.getComponents().size()) {
+            continue;
+        }
+        std::vector<uint32_t> sortedKey = key;
+        std::sort(sortedKey.begin(), sortedKey.end());
+        PendingArchetype* target = findOrCreateArchetype(sortedKey);
+        if (!target) {
+            continue;
+        }
+        
+        std::vector<size_t> targetColumns;
+        bool sameLayout = target->capacity == source.getChunkCapacity();
+        for (size_t column = 0; column < key.size(); ++column) {
+            size_t targetColumn = std::lower_bound(sortedKey.begin(), sortedKey.end(), key[column]) - sortedKey.begin();
+            targetColumns.push_back(targetColumn);
+            sameLayout = sameLayout && targetColumn == column &&
+                         target->layout[column].offset == source.getColumnOffset(static_cast<int>(column));
+        }
+        
+        for (size_t chunkIndex = 0; chunkIndex < source.getChunkCount(); ++chunkIndex) {
+            ArchetypeChunk& chunk = source.getChunk(chunkIndex);
+            bool appendWhole = target->chunks.empty() || target->chunks.back()->count == target->capacity;
+            if (sameLayout && appendWhole) {
+                target->chunks.emplace_back(new ArchetypeChunk());
+                std::memcpy(target->chunks.back()->data, chunk.data, ARCHETYPE_CHUNK_SIZE);
+                target->chunks.back()->count = chunk.count;
+                target->entityCount += chunk.count;
+                m_entityCount += chunk.count;
+                continue;
+            }
+            
+            for (uint32_t row = 0; row < chunk.count; ++row) {
+                uint32_t index;
+                ArchetypeChunk& destination = appendRow(*target, index);
+                for (size_t column = 0; column < key.size(); ++column) {
+                    const ChunkColumnLayout& layout = target->layout[targetColumns[column]];
+                    const void* value = static_cast<unsigned char*>(source.getColumnData(chunk, static_cast<int>(column))) +
+                                        row * layout.size;
+                    std::memcpy(destination.data + layout.offset + index * layout.size, value, layout.size);
+                }
+            }
+        }
+    }
+}
+
+bool SceneWriter::addText(const std::string& text, std::string& error) {
+    struct TextComponent {
+        uint32_t index;
+        std::vector<FieldType> fields;
+    };
+    std::map<std::string, TextComponent> declared;
+    
+    std::istringstream lines(text);
+    std::string line;
+    std::vector<std::string> tokens;
+    std::vector<unsigned char> values;
+    std::vector<uint32_t> components;
+    std::vector<size_t> valueOffsets;
+    std::vector<const void*> valuePointers;
+    
+    for (int lineNumber = 1; std::getline(lines, line); ++lineNumber) {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        
+        tokens.clear();
+        std::istringstream words(line);
+        for (std::string word; words >> word;) {
+            tokens.push_back(word);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+        
+        std::string location = "line " + std::to_string(lineNumber) + ": ";
+        if (tokens[0] == "component") {
+            if (tokens.size() < 3) {
+                error = location + "expected 'component <name> <field types>'";
+                return false;
+            }
+            TextComponent component;
+            for (size_t i = 2; i < tokens.size(); ++i) {
+                FieldType type;
+                if (!parseFieldType(tokens[i], type)) {
+                    error = location + "unknown field type '" + tokens[i] + "'";
+                    return false;
+                }
+                component.fields.push_back(type);
+            }
+            component.index = addComponent(tokens[1], static_cast<uint32_t>(component.fields.size() * 4), 4);
+            if (component.index == INVALID_COMPONENT) {
+                error = location + "cannot declare component '" + tokens[1] + "'";
+                return false;
+            }
+            declared[tokens[1]] = component;
+        } else if (tokens[0] == "entity") {
+            values.clear();
+            components.clear();
+            valueOffsets.clear();
+            for (size_t i = 1; i < tokens.size();) {
+                auto it = declared.find(tokens[i]);
+                if (it == declared.end()) {
+                    error = location + "undeclared component '" + tokens[i] + "'";
+                    return false;
+                }
+                const TextComponent& component = it->second;
+                if (tokens.size() - i - 1 < component.fields.size()) {
+                    error = location + "too few values for '" + tokens[i] + "'";
+                    return false;
+                }
+                
+                components.push_back(component.index);
+                valueOffsets.push_back(values.size());
+                values.resize(values.size() + component.fields.size() * 4);
+                for (size_t field = 0; field < component.fields.size(); ++field) {
+                    const std::string& token = tokens[i + 1 + field];
+                    unsigned char* destination = values.data() + valueOffsets.back() + field * 4;
+                    if (!parseField(token, component.fields[field], destination)) {
+                        error = location + "bad value '" + token + "'";
+                        return false;
+                    }
+                }
+                i += 1 + component.fields.size();
+            }
+            
+            valuePointers.clear();
+            for (size_t offset : valueOffsets) {
+                valuePointers.push_back(values.data() + offset);
+            }
+            if (!addEntity(components, valuePointers)) {
+                error = location + "invalid entity";
+                return false;
+            }
+        } else {
+            error = location + "unknown statement '" + tokens[0] + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SceneWriter::write(const std::string& filepath) const {
+    SceneFileHeader header = {};
+    std::memcpy(header.magic, SCENE_FILE_MAGIC, sizeof(header.magic));
+    header.version = SCENE_FILE_VERSION;
+    header.chunkSize = static_cast<uint32_t>(ARCHETYPE_CHUNK_SIZE);
+    header.chunkStride = static_cast<uint32_t>(sizeof(ArchetypeChunk));
+    header.componentCount = static_cast<uint32_t>(m_components.size());
+    header.archetypeCount = static_cast<uint32_t>(m_archetypes.size());
+    header.entityCount = m_entityCount;
+    
+    std::vector<SceneFileArchetype> archetypes;
+    std::vector<SceneFileColumn> columns;
+    for (const auto& pending : m_archetypes) {
+        SceneFileArchetype archetype = {};
+        archetype.firstColumn = static_cast<uint32_t>(columns.size());
+        archetype.columnCount = static_cast<uint32_t>(pending->components.size());
+        archetype.chunkCapacity = pending->capacity;
+        archetype.chunkCount = static_cast<uint32_t>(pending->chunks.size());
+        archetype.entityCount = pending->entityCount;
+        for (size_t i = 0; i < pending->components.size(); ++i) {
+            columns.push_back({ pending->components[i], pending->layout[i].offset });
+        }
+        archetypes.push_back(archetype);
+    }
+    header.columnCount = static_cast<uint32_t>(columns.size());
+    
+    size_t offset = sizeof(SceneFileHeader);
+    header.componentOffset = offset = alignUp(offset, SCENE_TABLE_ALIGNMENT);
+    offset += m_components.size() * sizeof(SceneFileComponent);
+    header.archetypeOffset = offset = alignUp(offset, SCENE_TABLE_ALIGNMENT);
+    offset += archetypes.size() * sizeof(SceneFileArchetype);
+    header.columnOffset = offset = alignUp(offset, SCENE_TABLE_ALIGNMENT);
+    offset += columns.size() * sizeof(SceneFileColumn);
+    for (auto& archetype : archetypes) {
+        archetype.chunkOffset = offset = alignUp(offset, SCENE_CHUNK_ALIGNMENT);
+        offset += static_cast<size_t>(archetype.chunkCount) * header.chunkStride;
+    }
+    header.fileSize = offset;
+    
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR_FMT("Failed to create scene file: {}", filepath);
+        return false;
+    }
+    
+    size_t written = 0;
+    auto writeAt = [&file, &written](size_t position, const void* data, size_t bytes) {
+        static const char zeros[SCENE_CHUNK_ALIGNMENT] = {};
+        while (written < position) {
+            size_t padding = std::min(position - written, sizeof(zeros));
+            file.write(zeros, padding);
+            written += padding;
+        }
+        file.write(static_cast<const char*>(data), bytes);
+        written += bytes;
+    };
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.componentOffset, m_components.data(), m_components.size() * sizeof(SceneFileComponent));
+    writeAt(header.archetypeOffset, archetypes.data(), archetypes.size() * sizeof(SceneFileArchetype));
+    writeAt(header.columnOffset, columns.data(), columns.size() * sizeof(SceneFileColumn));
+    
+    // Chunks go out through one scratch image so struct padding is always zero
+    std::unique_ptr<ArchetypeChunk> image(new ArchetypeChunk());
+    Entity* entities = reinterpret_cast<Entity*>(image->data);
+    uint32_t fileIndex = 0;
+    for (size_t i = 0; i < m_archetypes.size(); ++i) {
+        size_t position = archetypes[i].chunkOffset;
+        for (const auto& chunk : m_archetypes[i]->chunks) {
+            std::memcpy(image->data, chunk->data, ARCHETYPE_CHUNK_SIZE);
+            image->count = chunk->count;
+            for (uint32_t row = 0; row < chunk->count; ++row) {
+                entities[row] = Entity(fileIndex++, 0);
+            }
+            writeAt(position, image.get(), sizeof(ArchetypeChunk));
+            position += sizeof(ArchetypeChunk);
+        }
+    }
+    
+    if (!file.good()) {
+        LOG_ERROR_FMT("Failed to write scene file: {}", filepath);
+        return false;
+    }
+    LOG_INFO_FMT("Wrote scene {}: {} entities in {} archetypes", filepath, m_entityCount, m_archetypes.size());
+    return true;
+}
+
+SceneWriter::PendingArchetype* SceneWriter::findOrCreateArchetype(const std::vector<uint32_t>& components) {
+    auto it = m_archetypesByComponents.find(components);
+    if (it != m_archetypesByComponents.end()) {
+        return it->second;
+    }
+    
+    std::unique_ptr<PendingArchetype> archetype(new PendingArchetype());
+    archetype->components = components;
+    for (uint32_t index : components) {
+        archetype->layout.push_back({ m_components[index].size, m_components[index].alignment, 0 });
+    }
+    archetype->capacity = Archetype::computeChunkLayout(archetype->layout);
+    if (archetype->capacity == 0) {
+        LOG_ERROR("Scene component set does not fit a chunk");
+        return nullptr;
+    }
+    
+    PendingArchetype* result = archetype.get();
+    m_archetypes.push_back(std::move(archetype));
+    m_archetypesByComponents.emplace(components, result);
+    return result;
+}
+
+ArchetypeChunk& SceneWriter::appendRow(PendingArchetype& archetype, uint32_t& index) {
+    if (archetype.chunks.empty() || archetype.chunks.back()->count == archetype.capacity) {
+        archetype.chunks.emplace_back(new ArchetypeChunk());
+    }
+    ArchetypeChunk& chunk = *archetype.chunks.back();
+    index = chunk.count++;
+    archetype.entityCount++;
+    m_entityCount++;
+    return chunk;
+}
+
+SceneLoader::SceneLoader(World& world)
+    : m_world(world), m_mode(SceneLoadMode::ADOPT), m_archetypeCursor(0), m_chunkCursor(0), m_nextEntity(0),
+      m_target(nullptr), m_adoptable(false) {
+    std::memset(&m_header, 0, sizeof(m_header));
+}
+
+SceneLoader::~SceneLoader() {
+}
+
+bool SceneLoader::load(const std::string& filepath, SceneLoadMode mode) {
+    if (!open(filepath, mode)) {
+        return false;
+    }
+    mergeChunks(SIZE_MAX);
+    return true;
+}
+
+bool SceneLoader::open(const std::string& filepath, SceneLoadMode mode) {
+    m_file.reset();
+    m_entities.clear();
+    m_componentIDs.clear();
+    m_stats = SceneLoadStats{};
+    m_archetypeCursor = 0;
+    m_chunkCursor = 0;
+    m_nextEntity = 0;
+    m_target = nullptr;
+    
+    // Adopted chunks are written in place, which the private mapping absorbs
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(filepath, mode == SceneLoadMode::ADOPT ? MappedFile::Mode::COPY_ON_WRITE
+                                                           : MappedFile::Mode::READ_ONLY)) {
+        return false;
+    }
+    if (!validate(*file, m_componentIDs)) {
+        LOG_ERROR_FMT("Invalid scene file: {}", filepath);
+        return false;
+    }
+    
+    std::memcpy(&m_header, file->getData(), sizeof(m_header));
+    m_file = std::move(file);
+    m_filepath = filepath;
+    m_mode = mode;
+    m_entities.resize(static_cast<size_t>(m_header.entityCount));
+    m_stats.entities = m_header.entityCount;
+    m_stats.fileBytes = m_file->getSize();
+    return true;
+}
+
+void SceneLoader::prefetch() const {
+    if (m_file) {
+        m_file->prefetch();
+    }
+}
+
+bool SceneLoader::mergeChunks(size_t maxChunks) {
+    if (!m_file) {
+        return true;
+    }
+    
+    unsigned char* base = m_file->getData();
+    const SceneFileArchetype* archetypes = reinterpret_cast<const SceneFileArchetype*>(base + m_header.archetypeOffset);
+    const SceneFileColumn* columns = reinterpret_cast<const SceneFileColumn*>(base + m_header.columnOffset);
+    if (m_nextEntity == 0 && m_archetypeCursor == 0 && m_chunkCursor == 0) {
+        m_world.reserveEntities(m_world.getEntityCount() + m_entities.size());
+    }
+    
+    while (maxChunks > 0 && m_archetypeCursor < m_header.archetypeCount) {
+        const SceneFileArchetype& fileArchetype = archetypes[m_archetypeCursor];
+        const SceneFileColumn* fileColumns = columns + fileArchetype.firstColumn;
+        if (m_chunkCursor >= fileArchetype.chunkCount) {
+            m_archetypeCursor++;
+            m_chunkCursor = 0;
+            m_target = nullptr;
+            continue;
+        }
+        
+        if (!m_target) {
+            ComponentMask mask = 0;
+            for (uint32_t column = 0; column < fileArchetype.columnCount; ++column) {
+                mask |= ComponentMask(1) << m_componentIDs[fileColumns[column].component];
+            }
+            m_target = &m_world.findOrCreateArchetype(mask);
+            m_adoptable = m_mode == SceneLoadMode::ADOPT && m_header.chunkSize == ARCHETYPE_CHUNK_SIZE &&
+                          m_header.chunkStride == sizeof(ArchetypeChunk) &&
+                          fileArchetype.chunkOffset % alignof(ArchetypeChunk) == 0 &&
+                          layoutMatches(*m_target, fileArchetype, fileColumns, m_componentIDs);
+        }
+        
+        unsigned char* image = base + fileArchetype.chunkOffset + static_cast<size_t>(m_chunkCursor) * m_header.chunkStride;
+        uint32_t count = getChunkRowCount(fileArchetype, m_chunkCursor);
+        if (m_adoptable && m_target->canAppendChunk()) {
+            ArchetypeChunk* adopted = reinterpret_cast<ArchetypeChunk*>(image);
+            adopted->count = count;
+            m_world.adoptChunk(*m_target, adopted, false, &m_entities[m_nextEntity]);
+            m_stats.chunksAdopted++;
+        } else {
+            copyChunk(m_world, *m_target, image, count, fileColumns, fileArchetype.columnCount, m_componentIDs,
+                      &m_entities[m_nextEntity]);
+            m_stats.chunksCopied++;
+        }
+        m_nextEntity += count;
+        m_chunkCursor++;
+        maxChunks--;
+    }
+    
+    if (m_archetypeCursor < m_header.archetypeCount) {
+        return false;
+    }
+    
+    // Copied scenes don't need the mapping any more; adopted ones live on in the world
+    if (m_stats.chunksAdopted > 0) {
+        m_world.keepAlive(m_file);
+    }
+    m_file.reset();
+    LOG_INFO_FMT("Loaded scene {}: {} entities, {} chunks adopted, {} copied", m_filepath, m_stats.entities,
+                 m_stats.chunksAdopted, m_stats.chunksCopied);
+    return true;
+}
+
+bool SceneLoader::validate(const MappedFile& file, std::vector<ComponentID>& componentIDs) const {
+    const unsigned char* base = file.getData();
+    size_t fileSize = file.getSize();
+    
+    SceneFileHeader header;
+    if (fileSize < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, SCENE_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        LOG_ERROR("Not a scene file");
+        return false;
+    }
+    if (header.version != SCENE_FILE_VERSION) {
+        LOG_ERROR_FMT("Unsupported scene file version {} (expected {})", header.version, SCENE_FILE_VERSION);
+        return false;
+    }
+    if (header.fileSize != fileSize || header.chunkSize < sizeof(Entity) ||
+        header.chunkStride < static_cast<uint64_t>(header.chunkSize) + sizeof(uint32_t) ||
+        header.componentOffset % SCENE_TABLE_ALIGNMENT != 0 || header.archetypeOffset % SCENE_TABLE_ALIGNMENT != 0 ||
+        header.columnOffset % SCENE_TABLE_ALIGNMENT != 0 ||
+        !tableFits(header.componentOffset, header.componentCount, sizeof(SceneFileComponent), fileSize) ||
+        !tableFits(header.archetypeOffset, header.archetypeCount, sizeof(SceneFileArchetype), fileSize) ||
+        !tableFits(header.columnOffset, header.columnCount, sizeof(SceneFileColumn), fileSize)) {
+        LOG_ERROR("Scene file header is corrupt or truncated");
+        return false;
+    }
+    
+    ComponentRegistry& registry = ComponentRegistry::getInstance();
+    const SceneFileComponent* components = reinterpret_cast<const SceneFileComponent*>(base + header.componentOffset);
+    for (uint32_t i = 0; i < header.componentCount; ++i) {
+        const SceneFileComponent& component = components[i];
+        if (!std::memchr(component.name, '\0', sizeof(component.name))) {
+            LOG_ERROR("Scene component name is not terminated");
+            return false;
+        }
+        ComponentID id = registry.findByName(component.name);
+        if (id == INVALID_COMPONENT) {
+            LOG_ERROR_FMT("Scene component '{}' is not registered", component.name);
+            return false;
+        }
+        if (registry.getInfo(id).size != component.size) {
+            LOG_ERROR_FMT("Scene component '{}' is {} bytes, registered type is {}", component.name, component.size,
+                          registry.getInfo(id).size);
+            return false;
+        }
+        componentIDs.push_back(id);
+    }
+    
+    const SceneFileArchetype* archetypes = reinterpret_cast<const SceneFileArchetype*>(base + header.archetypeOffset);
+    const SceneFileColumn* columns = reinterpret_cast<const SceneFileColumn*>(base + header.columnOffset);
+    uint64_t entityTotal = 0;
+    for (uint32_t i = 0; i < header.archetypeCount; ++i) {
+        const SceneFileArchetype& archetype = archetypes[i];
+        uint64_t capacity = archetype.chunkCapacity;
+        if (static_cast<uint64_t>(archetype.firstColumn) + archetype.columnCount > header.columnCount ||
+            capacity == 0 || capacity * sizeof(Entity) > header.chunkSize ||
+            !tableFits(archetype.chunkOffset, archetype.chunkCount, header.chunkStride, fileSize) ||
+            archetype.chunkCount != (archetype.entityCount + capacity - 1) / capacity) {
+            LOG_ERROR_FMT("Scene archetype {} is corrupt", i);
+            return false;
+        }
+        
+        ComponentMask mask = 0;
+        for (uint32_t c = 0; c < archetype.columnCount; ++c) {
+            const SceneFileColumn& column = columns[archetype.firstColumn + c];
+            if (column.component >= header.componentCount ||
+                column.offset + capacity * components[column.component].size > header.chunkSize ||
+                (mask >> componentIDs[column.component]) & 1) {
+                LOG_ERROR_FMT("Scene archetype {} has a corrupt column", i);
+                return false;
+            }
+            mask |= ComponentMask(1) << componentIDs[column.component];
+        }
+        
+        entityTotal += archetype.entityCount;
+    }
+    
+    if (entityTotal != header.entityCount) {
+        LOG_ERROR("Scene entity count does not match its archetypes");
+        return false;
+    }
+    return true;
+}
+
+} // namespace GameEngine2D
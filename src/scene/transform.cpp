@@ -0,0 +1,273 @@
+#include "scene/transform.h"
+#include "core/job_system.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace GameEngine2D {
+
+namespace {
+
+constexpr int32_t UNKNOWN_DEPTH = -1;
+constexpr int32_t DEAD_DEPTH = -2;
+
+// Nodes per job when a depth level is split across workers
+constexpr size_t PARALLEL_GRAIN = 4096;
+
+} // namespace
+
+TransformHierarchy::TransformHierarchy() : m_firstDirtySlot(INVALID_SLOT), m_structureDirty(false) {
+}
+
+TransformID TransformHierarchy::create(TransformID parent) {
+    if (parent != INVALID_TRANSFORM && !isAlive(parent)) {
+        LOG_WARNING("TransformHierarchy::create with a dead parent, creating a root");
+        parent = INVALID_TRANSFORM;
+    }
+    
+    TransformID id;
+    if (!m_freeIDs.empty()) {
+        id = m_freeIDs.back();
+        m_freeIDs.pop_back();
+    } else {
+        id = static_cast<TransformID>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+    
+    // Appended out of order; the re-sort on the next update files it by depth
+    uint32_t slot = static_cast<uint32_t>(m_slotIDs.size());
+    m_nodes[id] = { parent, slot, NodeState::ALIVE };
+    m_slotIDs.push_back(id);
+    m_slotParents.push_back(INVALID_SLOT);
+    m_local.emplace_back();
+    m_world.emplace_back();
+    m_dirty.push_back(0);
+    markDirty(slot);
+    m_structureDirty = true;
+    return id;
+}
+
+void TransformHierarchy::destroy(TransformID id) {
+    if (!isAlive(id)) {
+        return;
+    }
+    m_nodes[id].state = NodeState::DESTROYED;
+    m_structureDirty = true;
+}
+
+bool TransformHierarchy::isAlive(TransformID id) const {
+    return id < m_nodes.size() && m_nodes[id].state == NodeState::ALIVE;
+}
+
+void TransformHierarchy::clear() {
+    m_nodes.clear();
+    m_freeIDs.clear();
+    m_slotIDs.clear();
+    m_slotParents.clear();
+    m_local.clear();
+    m_world.clear();
+    m_dirty.clear();
+    m_levelStarts.clear();
+    m_firstDirtySlot = INVALID_SLOT;
+    m_structureDirty = false;
+    m_stats = TransformStats{};
+}
+
+bool TransformHierarchy::setParent(TransformID id, TransformID parent) {
+    if (!isAlive(id) || (parent != INVALID_TRANSFORM && !isAlive(parent))) {
+        return false;
+    }
+    if (m_nodes[id].parent == parent) {
+        return true;
+    }
+    
+    for (TransformID ancestor = parent; ancestor != INVALID_TRANSFORM; ancestor = m_nodes[ancestor].parent) {
+        if (ancestor == id) {
+            LOG_WARNING("TransformHierarchy::setParent would create a cycle");
+            return false;
+        }
+    }
+    
+    m_nodes[id].parent = parent;
+    markDirty(m_nodes[id].slot);
+    m_structureDirty = true;
+    return true;
+}
+
+TransformID TransformHierarchy::getParent(TransformID id) const {
+    return isAlive(id) ? m_nodes[id].parent : INVALID_TRANSFORM;
+}
+
+void TransformHierarchy::setLocal(TransformID id, const Affine2& local) {
+    uint32_t slot = m_nodes[id].slot;
+    m_local[slot] = local;
+    markDirty(slot);
+}
+
+void TransformHierarchy::markDirty(uint32_t slot) {
+    m_dirty[slot] = 1;
+    m_firstDirtySlot = std::min(m_firstDirtySlot, slot);
+}
+
+void TransformHierarchy::update() {
+    if (!prepareUpdate()) {
+        return;
+    }
+    finishUpdate(updateRange(m_firstDirtySlot, static_cast<uint32_t>(m_slotIDs.size())));
+}
+
+void TransformHierarchy::updateParallel() {
+    if (!prepareUpdate()) {
+        return;
+    }
+    
+    // Levels only read the level above, so each one is a parallel loop
+    JobSystem& jobs = JobSystem::getInstance();
+    std::atomic<uint32_t> updated(0);
+    for (size_t level = 0; level + 1 < m_levelStarts.size(); ++level) {
+        uint32_t begin = std::max(m_levelStarts[level], m_firstDirtySlot);
+        uint32_t end = m_levelStarts[level + 1];
+        if (begin >= end) {
+            continue;
+        }
+        jobs.parallelFor(end - begin, PARALLEL_GRAIN, [this, begin, &updated](size_t first, size_t last) {
+            uint32_t count = updateRange(begin + static_cast<uint32_t>(first), begin + static_cast<uint32_t>(last));
+            updated.fetch_add(count, std::memory_order_relaxed);
+        });
+    }
+    finishUpdate(updated.load());
+}
+
+bool TransformHierarchy::prepareUpdate() {
+    m_stats.updated = 0;
+    m_stats.rebuilt = false;
+    if (m_structureDirty) {
+        rebuild();
+        m_stats.rebuilt = true;
+    }
+    return m_firstDirtySlot != INVALID_SLOT;
+}
+
+void TransformHierarchy::finishUpdate(uint32_t updated) {
+    // Flags stay set during the pass so children see their parent changed
+    std::memset(m_dirty.data() + m_firstDirtySlot, 0, m_dirty.size() - m_firstDirtySlot);
+    m_firstDirtySlot = INVALID_SLOT;
+    m_stats.updated = updated;
+}
+
+uint32_t TransformHierarchy::updateRange(uint32_t begin, uint32_t end) {
+    const uint32_t* parents = m_slotParents.data();
+    const Affine2* local = m_local.data();
+    Affine2* world = m_world.data();
+    uint8_t* dirty = m_dirty.data();
+    
+    uint32_t updated = 0;
+    for (uint32_t slot = begin; slot < end; ++slot) {
+        uint32_t parent = parents[slot];
+        if (parent == INVALID_SLOT) {
+            if (dirty[slot]) {
+                world[slot] = local[slot];
+                updated++;
+            }
+        } else if (dirty[slot] | dirty[parent]) {
+            world[slot] = world[parent] * local[slot];
+            dirty[slot] = 1;
+            updated++;
+        }
+    }
+    return updated;
+}
+
+void TransformHierarchy::rebuild() {
+    m_structureDirty = false;
+    
+    // Depth of every node; anything under a destroyed node is dead as well
+    size_t nodeCount = m_nodes.size();
+    std::vector<int32_t> depths(nodeCount, UNKNOWN_DEPTH);
+    std::vector<TransformID> path;
+    for (TransformID id = 0; id < nodeCount; ++id) {
+        path.clear();
+        TransformID current = id;
+        int32_t depth = -1;
+        while (current != INVALID_TRANSFORM) {
+            if (depths[current] != UNKNOWN_DEPTH) {
+                depth = depths[current];
+                break;
+            }
+            if (m_nodes[current].state != NodeState::ALIVE) {
+                depths[current] = DEAD_DEPTH;
+                depth = DEAD_DEPTH;
+                break;
+            }
+            path.push_back(current);
+            current = m_nodes[current].parent;
+        }
+        for (size_t i = path.size(); i-- > 0;) {
+            depth = depth == DEAD_DEPTH ? DEAD_DEPTH : depth + 1;
+            depths[path[i]] = depth;
+        }
+    }
+    
+    for (TransformID id = 0; id < nodeCount; ++id) {
+        if (depths[id] == DEAD_DEPTH && m_nodes[id].state != NodeState::FREE) {
+            m_nodes[id] = Node{};
+            m_freeIDs.push_back(id);
+        }
+    }
+    
+    // Counting sort by depth, keeping the previous relative order
+    int32_t maxDepth = -1;
+    for (TransformID id : m_slotIDs) {
+        maxDepth = std::max(maxDepth, depths[id]);
+    }
+    std::vector<uint32_t> cursors(static_cast<size_t>(maxDepth + 2), 0);
+    for (TransformID id : m_slotIDs) {
+        if (depths[id] >= 0) {
+            cursors[depths[id] + 1]++;
+        }
+    }
+    for (size_t level = 1; level < cursors.size(); ++level) {
+        cursors[level] += cursors[level - 1];
+    }
+    m_levelStarts = cursors;
+    
+    size_t aliveCount = cursors.back();
+    std::vector<TransformID> slotIDs(aliveCount);
+    std::vector<Affine2> local(aliveCount);
+    std::vector<Affine2> world(aliveCount);
+    std::vector<uint8_t> dirty(aliveCount);
+    for (uint32_t oldSlot = 0; oldSlot < m_slotIDs.size(); ++oldSlot) {
+        TransformID id = m_slotIDs[oldSlot];
+        if (depths[id] < 0) {
+            continue;
+        }
+        uint32_t slot = cursors[depths[id]]++;
+        slotIDs[slot] = id;
+        local[slot] = m_local[oldSlot];
+        world[slot] = m_world[oldSlot];
+        dirty[slot] = m_dirty[oldSlot];
+        m_nodes[id].slot = slot;
+    }
+    
+    std::vector<uint32_t> slotParents(aliveCount);
+    m_firstDirtySlot = INVALID_SLOT;
+    for (uint32_t slot = 0; slot < aliveCount; ++slot) {
+        TransformID parent = m_nodes[slotIDs[slot]].parent;
+        slotParents[slot] = parent == INVALID_TRANSFORM ? INVALID_SLOT : m_nodes[parent].slot;
+        if (dirty[slot] && m_firstDirtySlot == INVALID_SLOT) {
+            m_firstDirtySlot = slot;
+        }
+    }
+    
+    m_slotIDs.swap(slotIDs);
+    m_slotParents.swap(slotParents);
+    m_local.swap(local);
+    m_world.swap(world);
+    m_dirty.swap(dirty);
+    
+    m_stats.nodes = static_cast<uint32_t>(aliveCount);
+    m_stats.levels = static_cast<uint32_t>(m_levelStarts.size() - 1);
+}
+
+} // namespace GameEngine2D
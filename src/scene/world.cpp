@@ -0,0 +1,442 @@
+#include "scene/world.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+namespace GameEngine2D {
+
+World::World()
+    : m_reservedCount(0), m_entityCount(0), m_changeVersion(1), m_trackedEvents(0), m_firstEventSequence(0),
+      m_retireSequence(0), m_activeAccess(0) {
+    for (size_t i = 0; i < MAX_COMPONENT_TYPES; ++i) {
+        m_readers[i] = 0;
+        m_writers[i] = 0;
+    }
+    findOrCreateArchetype(0);
+}
+
+World::~World() {
+}
+
+Entity World::createEntity() {
+    return allocateEntity(findOrCreateArchetype(0));
+}
+
+Entity World::allocateEntity(Archetype& archetype) {
+    checkStructuralChange("createEntity");
+    
+    uint32_t index = allocateIndex();
+    EntityRecord& record = m_records[index];
+    Entity entity(index, record.generation);
+    record.archetype = &archetype;
+    record.row = archetype.allocateRow(entity);
+    markAppendChanged(archetype);
+    recordEvents(entity, archetype.getMask(), ComponentEventType::ADDED);
+    m_entityCount++;
+    return entity;
+}
+
+uint32_t World::allocateIndex() {
+    flushReservations();
+    if (!m_freeIndices.empty()) {
+        uint32_t index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+        return index;
+    }
+    m_records.emplace_back();
+    return static_cast<uint32_t>(m_records.size() - 1);
+}
+
+void World::flushReservations() {
+    uint32_t reserved = m_reservedCount.load(std::memory_order_relaxed);
+    if (reserved == 0) {
+        return;
+    }
+    
+    // Reserved slots leave the free list; reservations past it become new
+    // records. Either way they stay dead until created or released.
+    size_t fromFree = std::min<size_t>(reserved, m_freeIndices.size());
+    m_freeIndices.resize(m_freeIndices.size() - fromFree);
+    m_records.resize(m_records.size() + (reserved - fromFree));
+    m_reservedCount.store(0, std::memory_order_relaxed);
+}
+
+Entity World::reserveEntity() {
+    // Mirrors the order allocateIndex would use, without touching either
+    // table; flushReservations applies the result before the next change
+    uint32_t reserved = m_reservedCount.fetch_add(1, std::memory_order_relaxed);
+    if (reserved < m_freeIndices.size()) {
+        uint32_t index = m_freeIndices[m_freeIndices.size() - 1 - reserved];
+        return Entity(index, m_records[index].generation);
+    }
+    return Entity(static_cast<uint32_t>(m_records.size() + (reserved - m_freeIndices.size())), 0);
+}
+
+bool World::createReservedEntity(Entity reserved, Archetype& archetype) {
+    checkStructuralChange("createReservedEntity");
+    flushReservations();
+    if (reserved.index >= m_records.size()) {
+        return false;
+    }
+    EntityRecord& record = m_records[reserved.index];
+    if (record.archetype || record.generation != reserved.generation) {
+        return false;
+    }
+    
+    record.archetype = &archetype;
+    record.row = archetype.allocateRow(reserved);
+    markAppendChanged(archetype);
+    recordEvents(reserved, archetype.getMask(), ComponentEventType::ADDED);
+    m_entityCount++;
+    return true;
+}
+
+bool World::releaseReservedEntity(Entity reserved) {
+    checkStructuralChange("releaseReservedEntity");
+    flushReservations();
+    if (reserved.index >= m_records.size()) {
+        return false;
+    }
+    EntityRecord& record = m_records[reserved.index];
+    if (record.archetype || record.generation != reserved.generation) {
+        return false;
+    }
+    record.generation++;
+    m_freeIndices.push_back(reserved.index);
+    return true;
+}
+
+void World::reserveEntities(size_t count) {
+    flushReservations();
+    size_t needed = m_records.size() + (count > m_entityCount + m_freeIndices.size()
+                                            ? count - m_entityCount - m_freeIndices.size() : 0);
+    
+    // Grows geometrically so repeated bulk loads stay amortized
+    if (needed > m_records.capacity()) {
+        m_records.reserve(std::max(needed, m_records.capacity() * 2));
+    }
+}
+
+uint32_t World::createEntities(Archetype& archetype, uint32_t count, Entity* entities) {
+    checkStructuralChange("createEntities");
+    uint32_t firstRow = archetype.allocateRows(count);
+    
+    // Fill the entity column chunk by chunk rather than row by row
+    uint32_t capacity = archetype.getChunkCapacity();
+    bool tracked = (archetype.getMask() & m_trackedEvents) != 0;
+    uint32_t row = firstRow;
+    for (uint32_t done = 0; done < count;) {
+        Entity* column = archetype.getEntities(archetype.getChunk(row / capacity));
+        uint32_t first = row % capacity;
+        uint32_t rows = std::min(count - done, capacity - first);
+        archetype.markChunkChanged(row / capacity, m_changeVersion);
+        for (uint32_t i = 0; i < rows; ++i) {
+            uint32_t index = allocateIndex();
+            EntityRecord& record = m_records[index];
+            column[first + i] = Entity(index, record.generation);
+            record.archetype = &archetype;
+            record.row = row + i;
+            if (entities) {
+                entities[done + i] = column[first + i];
+            }
+            if (tracked) {
+                recordEvents(column[first + i], archetype.getMask(), ComponentEventType::ADDED);
+            }
+        }
+        row += rows;
+        done += rows;
+    }
+    m_entityCount += count;
+    return firstRow;
+}
+
+bool World::adoptChunk(Archetype& archetype, ArchetypeChunk* chunk, bool owned, Entity* entities) {
+    checkStructuralChange("adoptChunk");
+    if (!archetype.canAppendChunk() || chunk->count == 0 || chunk->count > archetype.getChunkCapacity()) {
+        return false;
+    }
+    
+    uint32_t firstRow = archetype.appendChunk(chunk, owned);
+    markAppendChanged(archetype);
+    Entity* column = archetype.getEntities(*chunk);
+    for (uint32_t i = 0; i < chunk->count; ++i) {
+        uint32_t index = allocateIndex();
+        EntityRecord& record = m_records[index];
+        column[i] = Entity(index, record.generation);
+        if (entities) {
+            entities[i] = column[i];
+        }
+        record.archetype = &archetype;
+        record.row = firstRow + i;
+        recordEvents(column[i], archetype.getMask(), ComponentEventType::ADDED);
+    }
+    m_entityCount += chunk->count;
+    return true;
+}
+
+bool World::destroyEntity(Entity entity) {
+    checkStructuralChange("destroyEntity");
+    flushReservations();
+    EntityRecord* record = findRecord(entity);
+    if (!record) {
+        return false;
+    }
+    
+    recordEvents(entity, record->archetype->getMask(), ComponentEventType::REMOVED);
+    removeRow(*record);
+    record->archetype = nullptr;
+    record->generation++;
+    m_freeIndices.push_back(entity.index);
+    m_entityCount--;
+    return true;
+}
+
+bool World::isAlive(Entity entity) const {
+    return findRecord(entity) != nullptr;
+}
+
+void World::clear() {
+    checkStructuralChange("clear");
+    for (auto& archetype : m_archetypes) {
+        archetype->clear();
+    }
+    
+    // Bump generations so handles from before the clear stay dead, unused
+    // reservations included
+    flushReservations();
+    m_freeIndices.clear();
+    for (uint32_t index = static_cast<uint32_t>(m_records.size()); index-- > 0;) {
+        EntityRecord& record = m_records[index];
+        record.archetype = nullptr;
+        record.generation++;
+        m_freeIndices.push_back(index);
+    }
+    m_entityCount = 0;
+    m_keepAlive.clear();
+    
+    // Pending events refer to entities that are gone; cursors stay valid
+    m_firstEventSequence += m_events.size();
+    m_retireSequence = m_firstEventSequence;
+    m_events.clear();
+}
+
+void World::retireComponentEvents() {
+    size_t retired = static_cast<size_t>(m_retireSequence - m_firstEventSequence);
+    m_events.erase(m_events.begin(), m_events.begin() + retired);
+    m_firstEventSequence = m_retireSequence;
+    m_retireSequence = m_firstEventSequence + m_events.size();
+}
+
+void* World::addComponent(Entity entity, ComponentID id, const void* value) {
+    checkStructuralChange("addComponent");
+    EntityRecord* record = findRecord(entity);
+    if (!record) {
+        LOG_WARNING("addComponent called on a dead entity");
+        return nullptr;
+    }
+    
+    Archetype* source = record->archetype;
+    if (source->hasComponent(id)) {
+        writeComponent(*source, record->row, id, value);
+        return source->getComponentData(record->row, source->getColumn(id));
+    }
+    
+    Archetype* target = source->getAddEdge(id);
+    if (!target) {
+        target = &findOrCreateArchetype(source->getMask() | (ComponentMask(1) << id));
+        source->setAddEdge(id, target);
+    }
+    
+    moveEntity(entity, *record, *target);
+    writeComponent(*target, record->row, id, value);
+    recordEvents(entity, ComponentMask(1) << id, ComponentEventType::ADDED);
+    return target->getComponentData(record->row, target->getColumn(id));
+}
+
+bool World::removeComponent(Entity entity, ComponentID id) {
+    checkStructuralChange("removeComponent");
+    EntityRecord* record = findRecord(entity);
+    if (!record || !record->archetype->hasComponent(id)) {
+        return false;
+    }
+    
+    Archetype* source = record->archetype;
+    Archetype* target = source->getRemoveEdge(id);
+    if (!target) {
+        target = &findOrCreateArchetype(source->getMask() & ~(ComponentMask(1) << id));
+        source->setRemoveEdge(id, target);
+    }
+    
+    moveEntity(entity, *record, *target);
+    recordEvents(entity, ComponentMask(1) << id, ComponentEventType::REMOVED);
+    return true;
+}
+
+void* World::getComponent(Entity entity, ComponentID id) {
+#if ECS_ACCESS_CHECKS
+    if (m_activeAccess.load(std::memory_order_relaxed) > 0) {
+        LOG_ERROR_FMT("getComponent on '{}' during a parallel query; use readComponent",
+                      ComponentRegistry::getInstance().getInfo(id).name);
+        assert(!"ECS data race");
+    }
+#endif
+    EntityRecord* record = findRecord(entity);
+    if (!record) {
+        return nullptr;
+    }
+    
+    // The caller may write through the pointer, so it counts as a change
+    Archetype& archetype = *record->archetype;
+    int column = archetype.getColumn(id);
+    if (column < 0) {
+        return nullptr;
+    }
+    archetype.markChanged(record->row / archetype.getChunkCapacity(), column, m_changeVersion);
+    return archetype.getComponentData(record->row, column);
+}
+
+const void* World::readComponent(Entity entity, ComponentID id) const {
+#if ECS_ACCESS_CHECKS
+    if (m_writers[id].load(std::memory_order_relaxed) > 0) {
+        LOG_ERROR_FMT("readComponent on '{}' while a parallel query writes it",
+                      ComponentRegistry::getInstance().getInfo(id).name);
+        assert(!"ECS data race");
+    }
+#endif
+    const EntityRecord* record = findRecord(entity);
+    if (!record) {
+        return nullptr;
+    }
+    
+    int column = record->archetype->getColumn(id);
+    return column < 0 ? nullptr : record->archetype->getComponentData(record->row, column);
+}
+
+ComponentMask World::getComponentMask(Entity entity) const {
+    const EntityRecord* record = findRecord(entity);
+    return record ? record->archetype->getMask() : 0;
+}
+
+void World::beginAccess(ComponentMask reads, ComponentMask writes) {
+#if ECS_ACCESS_CHECKS
+    m_activeAccess.fetch_add(1);
+    for (ComponentID id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+        ComponentMask bit = ComponentMask(1) << id;
+        bool conflict = false;
+        if (writes & bit) {
+            conflict = m_writers[id].fetch_add(1) > 0 || m_readers[id].load() > 0;
+        } else if (reads & bit) {
+            m_readers[id].fetch_add(1);
+            conflict = m_writers[id].load() > 0;
+        }
+        if (conflict) {
+            LOG_ERROR_FMT("Conflicting parallel access to component '{}'",
+                          ComponentRegistry::getInstance().getInfo(id).name);
+            assert(!"ECS data race");
+        }
+    }
+#else
+    (void)reads;
+    (void)writes;
+#endif
+}
+
+void World::endAccess(ComponentMask reads, ComponentMask writes) {
+#if ECS_ACCESS_CHECKS
+    for (ComponentID id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+        ComponentMask bit = ComponentMask(1) << id;
+        if (writes & bit) {
+            m_writers[id].fetch_sub(1);
+        } else if (reads & bit) {
+            m_readers[id].fetch_sub(1);
+        }
+    }
+    m_activeAccess.fetch_sub(1);
+#else
+    (void)reads;
+    (void)writes;
+#endif
+}
+
+void World::checkStructuralChange(const char* operation) const {
+#if ECS_ACCESS_CHECKS
+    if (m_activeAccess.load(std::memory_order_relaxed) > 0) {
+        LOG_ERROR_FMT("{} called while a parallel query is running", operation);
+        assert(!"ECS structural change during parallel query");
+    }
+#else
+    (void)operation;
+#endif
+}
+
+Archetype& World::findOrCreateArchetype(ComponentMask mask) {
+    auto it = m_archetypesByMask.find(mask);
+    if (it != m_archetypesByMask.end()) {
+        return *it->second;
+    }
+    
+    m_archetypes.push_back(std::make_unique<Archetype>(mask));
+    Archetype* archetype = m_archetypes.back().get();
+    m_archetypesByMask.emplace(mask, archetype);
+    return *archetype;
+}
+
+World::EntityRecord* World::findRecord(Entity entity) {
+    if (entity.index >= m_records.size()) {
+        return nullptr;
+    }
+    EntityRecord& record = m_records[entity.index];
+    return record.archetype && record.generation == entity.generation ? &record : nullptr;
+}
+
+const World::EntityRecord* World::findRecord(Entity entity) const {
+    return const_cast<World*>(this)->findRecord(entity);
+}
+
+void World::removeRow(EntityRecord& record) {
+    Entity moved = record.archetype->removeRow(record.row);
+    if (!moved.isNull()) {
+        m_records[moved.index].row = record.row;
+        markRowChanged(*record.archetype, record.row);
+    }
+}
+
+void World::moveEntity(Entity entity, EntityRecord& record, Archetype& target) {
+    Archetype& source = *record.archetype;
+    uint32_t row = target.allocateRow(entity);
+    markAppendChanged(target);
+    
+    // Shared components are copied; ones new to the entity start zeroed
+    for (size_t column = 0; column < target.getColumnCount(); ++column) {
+        int targetColumn = static_cast<int>(column);
+        void* destination = target.getComponentData(row, targetColumn);
+        int sourceColumn = source.getColumn(target.getColumnComponent(targetColumn));
+        size_t size = target.getColumnElementSize(targetColumn);
+        if (sourceColumn >= 0) {
+            std::memcpy(destination, source.getComponentData(record.row, sourceColumn), size);
+        } else {
+            std::memset(destination, 0, size);
+        }
+    }
+    
+    removeRow(record);
+    record.archetype = &target;
+    record.row = row;
+}
+
+void World::writeComponent(Archetype& archetype, uint32_t row, ComponentID id, const void* value) {
+    int column = archetype.getColumn(id);
+    std::memcpy(archetype.getComponentData(row, column), value, archetype.getColumnElementSize(column));
+    archetype.markChanged(row / archetype.getChunkCapacity(), column, m_changeVersion);
+}
+
+void World::appendEvents(Entity entity, ComponentMask mask, ComponentEventType type) {
+    for (ComponentID id = 0; mask != 0; ++id, mask >>= 1) {
+        if (mask & 1) {
+            m_events.push_back({ entity, id, type });
+        }
+    }
+}
+
+} // namespace GameEngine2D
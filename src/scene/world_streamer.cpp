@@ -0,0 +1,329 @@
+#include "scene/world_streamer.h"
+#include "utils/file_utils.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace GameEngine2D {
+
+namespace {
+
+// Work between budget checks
+constexpr size_t MERGE_CHUNKS_PER_STEP = 1;
+constexpr size_t UNLOAD_ENTITIES_PER_STEP = 256;
+
+using Clock = std::chrono::high_resolution_clock;
+
+int toCell(float coordinate, float cellSize) {
+    return static_cast<int>(std::floor(coordinate / cellSize));
+}
+
+} // namespace
+
+WorldStreamer::WorldStreamer() : m_world(nullptr), m_activeLoads(0) {
+}
+
+WorldStreamer::~WorldStreamer() {
+    shutdown();
+}
+
+void WorldStreamer::initialize(World& world, const StreamingSettings& settings) {
+    shutdown();
+    
+    m_world = &world;
+    m_settings = settings;
+    if (m_settings.cellSize <= 0.0f) {
+        LOG_WARNING("Streaming cell size must be positive, using the default");
+        m_settings.cellSize = StreamingSettings().cellSize;
+    }
+    if (m_settings.unloadRadius < m_settings.loadRadius) {
+        LOG_WARNING("Streaming unload radius is below the load radius, using the load radius");
+        m_settings.unloadRadius = m_settings.loadRadius;
+    }
+    m_settings.maxConcurrentLoads = std::max(m_settings.maxConcurrentLoads, 1u);
+    LOG_INFO_FMT("World streaming from {} in cells of {} units", m_settings.directory, m_settings.cellSize);
+}
+
+void WorldStreamer::shutdown() {
+    if (!m_world) {
+        return;
+    }
+    
+    JobSystem::getInstance().wait(m_jobs);
+    for (auto& entry : m_cells) {
+        Cell& cell = *entry.second;
+        CellState state = cell.state.load(std::memory_order_acquire);
+        if (state == CellState::MERGING) {
+            cell.entities = cell.loader->getEntities();
+        }
+        if (state == CellState::MERGING || state == CellState::RESIDENT || state == CellState::UNLOADING) {
+            unloadSome(cell, SIZE_MAX);
+        }
+    }
+    
+    m_cells.clear();
+    m_activeLoads = 0;
+    m_stats = StreamingStats{};
+    m_world = nullptr;
+}
+
+void WorldStreamer::update(const Vector2& focus) {
+    if (!m_world) {
+        return;
+    }
+    
+    auto start = Clock::now();
+    m_stats.entitiesMerged = 0;
+    m_stats.entitiesUnloaded = 0;
+    
+    releaseCells(focus);
+    requestCells(focus);
+    double setupMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    runTimeSlice(focus, m_settings.mergeBudgetMs - setupMs);
+    
+    m_stats.residentCells = 0;
+    m_stats.loadingCells = 0;
+    m_stats.pendingCells = 0;
+    m_stats.emptyCells = 0;
+    m_stats.failedCells = 0;
+    for (const auto& entry : m_cells) {
+        switch (entry.second->state.load(std::memory_order_acquire)) {
+            case CellState::LOADING:
+                m_stats.loadingCells++;
+                break;
+            case CellState::RESIDENT:
+                m_stats.residentCells++;
+                break;
+            case CellState::READY:
+            case CellState::MERGING:
+            case CellState::UNLOADING:
+                m_stats.pendingCells++;
+                break;
+            case CellState::EMPTY:
+                m_stats.emptyCells++;
+                break;
+            case CellState::FAILED:
+                m_stats.failedCells++;
+                break;
+        }
+    }
+    m_stats.sliceMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+bool WorldStreamer::isCellResident(int x, int y) const {
+    auto it = m_cells.find(getCellKey(x, y));
+    return it != m_cells.end() && it->second->state.load(std::memory_order_acquire) == CellState::RESIDENT;
+}
+
+std::string WorldStreamer::getCellPath(const std::string& directory, int x, int y) {
+    return FileUtils::combinePath(directory, "cell_" + std::to_string(x) + "_" + std::to_string(y) + ".scene");
+}
+
+size_t WorldStreamer::writeCells(World& world, const std::string& directory, float cellSize,
+                                 const std::function<Vector2(Entity)>& getPosition) {
+    if (cellSize <= 0.0f) {
+        LOG_ERROR("Streaming cell size must be positive");
+        return 0;
+    }
+    if (!FileUtils::directoryExists(directory)) {
+        FileUtils::createDirectory(directory);
+    }
+    
+    struct CellWriter {
+        int x;
+        int y;
+        SceneWriter writer;
+    };
+    std::unordered_map<uint64_t, std::unique_ptr<CellWriter>> writers;
+    for (size_t i = 0; i < world.getArchetypeCount(); ++i) {
+        Archetype& archetype = world.getArchetype(i);
+        for (uint32_t row = 0; row < archetype.getEntityCount(); ++row) {
+            Entity entity = archetype.getEntity(row);
+            Vector2 position = getPosition(entity);
+            int x = toCell(position.x, cellSize);
+            int y = toCell(position.y, cellSize);
+            std::unique_ptr<CellWriter>& cell = writers[getCellKey(x, y)];
+            if (!cell) {
+                cell.reset(new CellWriter{ x, y, SceneWriter() });
+            }
+            cell->writer.addEntity(world, entity);
+        }
+    }
+    
+    size_t written = 0;
+    for (const auto& entry : writers) {
+        const CellWriter& cell = *entry.second;
+        if (cell.writer.write(getCellPath(directory, cell.x, cell.y))) {
+            written++;
+        }
+    }
+    LOG_INFO_FMT("Wrote {} streaming cells to {}", written, directory);
+    return written;
+}
+
+uint64_t WorldStreamer::getCellKey(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+float WorldStreamer::getCellDistance(int x, int y, const Vector2& focus) const {
+    float size = m_settings.cellSize;
+    float dx = std::max({ x * size - focus.x, 0.0f, focus.x - (x + 1) * size });
+    float dy = std::max({ y * size - focus.y, 0.0f, focus.y - (y + 1) * size });
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void WorldStreamer::releaseCells(const Vector2& focus) {
+    for (auto it = m_cells.begin(); it != m_cells.end();) {
+        Cell& cell = *it->second;
+        CellState state = cell.state.load(std::memory_order_acquire);
+        if (cell.reading && state != CellState::LOADING) {
+            cell.reading = false;
+            m_activeLoads--;
+            if (state == CellState::FAILED) {
+                LOG_ERROR_FMT("Failed to stream cell: {}", getCellPath(m_settings.directory, cell.x, cell.y));
+            }
+        }
+        
+        // Reads in flight always finish; the cell is dropped afterwards if still out of range
+        if (state == CellState::LOADING || getCellDistance(cell.x, cell.y, focus) <= m_settings.unloadRadius) {
+            ++it;
+            continue;
+        }
+        
+        if (state == CellState::READY || state == CellState::EMPTY || state == CellState::FAILED) {
+            it = m_cells.erase(it);
+            continue;
+        }
+        if (state == CellState::MERGING) {
+            cell.entities = cell.loader->getEntities();
+            cell.loader.reset();
+        }
+        cell.state.store(CellState::UNLOADING, std::memory_order_relaxed);
+        ++it;
+    }
+}
+
+void WorldStreamer::requestCells(const Vector2& focus) {
+    float radius = m_settings.loadRadius;
+    float size = m_settings.cellSize;
+    std::vector<std::pair<float, uint64_t>> candidates;
+    for (int y = toCell(focus.y - radius, size); y <= toCell(focus.y + radius, size); ++y) {
+        for (int x = toCell(focus.x - radius, size); x <= toCell(focus.x + radius, size); ++x) {
+            float distance = getCellDistance(x, y, focus);
+            if (distance <= radius && m_cells.find(getCellKey(x, y)) == m_cells.end()) {
+                candidates.emplace_back(distance, getCellKey(x, y));
+            }
+        }
+    }
+    
+    // Nearest first; the rest are picked up on later frames as slots free up
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& candidate : candidates) {
+        if (m_activeLoads >= m_settings.maxConcurrentLoads) {
+            break;
+        }
+        startLoad(static_cast<int32_t>(candidate.second >> 32), static_cast<int32_t>(candidate.second & 0xffffffffu));
+    }
+}
+
+void WorldStreamer::runTimeSlice(const Vector2& focus, double budgetMs) {
+    std::vector<Cell*> unloading;
+    std::vector<std::pair<float, Cell*>> merging;
+    for (const auto& entry : m_cells) {
+        Cell* cell = entry.second.get();
+        CellState state = cell->state.load(std::memory_order_acquire);
+        if (state == CellState::UNLOADING) {
+            unloading.push_back(cell);
+        } else if (state == CellState::MERGING) {
+            merging.emplace_back(-1.0f, cell);
+        } else if (state == CellState::READY) {
+            merging.emplace_back(getCellDistance(cell->x, cell->y, focus), cell);
+        }
+    }
+    
+    // A cell already merging finishes first, then the nearest ones follow
+    std::sort(merging.begin(), merging.end(), [](const std::pair<float, Cell*>& a, const std::pair<float, Cell*>& b) {
+        return a.first < b.first;
+    });
+    
+    auto start = Clock::now();
+    auto overBudget = [&start, budgetMs]() {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() >= budgetMs;
+    };
+    
+    // Unloads go first so memory is released before more arrives
+    for (Cell* cell : unloading) {
+        while (!unloadSome(*cell, UNLOAD_ENTITIES_PER_STEP)) {
+            if (overBudget()) {
+                return;
+            }
+        }
+        m_cells.erase(getCellKey(cell->x, cell->y));
+        if (overBudget()) {
+            return;
+        }
+    }
+    
+    for (const auto& entry : merging) {
+        Cell* cell = entry.second;
+        cell->state.store(CellState::MERGING, std::memory_order_relaxed);
+        for (;;) {
+            size_t merged = cell->loader->getMergedEntityCount();
+            bool done = cell->loader->mergeChunks(MERGE_CHUNKS_PER_STEP);
+            m_stats.entitiesMerged += static_cast<uint32_t>(cell->loader->getMergedEntityCount() - merged);
+            if (done) {
+                cell->entities = cell->loader->getEntities();
+                cell->loader.reset();
+                cell->state.store(CellState::RESIDENT, std::memory_order_relaxed);
+                break;
+            }
+            if (overBudget()) {
+                return;
+            }
+        }
+        if (overBudget()) {
+            return;
+        }
+    }
+}
+
+void WorldStreamer::startLoad(int x, int y) {
+    std::unique_ptr<Cell> cell(new Cell());
+    cell->x = x;
+    cell->y = y;
+    cell->reading = true;
+    cell->loader.reset(new SceneLoader(*m_world));
+    
+    Cell* loading = cell.get();
+    std::string path = getCellPath(m_settings.directory, x, y);
+    m_cells.emplace(getCellKey(x, y), std::move(cell));
+    m_activeLoads++;
+    
+    // Only reads the file; the world is touched by merges on the owning thread
+    JobSystem::getInstance().submit([loading, path]() {
+        if (!FileUtils::fileExists(path)) {
+            loading->state.store(CellState::EMPTY, std::memory_order_release);
+            return;
+        }
+        bool loaded = loading->loader->open(path, SceneLoadMode::COPY);
+        if (loaded) {
+            loading->loader->prefetch();
+        }
+        loading->state.store(loaded ? CellState::READY : CellState::FAILED, std::memory_order_release);
+    }, &m_jobs);
+}
+
+bool WorldStreamer::unloadSome(Cell& cell, size_t maxEntities) {
+    size_t end = cell.entities.size() - cell.unloadCursor > maxEntities ? cell.unloadCursor + maxEntities
+                                                                        : cell.entities.size();
+    for (; cell.unloadCursor < end; ++cell.unloadCursor) {
+        if (m_world->destroyEntity(cell.entities[cell.unloadCursor])) {
+            m_stats.entitiesUnloaded++;
+        }
+    }
+    return cell.unloadCursor == cell.entities.size();
+}
+
+} // namespace GameEngine2D
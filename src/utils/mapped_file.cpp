@@ -0,0 +1,146 @@
+#include "utils/mapped_file.h"
+#include "utils/logger.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GameEngine2D {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : m_data(nullptr), m_size(0), m_mode(Mode::READ_ONLY), m_fileHandle(nullptr), m_mappingHandle(nullptr) {
+}
+
+#else
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_mode(Mode::READ_ONLY) {
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::prefetch() const {
+    if (!m_data) {
+        return;
+    }
+#ifndef _WIN32
+    madvise(m_data, m_size, MADV_WILLNEED);
+#endif
+    
+    // Reads are enough to page in; a volatile sum keeps them from being elided
+    const size_t pageSize = 4096;
+    volatile unsigned char sink = 0;
+    for (size_t offset = 0; offset < m_size; offset += pageSize) {
+        sink = sink + m_data[offset];
+    }
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filepath, Mode mode) {
+    close();
+    
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR_FMT("Failed to open file for mapping: {}", filepath);
+        return false;
+    }
+    
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        LOG_ERROR_FMT("Cannot map empty file: {}", filepath);
+        CloseHandle(file);
+        return false;
+    }
+    
+    // Copy-on-write views need a read-only mapping opened with FILE_MAP_COPY
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, mode == Mode::COPY_ON_WRITE ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0)
+                         : nullptr;
+    if (!view) {
+        LOG_ERROR_FMT("Failed to map file: {}", filepath);
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    
+    m_data = static_cast<unsigned char*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_mode = mode;
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filepath, Mode mode) {
+    close();
+    
+    int file = ::open(filepath.c_str(), O_RDONLY);
+    if (file < 0) {
+        LOG_ERROR_FMT("Failed to open file for mapping: {}", filepath);
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        LOG_ERROR_FMT("Cannot map empty file: {}", filepath);
+        ::close(file);
+        return false;
+    }
+    
+    size_t size = static_cast<size_t>(info.st_size);
+    int protection = mode == Mode::COPY_ON_WRITE ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* view = mmap(nullptr, size, protection, MAP_PRIVATE, file, 0);
+    
+    // The mapping keeps its own reference to the file
+    ::close(file);
+    if (view == MAP_FAILED) {
+        LOG_ERROR_FMT("Failed to map file: {}", filepath);
+        return false;
+    }
+    
+    m_data = static_cast<unsigned char*>(view);
+    m_size = size;
+    m_mode = mode;
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(m_data, m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+} // namespace GameEngine2D
@@ -222,4 +222,52 @@ std::string StringUtils::unescape(const std::string& str) {
     return result;
 }
 
+std::vector<uint32_t> StringUtils::decodeUTF8(const std::string& str) {
+    std::vector<uint32_t> codepoints;
+    codepoints.reserve(str.size());
+    
+    size_t i = 0;
+    while (i < str.size()) {
+        unsigned char lead = static_cast<unsigned char>(str[i]);
+        uint32_t codepoint = 0xFFFD;
+        size_t length = 1;
+        
+        if (lead < 0x80) {
+            codepoint = lead;
+        } else if ((lead & 0xE0) == 0xC0) {
+            codepoint = lead & 0x1F;
+            length = 2;
+        } else if ((lead & 0xF0) == 0xE0) {
+            codepoint = lead & 0x0F;
+            length = 3;
+        } else if ((lead & 0xF8) == 0xF0) {
+            codepoint = lead & 0x07;
+            length = 4;
+        }
+        
+        // Validate continuation bytes, replacing malformed sequences
+        if (length > 1) {
+            if (i + length > str.size()) {
+                codepoint = 0xFFFD;
+                length = str.size() - i;
+            } else {
+                for (size_t j = 1; j < length; ++j) {
+                    unsigned char next = static_cast<unsigned char>(str[i + j]);
+                    if ((next & 0xC0) != 0x80) {
+                        codepoint = 0xFFFD;
+                        length = j;
+                        break;
+                    }
+                    codepoint = (codepoint << 6) | (next & 0x3F);
+                }
+            }
+        }
+        
+        codepoints.push_back(codepoint);
+        i += length;
+    }
+    
+    return codepoints;
+}
+
 } // namespace GameEngine2D
@@ -0,0 +1,39 @@
+#include "scene/scene_serializer.h"
+#include "utils/file_utils.h"
+#include "utils/logger.h"
+#include <iostream>
+#include <string>
+
+using namespace GameEngine2D;
+
+// Converts a text scene (format described in scene/scene_serializer.h) into
+// the binary format the engine maps at load time. Component names in the
+// text must match the names the game registers its component types under.
+//
+// Usage: scene_converter <input.txt> <output.scene>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: scene_converter <input.txt> <output.scene>" << std::endl;
+        return 1;
+    }
+    
+    Logger::getInstance().setLogLevel(LogLevel::WARNING);
+    if (!FileUtils::fileExists(argv[1])) {
+        std::cerr << "Input not found: " << argv[1] << std::endl;
+        return 1;
+    }
+    
+    SceneWriter writer;
+    std::string error;
+    if (!writer.addText(FileUtils::readTextFile(argv[1]), error)) {
+        std::cerr << argv[1] << ": " << error << std::endl;
+        return 1;
+    }
+    if (!writer.write(argv[2])) {
+        return 1;
+    }
+    
+    std::cout << "Wrote " << writer.getEntityCount() << " entities to " << argv[2] << std::endl;
+    return 0;
+}